@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Util/Juce_Header.h"
+#include <cmath>
+#include <string>
+
+/**
+ * Shared setup for the Benchmarks target. Fixtures are built outside the
+ * BENCHMARK lambdas so only the call under test is timed.
+ */
+namespace BenchUtils
+{
+    inline juce::File getOutputDir()
+    {
+        auto dir = juce::File::getCurrentWorkingDirectory().getChildFile ("BENCHMARKS/OUTPUT");
+        dir.createDirectory();
+        return dir;
+    }
+
+    /** Deterministic sine at hz with a per-channel phase offset, at 0.5 peak. */
+    inline juce::AudioBuffer<float> makeSine (int numChannels, int numSamples, double sampleRate, double hz = 220.0)
+    {
+        juce::AudioBuffer<float> buffer (numChannels, numSamples);
+        const double delta = juce::MathConstants<double>::twoPi * hz / sampleRate;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = buffer.getWritePointer (ch);
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = 0.5f * static_cast<float> (std::sin (delta * i + 0.25 * ch));
+        }
+
+        return buffer;
+    }
+
+    /** "<what> <seconds>s <channels>ch <rate>Hz" — the key results are compared by. */
+    inline std::string label (const juce::String& what, double seconds, int numChannels, double sampleRate)
+    {
+        return (what + " " + juce::String (seconds) + "s " + juce::String (numChannels) + "ch "
+                + juce::String (static_cast<int> (sampleRate)) + "Hz").toStdString();
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * @file BenchmarkJsonReporter.cpp
+ * @brief Catch2 reporter writing BENCHMARK results as JSON.
+ *
+ * Catch2 v3.1 has no JSON reporter, so this one is registered as "benchjson".
+ * Run it next to the console reporter:
+ *
+ *     Benchmarks --reporter console --reporter benchjson::out=BENCHMARKS/OUTPUT/benchmarks.json
+ *
+ * One entry per benchmark, keyed by its unique name, with the per-iteration
+ * sample times so runs from different commits can be diffed or compared
+ * statistically rather than by mean alone.
+ */
+
+#include "Util/Juce_Header.h"
+#include <catch2/catch_test_case_info.hpp>
+#include <catch2/interfaces/catch_interfaces_reporter.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <catch2/reporters/catch_reporter_streaming_base.hpp>
+#include <algorithm>
+
+namespace
+{
+    class BenchmarkJsonReporter : public Catch::StreamingReporterBase
+    {
+    public:
+        explicit BenchmarkJsonReporter(Catch::ReporterConfig&& config)
+            : StreamingReporterBase(std::move(config))
+        {
+        }
+
+        static std::string getDescription()
+        {
+            return "Writes BENCHMARK results (stats and samples in ns) as JSON";
+        }
+
+        void benchmarkEnded(Catch::BenchmarkStats<> const& stats) override
+        {
+            std::vector<double> samples;
+            samples.reserve(stats.samples.size());
+            for (const auto& sample : stats.samples)
+                samples.push_back(sample.count());
+
+            juce::Array<juce::var> sampleArray;
+            for (double s : samples)
+                sampleArray.add(s);
+
+            std::sort(samples.begin(), samples.end());
+
+            auto* entry = new juce::DynamicObject();
+            entry->setProperty("name",         juce::String(stats.info.name));
+            entry->setProperty("test_case",    currentTestCaseInfo != nullptr ? juce::String(currentTestCaseInfo->name) : juce::String());
+            entry->setProperty("iterations",   stats.info.iterations);
+            entry->setProperty("mean_ns",      stats.mean.point.count());
+            entry->setProperty("mean_low_ns",  stats.mean.lower_bound.count());
+            entry->setProperty("mean_high_ns", stats.mean.upper_bound.count());
+            entry->setProperty("std_dev_ns",   stats.standardDeviation.point.count());
+            entry->setProperty("median_ns",    _median(samples));
+            entry->setProperty("min_ns",       samples.empty() ? 0.0 : samples.front());
+            entry->setProperty("samples_ns",   sampleArray);
+
+            mBenchmarks.add(juce::var(entry));
+        }
+
+        void testRunEnded(Catch::TestRunStats const& stats) override
+        {
+            StreamingReporterBase::testRunEnded(stats);
+
+            auto* machine = new juce::DynamicObject();
+            machine->setProperty("os",    juce::SystemStats::getOperatingSystemName());
+            machine->setProperty("cpu",   juce::SystemStats::getCpuModel());
+            machine->setProperty("cores", juce::SystemStats::getNumCpus());
+
+            auto* root = new juce::DynamicObject();
+            root->setProperty("schema",     1);
+            root->setProperty("generated",  juce::Time::getCurrentTime().toISO8601(true));
+           #if JUCE_DEBUG
+            root->setProperty("build",      "Debug");
+           #else
+            root->setProperty("build",      "Release");
+           #endif
+            root->setProperty("machine",    juce::var(machine));
+            root->setProperty("benchmarks", mBenchmarks);
+
+            m_stream << juce::JSON::toString(juce::var(root)).toStdString() << '\n';
+            m_stream.flush();
+        }
+
+    private:
+        static double _median(const std::vector<double>& sorted)
+        {
+            if (sorted.empty())
+                return 0.0;
+
+            const size_t mid = sorted.size() / 2;
+            return sorted.size() % 2 != 0 ? sorted[mid] : 0.5 * (sorted[mid - 1] + sorted[mid]);
+        }
+
+        juce::Array<juce::var> mBenchmarks;
+    };
+}
+
+CATCH_REGISTER_REPORTER("benchjson", BenchmarkJsonReporter)
@@ -0,0 +1,25 @@
+#include "BenchUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "BufferFiller.h"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("BufferFiller::generateTukey", "[benchmark][BufferFiller]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    // Window sizes TD-PSOLA sees: 2x period from 1700 Hz at 44.1 kHz up to 75 Hz at 192 kHz.
+    for (int size : { 64, 1024, 4096, 16384 })
+    {
+        juce::AudioBuffer<float> window (1, size);
+
+        for (float alpha : { 0.25f, 0.5f, 1.0f })
+        {
+            BENCHMARK(("generateTukey " + juce::String (size) + " alpha " + juce::String (alpha, 2)).toStdString())
+            {
+                BufferFiller::generateTukey (window, alpha);
+                return window.getSample (0, size / 2);
+            };
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#include "BenchUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Processor/BufferProcessingManager.h"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("BufferProcessingManager::processBuffers", "[benchmark][BufferProcessingManager]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    struct Case
+    {
+        ActiveProcessor processor;
+        const char*     name;
+        double          seconds;
+        int             numChannels;
+        double          sampleRate;
+    };
+
+    const Case cases[] = {
+        { ActiveProcessor::kGain,         "Gain",          1.0, 1, 44100.0 },
+        { ActiveProcessor::kGain,         "Gain",          1.0, 2, 44100.0 },
+        { ActiveProcessor::kGain,         "Gain",         10.0, 2, 44100.0 },
+        { ActiveProcessor::kGain,         "Gain",          1.0, 2, 96000.0 },
+        { ActiveProcessor::kGrainShifter, "GrainShifter",  1.0, 1, 44100.0 },
+        { ActiveProcessor::kGrainShifter, "GrainShifter",  1.0, 2, 44100.0 },
+        { ActiveProcessor::kGrainShifter, "GrainShifter", 10.0, 2, 44100.0 },
+        { ActiveProcessor::kGrainShifter, "GrainShifter",  1.0, 2, 96000.0 },
+    };
+
+    constexpr int blockSize = 512;
+
+    for (const auto& c : cases)
+    {
+        const int numSamples = static_cast<int> (c.seconds * c.sampleRate);
+        const auto input     = BenchUtils::makeSine (c.numChannels, numSamples, c.sampleRate);
+        juce::AudioBuffer<float> output (c.numChannels, numSamples);
+
+        BufferProcessingManager bpm;
+        bpm.setActiveProcessor (c.processor);
+
+        BENCHMARK(BenchUtils::label ("processBuffers " + juce::String (c.name), c.seconds, c.numChannels, c.sampleRate))
+        {
+            return bpm.processBuffers (input, output, numSamples, numSamples, c.sampleRate, blockSize);
+        };
+    }
+}
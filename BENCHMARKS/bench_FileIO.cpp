@@ -0,0 +1,84 @@
+#include "BenchUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Util/FileUtils.h"
+#include "BufferWriter.h"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+    struct IOCase
+    {
+        double seconds;
+        int    numChannels;
+        double sampleRate;
+    };
+
+    const IOCase kCases[] = {
+        {  1.0, 1,  44100.0 },
+        {  1.0, 2,  44100.0 },
+        { 10.0, 2,  44100.0 },
+        { 60.0, 2,  44100.0 },
+        { 10.0, 2,  96000.0 },
+        { 10.0, 6,  48000.0 },
+    };
+}
+
+TEST_CASE("FileUtils::loadWavIntoBuffer", "[benchmark][FileUtils]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    for (const auto& c : kCases)
+    {
+        const int numSamples = static_cast<int> (c.seconds * c.sampleRate);
+        const auto source    = BenchUtils::makeSine (c.numChannels, numSamples, c.sampleRate);
+
+        const auto file = BenchUtils::getOutputDir().getChildFile ("load_" + juce::String (c.seconds) + "s_"
+                                                                   + juce::String (c.numChannels) + "ch_"
+                                                                   + juce::String (static_cast<int> (c.sampleRate)) + ".wav");
+        REQUIRE(FileUtils::writeBufferToWav (source, file, c.sampleRate, numSamples));
+
+        juce::AudioBuffer<float> dest (c.numChannels, numSamples);
+
+        const std::pair<FileUtils::ReadStrategy, const char*> strategies[] = {
+            { FileUtils::ReadStrategy::kStreamed,     "streamed" },
+            { FileUtils::ReadStrategy::kMemoryMapped, "mapped" },
+        };
+
+        for (const auto& entry : strategies)
+        {
+            const auto strategy = entry.first;
+
+            BENCHMARK(BenchUtils::label ("loadWavIntoBuffer " + juce::String (entry.second), c.seconds, c.numChannels, c.sampleRate))
+            {
+                double sr   = 0.0;
+                int    chs  = 0;
+                int    read = 0;
+                FileUtils::loadWavIntoBuffer (file, dest, numSamples, sr, chs, read, nullptr, nullptr, strategy);
+                return read;
+            };
+        }
+    }
+}
+
+TEST_CASE("BufferWriter::writeToWav", "[benchmark][BufferWriter]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    for (const auto& c : kCases)
+    {
+        const int numSamples = static_cast<int> (c.seconds * c.sampleRate);
+        const auto source    = BenchUtils::makeSine (c.numChannels, numSamples, c.sampleRate);
+        const auto file      = BenchUtils::getOutputDir().getChildFile ("write.wav");
+
+        for (int bitDepth : { 16, 24 })
+        {
+            BENCHMARK(BenchUtils::label ("writeToWav " + juce::String (bitDepth) + "bit", c.seconds, c.numChannels, c.sampleRate))
+            {
+                return BufferWriter::writeToWav (source, file, c.sampleRate, numSamples, bitDepth, nullptr);
+            };
+        }
+
+        file.deleteFile();
+    }
+}
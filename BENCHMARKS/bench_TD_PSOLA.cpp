@@ -0,0 +1,48 @@
+#include "BenchUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "TD_PSOLA/TD_PSOLA.h"
+#include "TEST_UTILS/SignalGenerator.h"
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("TDPSOLA::process", "[benchmark][TD_PSOLA]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    struct Case
+    {
+        double seconds;
+        int    numChannels;
+        double sampleRate;
+        float  ratio;
+    };
+
+    // Ratio sweep at the reference point, then one axis at a time.
+    const Case cases[] = {
+        { 1.0, 1,  44100.0, 0.5f },
+        { 1.0, 1,  44100.0, 1.5f },
+        { 1.0, 1,  44100.0, 2.0f },
+        { 5.0, 1,  44100.0, 1.5f },
+        { 1.0, 2,  44100.0, 1.5f },
+        { 1.0, 1,  96000.0, 1.5f },
+        { 1.0, 1, 192000.0, 1.5f },
+    };
+
+    for (const auto& c : cases)
+    {
+        // Glottal pulses with vibrato: pitch marks move like a voice, unlike a steady sine.
+        TestUtils::SignalSpec spec;
+        spec.sampleRate  = c.sampleRate;
+        spec.numChannels = c.numChannels;
+        spec.seconds     = c.seconds;
+
+        const auto input = TestUtils::createSignalBuffer (spec);
+        juce::AudioBuffer<float> output;
+        TD_PSOLA::TDPSOLA psola;
+
+        BENCHMARK(BenchUtils::label ("TDPSOLA::process x" + juce::String (c.ratio, 2), c.seconds, c.numChannels, c.sampleRate))
+        {
+            return psola.process (input, output, c.ratio, static_cast<float> (c.sampleRate));
+        };
+    }
+}
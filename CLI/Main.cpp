@@ -0,0 +1,65 @@
+/*
+    Entry point for the headless AudioFileTransformerCLI target.
+
+    Lives outside SOURCE/ so regenSource.py never adds this main() to the
+    shared SOURCES list that the plugin and Tests targets compile.
+ */
+
+#include "CLI/CommandLine.h"
+#include <iostream>
+
+int main (int argc, char* argv[])
+{
+    // Processors and their parameter trees expect JUCE's singletons to exist.
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add (juce::String::fromUTF8 (argv[i]));
+
+    CommandLine::Options options;
+    juce::String         error;
+
+    if (! CommandLine::parse (args, options, error))
+    {
+        std::cerr << error << "\n\n" << CommandLine::getUsage();
+        return 2;
+    }
+
+    if (options.showHelp)
+    {
+        std::cout << CommandLine::getUsage();
+        return 0;
+    }
+
+    std::unique_ptr<juce::FileOutputStream> timingStream;
+    if (options.timingFile != juce::File())
+    {
+        options.timingFile.deleteFile();
+        timingStream = std::make_unique<juce::FileOutputStream> (options.timingFile);
+        if (timingStream->failedToOpen())
+        {
+            std::cerr << "Failed to open timing file: " << options.timingFile.getFullPathName() << "\n";
+            return 2;
+        }
+    }
+
+    auto emitLine = [&] (const juce::String& line)
+    {
+        if (timingStream != nullptr)
+        {
+            *timingStream << line << "\n";
+            timingStream->flush();
+        }
+        else
+        {
+            std::cout << line << std::endl;
+        }
+    };
+
+    const int exitCode = CommandLine::run (options, emitLine, error);
+    if (exitCode == 2)
+        std::cerr << error << "\n";
+
+    return exitCode;
+}
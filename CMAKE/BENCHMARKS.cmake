@@ -0,0 +1,8 @@
+set(BENCHMARK_SOURCES
+    BENCHMARKS/BenchUtils.h
+    BENCHMARKS/BenchmarkJsonReporter.cpp
+    BENCHMARKS/bench_BufferFiller.cpp
+    BENCHMARKS/bench_BufferProcessingManager.cpp
+    BENCHMARKS/bench_FileIO.cpp
+    BENCHMARKS/bench_TD_PSOLA.cpp
+)
\ No newline at end of file
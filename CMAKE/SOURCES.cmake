@@ -1,18 +1,54 @@
 set(SOURCES
+    SOURCE/CLI/CommandLine.cpp
+    SOURCE/CLI/CommandLine.h
     SOURCE/Components/PluginEditor.cpp
     SOURCE/Components/PluginEditor.h
+    SOURCE/Processor/AuditionTransport.cpp
+    SOURCE/Processor/AuditionTransport.h
+    SOURCE/Processor/BatchRenderQueue.cpp
+    SOURCE/Processor/BatchRenderQueue.h
+    SOURCE/Processor/BlockSizeAutoTuner.cpp
+    SOURCE/Processor/BlockSizeAutoTuner.h
     SOURCE/Processor/BufferProcessingManager.cpp
     SOURCE/Processor/BufferProcessingManager.h
     SOURCE/Processor/FileToBufferManager.cpp
     SOURCE/Processor/FileToBufferManager.h
+    SOURCE/Processor/OfflineRenderer.cpp
+    SOURCE/Processor/OfflineRenderer.h
     SOURCE/Processor/PluginProcessor.cpp
     SOURCE/Processor/PluginProcessor.h
+    SOURCE/Processor/PreviewRenderer.cpp
+    SOURCE/Processor/PreviewRenderer.h
+    SOURCE/Processor/RenderCache.cpp
+    SOURCE/Processor/RenderCache.h
+    SOURCE/Processor/RenderMetrics.cpp
+    SOURCE/Processor/RenderMetrics.h
+    SOURCE/Processor/RenderRange.h
+    SOURCE/Processor/StoragePool.cpp
+    SOURCE/Processor/StoragePool.h
+    SOURCE/Processor/StreamingRenderPipeline.cpp
+    SOURCE/Processor/StreamingRenderPipeline.h
     SOURCE/TD_PSOLA/GrainExport.h
     SOURCE/TD_PSOLA/TD_PSOLA.cpp
     SOURCE/TD_PSOLA/TD_PSOLA.h
+    SOURCE/Util/AsyncWavWriter.cpp
+    SOURCE/Util/AsyncWavWriter.h
+    SOURCE/Util/BinaryBlockLogger.cpp
+    SOURCE/Util/BinaryBlockLogger.h
     SOURCE/Util/FileUtils.cpp
     SOURCE/Util/FileUtils.h
+    SOURCE/Util/JobPool.cpp
+    SOURCE/Util/JobPool.h
     SOURCE/Util/Juce_Header.h
+    SOURCE/Util/LatencyHistogram.cpp
+    SOURCE/Util/LatencyHistogram.h
+    SOURCE/Util/MemoryAccounting.cpp
+    SOURCE/Util/MemoryAccounting.h
+    SOURCE/Util/RenderControl.cpp
+    SOURCE/Util/RenderControl.h
+    SOURCE/Util/RenderTrace.cpp
+    SOURCE/Util/RenderTrace.h
+    SOURCE/Util/SpscQueue.h
     SOURCE/Util/Version.h
     SUBMODULES/RD/SOURCE/AudioFileHelpers.h
     SUBMODULES/RD/SOURCE/BUFFER_FILLER/BufferFiller.cpp
@@ -1,13 +1,37 @@
 set(TEST_SOURCES
+    TESTS/AUDITION_TRANSPORT/test_AuditionTransport.cpp
+    TESTS/BATCH_RENDER_QUEUE/test_BatchRenderQueue.cpp
+    TESTS/BUFFER_PROCESSING_MANAGER/test_BlockSizeAutoTuner.cpp
     TESTS/BUFFER_PROCESSING_MANAGER/test_BufferProcessingManager.cpp
     TESTS/BUFFER_PROCESSING_MANAGER/test_BufferProcessingManager_DataLogger.cpp
+    TESTS/CLI/test_CommandLine.cpp
     TESTS/FILE_TO_BUFFER_MANAGER/test_FileToBufferManager.cpp
+    TESTS/FILE_TO_BUFFER_MANAGER/test_RenderMetrics.cpp
     TESTS/PLUGIN_PROCESSOR/test_AudioFileTransformerProcessor_DataLogger.cpp
+    TESTS/PLUGIN_PROCESSOR/test_BounceAccumulation.cpp
+    TESTS/PLUGIN_PROCESSOR/test_LiveMode.cpp
     TESTS/PLUGIN_PROCESSOR/test_Processor.cpp
+    TESTS/PREVIEW_RENDERER/test_PreviewRenderer.cpp
     TESTS/RD/test_BufferFiller_LoadOverload.cpp
     TESTS/RD/test_BufferWriter_WriteOverload.cpp
+    TESTS/RENDER_CACHE/test_RenderCache.cpp
+    TESTS/SIGNAL_GENERATOR/test_SignalGenerator.cpp
+    TESTS/STORAGE_POOL/test_StoragePool.cpp
+    TESTS/STREAMING_RENDER_PIPELINE/test_RegionRender.cpp
+    TESTS/STREAMING_RENDER_PIPELINE/test_StreamingRenderPipeline.cpp
     TESTS/TD_PSOLA/test_TD_PSOLA.cpp
+    TESTS/TEST_UTILS/AudioThreadAudit.cpp
+    TESTS/TEST_UTILS/AudioThreadAudit.h
+    TESTS/TEST_UTILS/SignalGenerator.cpp
+    TESTS/TEST_UTILS/SignalGenerator.h
     TESTS/TEST_UTILS/TestUtils.cpp
     TESTS/TEST_UTILS/TestUtils.h
+    TESTS/UTIL/test_AsyncWavWriter.cpp
+    TESTS/UTIL/test_BinaryBlockLogger.cpp
     TESTS/UTIL/test_FileUtils.cpp
+    TESTS/UTIL/test_JobPool.cpp
+    TESTS/UTIL/test_LatencyHistogram.cpp
+    TESTS/UTIL/test_RenderControl.cpp
+    TESTS/UTIL/test_RenderTrace.cpp
+    TESTS/UTIL/test_SpscQueue.cpp
 )
\ No newline at end of file
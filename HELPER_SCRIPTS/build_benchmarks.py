@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+from __future__ import annotations
+import argparse, subprocess, sys
+from pathlib import Path
+from build_complete import find_cmake, beep
+
+
+def run(cmd: list[str], cwd: Path) -> None:
+    print("+", " ".join(cmd))
+    subprocess.run(cmd, cwd=str(cwd), check=True)
+
+
+def regenerate_cmake_lists() -> None:
+    regen_script = Path(__file__).parent / "regenSource.py"
+    if regen_script.exists():
+        print("Regenerating CMake file lists...")
+        subprocess.run([sys.executable, str(regen_script)], check=True)
+    else:
+        print("Warning: regenSource.py not found, skipping regeneration")
+
+
+def find_executable(build_dir: Path, config: str) -> Path:
+    name = "Benchmarks.exe" if sys.platform.startswith("win") else "Benchmarks"
+    for candidate in (build_dir / config / name, build_dir / name):
+        if candidate.exists():
+            return candidate
+    matches = sorted(build_dir.rglob(name))
+    if not matches:
+        raise FileNotFoundError(f"{name} not found under {build_dir}")
+    return matches[0]
+
+
+def parse_args() -> argparse.Namespace:
+    ap = argparse.ArgumentParser()
+    ap.add_argument(
+        "--config",
+        choices=["Debug", "Release"],
+        default="Release",
+        help="Build config (default: Release)",
+    )
+    ap.add_argument(
+        "--samples",
+        type=int,
+        default=None,
+        help="Catch2 --benchmark-samples (default: Catch2's 100)",
+    )
+    ap.add_argument(
+        "--build-only",
+        action="store_true",
+        help="Build the Benchmarks target without running it",
+    )
+    ap.add_argument(
+        "filters",
+        nargs="*",
+        help="Catch2 test spec, e.g. [TD_PSOLA] (default: every benchmark)",
+    )
+    return ap.parse_args()
+
+
+def main() -> int:
+    args = parse_args()
+    regenerate_cmake_lists()
+
+    root = Path(__file__).resolve().parents[1]
+    build_dir = root / "BUILD"
+    build_dir.mkdir(parents=True, exist_ok=True)
+
+    cmake = find_cmake()
+    print(f"Using cmake: {cmake}")
+    print(f"Using config: {args.config}")
+
+    try:
+        configure_cmd = [cmake, "-S", str(root), "-B", str(build_dir),
+                         f"-DCMAKE_BUILD_TYPE={args.config}", "-DBUILD_BENCHMARKS=ON"]
+        run(configure_cmd, cwd=root)
+
+        build_cmd = [cmake, "--build", str(build_dir), "--target", "Benchmarks"]
+        if sys.platform.startswith("win"):
+            build_cmd += ["--config", args.config]
+        run(build_cmd, cwd=root)
+
+        if not args.build_only:
+            out_dir = root / "BENCHMARKS" / "OUTPUT"
+            out_dir.mkdir(parents=True, exist_ok=True)
+            json_path = out_dir / "benchmarks.json"
+
+            bench_cmd = [str(find_executable(build_dir, args.config)),
+                         "--reporter", "console",
+                         "--reporter", f"benchjson::out={json_path}"]
+            if args.samples is not None:
+                bench_cmd += ["--benchmark-samples", str(args.samples)]
+            bench_cmd += args.filters
+            run(bench_cmd, cwd=root)
+            print(f"Results written to {json_path}")
+    except Exception:
+        beep(success=False)
+        raise
+
+    beep(success=True)
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+"""
+Performance regression gate for the Benchmarks target.
+
+Runs the Benchmarks executable several times with the benchjson reporter,
+takes each benchmark's per-run median, and compares the median of those
+medians against TESTS/BASELINES/benchmarks.json.
+
+A benchmark regresses only when its slowdown exceeds BOTH the relative
+threshold and the noise band (k * combined MAD of baseline and current runs),
+so a noisy machine doesn't fail the gate and a real 1% shift on a quiet one
+doesn't either.
+
+Timings only compare on the same hardware, so the baseline file holds one
+entry per machine fingerprint (OS, architecture, CPU model, core count).
+A machine with no entry fails the gate rather than skipping it: a gate that
+silently never runs is worse than one that asks to be recorded.
+
+    # Record (or refresh) this machine's baseline (Release build)
+    check_benchmarks.py --exe BUILD/Benchmarks --update
+
+    # Compare against it; exit 1 on regression or when this machine has no baseline
+    check_benchmarks.py --exe BUILD/Benchmarks --threshold 0.10
+
+Runs entirely locally; no network access needed.
+"""
+from __future__ import annotations
+import argparse, json, os, platform, statistics, subprocess, sys, tempfile
+from datetime import datetime, timezone
+from pathlib import Path
+
+EXIT_REGRESSED = 1
+EXIT_NO_BASELINE = 1
+EXIT_USAGE = 2
+
+# ctest treats this as "skipped" (SKIP_RETURN_CODE on the BenchmarkRegression test);
+# only used when the Benchmarks executable itself is missing.
+EXIT_SKIPPED = 77
+
+# Scales MAD to a standard-deviation estimate for normally distributed noise
+MAD_TO_SIGMA = 1.4826
+
+ROOT = Path(__file__).resolve().parents[1]
+DEFAULT_BASELINE = ROOT / "TESTS" / "BASELINES" / "benchmarks.json"
+
+
+def median_and_mad(values: list[float]) -> tuple[float, float]:
+    med = statistics.median(values)
+    mad = statistics.median(abs(v - med) for v in values) * MAD_TO_SIGMA
+    return med, mad
+
+
+def run_benchmarks(exe: Path, repetitions: int, samples: int, filters: list[str]) -> dict[str, list[float]]:
+    """Returns benchmark name -> per-repetition median in ns."""
+    per_run: dict[str, list[float]] = {}
+
+    with tempfile.TemporaryDirectory() as tmp:
+        for rep in range(repetitions):
+            out = Path(tmp) / f"run_{rep}.json"
+            cmd = [str(exe), "--reporter", f"benchjson::out={out}",
+                   "--benchmark-samples", str(samples), *filters]
+            print(f"+ [{rep + 1}/{repetitions}]", " ".join(cmd), flush=True)
+            subprocess.run(cmd, cwd=str(ROOT), check=True)
+
+            with open(out, encoding="utf-8") as f:
+                for entry in json.load(f).get("benchmarks", []):
+                    per_run.setdefault(entry["name"], []).append(float(entry["median_ns"]))
+
+    return per_run
+
+
+def cpu_model() -> str:
+    """Marketing name of the CPU, e.g. "AMD Ryzen 9 7950X 16-Core Processor"."""
+    system = platform.system()
+    try:
+        if system == "Linux":
+            with open("/proc/cpuinfo", encoding="utf-8", errors="replace") as f:
+                for line in f:
+                    key, _, value = line.partition(":")
+                    # "model name" on x86, "Model"/"Hardware" on some ARM kernels
+                    if key.strip() in ("model name", "Model", "Hardware") and value.strip():
+                        return value.strip()
+        elif system == "Darwin":
+            return subprocess.run(["sysctl", "-n", "machdep.cpu.brand_string"],
+                                  capture_output=True, text=True, check=True).stdout.strip()
+        elif system == "Windows":
+            import winreg
+            key = winreg.OpenKey(winreg.HKEY_LOCAL_MACHINE, r"HARDWARE\DESCRIPTION\System\CentralProcessor\0")
+            return str(winreg.QueryValueEx(key, "ProcessorNameString")[0]).strip()
+    except (OSError, subprocess.CalledProcessError):
+        pass
+    return platform.processor() or "unknown"
+
+
+def machine_info() -> dict[str, str]:
+    return {"os": platform.system(), "arch": platform.machine(), "cpu": cpu_model(), "cores": os.cpu_count()}
+
+
+def load_baselines(path: Path) -> list[dict]:
+    """Per-machine entries: [{"machine": {...}, "recorded": ..., "benchmarks": {...}}]."""
+    if not path.exists():
+        return []
+    data = json.loads(path.read_text(encoding="utf-8"))
+    return [m for m in data.get("machines", []) if m.get("benchmarks")]
+
+
+def find_baseline(entries: list[dict], machine: dict) -> dict | None:
+    return next((m for m in entries if m.get("machine") == machine), None)
+
+
+def summarise(per_run: dict[str, list[float]]) -> dict[str, dict]:
+    result = {}
+    for name, medians in sorted(per_run.items()):
+        med, mad = median_and_mad(medians)
+        result[name] = {"median_ns": med, "mad_ns": mad, "repetitions": len(medians)}
+    return result
+
+
+def write_baseline(path: Path, current: dict[str, dict], merge: bool) -> None:
+    """Replaces this machine's entry; other machines' entries are kept."""
+    machine = machine_info()
+    entries = load_baselines(path)
+    previous = find_baseline(entries, machine)
+
+    benchmarks = dict(previous["benchmarks"]) if merge and previous else {}
+    benchmarks.update(current)
+
+    entries = [m for m in entries if m is not previous]
+    entries.append({
+        "machine": machine,
+        "recorded": datetime.now(timezone.utc).isoformat(timespec="seconds"),
+        "benchmarks": dict(sorted(benchmarks.items())),
+    })
+
+    path.parent.mkdir(parents=True, exist_ok=True)
+    baseline = {"schema": 2, "machines": entries}
+    path.write_text(json.dumps(baseline, indent=2) + "\n", encoding="utf-8")
+    print(f"Wrote {len(current)} benchmark(s) for {machine} to {path}")
+
+
+def compare(baseline: dict, current: dict[str, dict], threshold: float, mad_k: float) -> int:
+    stored = baseline.get("benchmarks", {})
+    regressions = 0
+    compared = 0
+
+    print(f"\n{'benchmark':<60} {'baseline':>12} {'current':>12} {'change':>8}  verdict")
+    for name, cur in current.items():
+        base = stored.get(name)
+        if base is None:
+            print(f"{name:<60} {'-':>12} {cur['median_ns'] / 1e6:>10.3f}ms {'':>8}  new (no baseline)")
+            continue
+
+        compared += 1
+        delta = cur["median_ns"] - base["median_ns"]
+        change = delta / base["median_ns"] if base["median_ns"] > 0 else 0.0
+        noise = mad_k * (base["mad_ns"] ** 2 + cur["mad_ns"] ** 2) ** 0.5
+
+        if delta > threshold * base["median_ns"] and delta > noise:
+            verdict = "REGRESSED"
+            regressions += 1
+        elif -delta > threshold * base["median_ns"] and -delta > noise:
+            verdict = "faster (consider --update)"
+        else:
+            verdict = "ok"
+
+        print(f"{name:<60} {base['median_ns'] / 1e6:>10.3f}ms {cur['median_ns'] / 1e6:>10.3f}ms "
+              f"{change * 100:>+7.1f}%  {verdict}")
+
+    for name in sorted(set(stored) - set(current)):
+        print(f"{name:<60} {'':>12} {'-':>12} {'':>8}  not run")
+
+    if compared == 0:
+        print("\nNo benchmark has a stored baseline; record one with --update.")
+        return EXIT_NO_BASELINE
+
+    print(f"\n{compared} compared, {regressions} regressed "
+          f"(threshold {threshold * 100:.0f}%, noise band {mad_k:g} x MAD)")
+    return EXIT_REGRESSED if regressions else 0
+
+
+def parse_args() -> argparse.Namespace:
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--exe", type=Path, required=True, help="Path to the built Benchmarks executable")
+    ap.add_argument("--baseline", type=Path, default=DEFAULT_BASELINE,
+                    help="Baseline JSON (default: TESTS/BASELINES/benchmarks.json)")
+    ap.add_argument("--repetitions", type=int, default=5, help="Full benchmark runs per check (default: 5)")
+    ap.add_argument("--samples", type=int, default=30, help="Catch2 --benchmark-samples per run (default: 30)")
+    ap.add_argument("--threshold", type=float, default=0.10,
+                    help="Relative slowdown that counts as a regression (default: 0.10 = 10%%)")
+    ap.add_argument("--mad-k", type=float, default=3.0,
+                    help="Slowdown must also exceed this many combined MADs (default: 3.0)")
+    ap.add_argument("--update", action="store_true",
+                    help="Record the measured medians as the new baseline instead of comparing")
+    ap.add_argument("--allow-machine-mismatch", action="store_true",
+                    help="Without a baseline for this machine, compare against the most recent other one")
+    ap.add_argument("filters", nargs="*", default=["[benchmark]"],
+                    help="Catch2 test spec (default: [benchmark])")
+    return ap.parse_args()
+
+
+def main() -> int:
+    args = parse_args()
+
+    if not args.exe.exists():
+        print(f"Benchmarks executable not found: {args.exe}")
+        return EXIT_SKIPPED
+
+    if args.repetitions < 3:
+        print("Need at least 3 repetitions for a meaningful MAD")
+        return EXIT_USAGE
+
+    baseline = None
+    if not args.update:
+        entries = load_baselines(args.baseline)
+        baseline = find_baseline(entries, machine_info())
+        if baseline is None and entries and args.allow_machine_mismatch:
+            baseline = max(entries, key=lambda m: m.get("recorded") or "")
+            print(f"No baseline for {machine_info()}; comparing against {baseline['machine']}.")
+
+        if baseline is None:
+            recorded = [m["machine"] for m in entries]
+            print(f"No baseline for this machine ({machine_info()}) in {args.baseline}.")
+            print(f"Recorded machines: {recorded or 'none'}")
+            print("Record one in a Release build with --update and commit it.")
+            return EXIT_NO_BASELINE
+
+    current = summarise(run_benchmarks(args.exe, args.repetitions, args.samples, args.filters))
+    if not current:
+        print("No benchmarks matched the filter")
+        return EXIT_USAGE
+
+    if args.update:
+        write_baseline(args.baseline, current, merge=args.filters != ["[benchmark]"])
+        return 0
+
+    return compare(baseline, current, args.threshold, args.mad_k)
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
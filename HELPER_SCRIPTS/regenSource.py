@@ -1,6 +1,7 @@
 #!/usr/bin/env python3
 """
-Regenerates CMAKE/SOURCES.cmake and CMAKE/TESTS.cmake by scanning directories.
+Regenerates CMAKE/SOURCES.cmake, CMAKE/TESTS.cmake and CMAKE/BENCHMARKS.cmake
+by scanning directories.
 
 Run this whenever you add or remove source files to update the CMake file lists.
 """
@@ -77,6 +78,11 @@ def main():
         print(f"Scanning test folders: {', '.join(test_folders)}")
     generate_files_list(test_folders, 'CMAKE/TESTS.cmake', 'TEST_SOURCES')
 
+    # Benchmarks live outside TESTS/ so they never land in the Tests target.
+    if os.path.exists('BENCHMARKS'):
+        print("Scanning benchmark folder: BENCHMARKS")
+        generate_files_list(['BENCHMARKS'], 'CMAKE/BENCHMARKS.cmake', 'BENCHMARK_SOURCES')
+
 
 if __name__ == '__main__':
     main()
@@ -0,0 +1,613 @@
+#include "CLI/CommandLine.h"
+#include "Processor/PluginProcessor.h"
+#include "Processor/BatchRenderQueue.h"
+#include "TD_PSOLA/TD_PSOLA.h"
+#include "Util/BinaryBlockLogger.h"
+#include "Util/FileUtils.h"
+#include "Util/JobPool.h"
+#include <atomic>
+#include <limits>
+
+namespace
+{
+    struct ProcessorName
+    {
+        CommandLine::Processor processor;
+        const char*            name;
+    };
+
+    constexpr ProcessorName kProcessorNames[] = {
+        { CommandLine::Processor::kGain,         "gain"         },
+        { CommandLine::Processor::kGrainShifter, "grainshifter" },
+        { CommandLine::Processor::kTdPsola,      "tdpsola"      },
+    };
+
+    juce::String toString(CommandLine::Processor processor)
+    {
+        for (const auto& entry : kProcessorNames)
+            if (entry.processor == processor)
+                return entry.name;
+        return {};
+    }
+
+    juce::File resolvePath(const juce::String& path)
+    {
+        return juce::File::getCurrentWorkingDirectory().getChildFile(path.unquoted());
+    }
+
+    bool parseInt(const juce::String& text, int minValue, int& out)
+    {
+        if (! text.containsOnly("0123456789") || text.isEmpty())
+            return false;
+        out = text.getIntValue();
+        return out >= minValue;
+    }
+
+    bool parseSeconds(const juce::String& text, double& out)
+    {
+        if (! text.containsOnly("0123456789.") || text.isEmpty())
+            return false;
+        out = text.getDoubleValue();
+        return true;
+    }
+
+    bool parseFraction(const juce::String& text, double& out)
+    {
+        if (! text.containsOnly("0123456789.") || text.isEmpty())
+            return false;
+        out = text.getDoubleValue();
+        return out <= 1.0;
+    }
+
+    //==============================================================================
+    struct JobOutcome
+    {
+        bool         ok           = false;
+        juce::String error;
+        double       sampleRate   = 0.0;
+        juce::int64  inputSamples = 0;
+    };
+
+    /** One per thread: the processor instance (or TD-PSOLA engine) that thread renders with. */
+    struct RenderSlot
+    {
+        std::unique_ptr<AudioFileTransformerProcessor> processor;
+        TD_PSOLA::TDPSOLA                              psola;
+    };
+
+    juce::AudioProcessorValueTreeState* getApvts(AudioFileTransformerProcessor& processor, CommandLine::Processor which)
+    {
+        if (which == CommandLine::Processor::kGain)
+            if (auto* gain = processor.getGainNode())
+                return &gain->getAPVTS();
+
+        if (which == CommandLine::Processor::kGrainShifter)
+            if (auto* shifter = processor.getGrainShifterNode())
+                return &shifter->getAPVTS();
+
+        return nullptr;
+    }
+
+    bool configureProcessor(AudioFileTransformerProcessor& processor, const CommandLine::Options& options, juce::String& error)
+    {
+        processor.setActiveProcessor(options.processor == CommandLine::Processor::kGrainShifter ? ActiveProcessor::kGrainShifter
+                                                                                             : ActiveProcessor::kGain);
+        processor.getBufferProcessingManager().setBlockSize(options.blockSize);
+
+        auto& renderer = processor.getOfflineRenderer();
+        renderer.setRenderMode(options.streaming ? OfflineRenderer::RenderMode::kStreaming
+                                                 : OfflineRenderer::RenderMode::kBuffered);
+
+        AsyncWavWriter::Options writerOptions;
+        writerOptions.bitDepth = options.bitDepth;
+        writerOptions.dither   = options.dither;
+        renderer.setWriterOptions(writerOptions);
+        renderer.setBlockLogEnabled(options.blockLog);
+        processor.getBufferProcessingManager().getBlockLogger().setSampling({ options.blockLogEveryNth,
+                                                                               options.blockLogFraction,
+                                                                               options.blockLogSeed });
+
+        auto* apvts = getApvts(processor, options.processor);
+        if (apvts == nullptr)
+        {
+            error = "Processor unavailable: " + toString(options.processor);
+            return false;
+        }
+
+        for (const auto& id : options.parameters.getAllKeys())
+        {
+            auto* parameter = apvts->getParameter(id);
+            if (parameter == nullptr)
+            {
+                error = "Unknown parameter for " + toString(options.processor) + ": " + id;
+                return false;
+            }
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(options.parameters[id].getFloatValue()));
+        }
+
+        return true;
+    }
+
+    bool configurePsola(const CommandLine::Options& options, TD_PSOLA::TDPSOLA::Config& config, float& ratio, juce::String& error)
+    {
+        for (const auto& id : options.parameters.getAllKeys())
+        {
+            const float value = options.parameters[id].getFloatValue();
+
+            if      (id == "ratio")            ratio                   = value;
+            else if (id == "maxHz")            config.maxHz            = value;
+            else if (id == "minHz")            config.minHz            = value;
+            else if (id == "analysisWindowMs") config.analysisWindowMs = value;
+            else
+            {
+                error = "Unknown parameter for tdpsola: " + id;
+                return false;
+            }
+        }
+
+        if (ratio <= 0.0f)
+        {
+            error = "tdpsola ratio must be > 0";
+            return false;
+        }
+        return true;
+    }
+
+    JobOutcome renderPsola(TD_PSOLA::TDPSOLA& psola,
+                           const TD_PSOLA::TDPSOLA::Config& config,
+                           float ratio,
+                           const RenderRange& range,
+                           const juce::File& input,
+                           const juce::File& output)
+    {
+        JobOutcome outcome;
+
+        int         numChannels = 0;
+        juce::int64 fileLength  = 0;
+        if (! FileUtils::readAudioFileInfo(input, outcome.sampleRate, numChannels, fileLength))
+        {
+            outcome.error = "Failed to read audio header: " + input.getFullPathName();
+            return outcome;
+        }
+
+        // TD-PSOLA analyses the whole buffer at once, so pre-roll does not apply.
+        const auto region    = range.resolve(outcome.sampleRate, fileLength);
+        outcome.inputSamples = region.getLength();
+        if (outcome.inputSamples <= 0)
+        {
+            outcome.error = "Render range is empty: " + input.getFullPathName();
+            return outcome;
+        }
+        if (outcome.inputSamples > std::numeric_limits<int>::max())
+        {
+            outcome.error = "Input too long for tdpsola: " + input.getFullPathName();
+            return outcome;
+        }
+
+        juce::AudioBuffer<float> source (numChannels, static_cast<int>(outcome.inputSamples));
+        int samplesRead = 0;
+        if (! FileUtils::loadWavIntoBuffer(input, source, source.getNumSamples(), outcome.sampleRate, numChannels, samplesRead,
+                                           nullptr, nullptr, FileUtils::ReadStrategy::kAuto, region.start))
+        {
+            outcome.error = "Failed to load WAV: " + input.getFullPathName();
+            return outcome;
+        }
+
+        juce::AudioBuffer<float> result;
+        if (! psola.process(source, result, ratio, static_cast<float>(outcome.sampleRate), config))
+        {
+            outcome.error = "TD-PSOLA failed: " + input.getFullPathName();
+            return outcome;
+        }
+
+        if (! FileUtils::writeBufferToWav(result, output, outcome.sampleRate, result.getNumSamples()))
+        {
+            outcome.error = "Failed to write WAV: " + output.getFullPathName();
+            return outcome;
+        }
+
+        outcome.ok = true;
+        return outcome;
+    }
+}
+
+//==============================================================================
+juce::String CommandLine::getUsage()
+{
+    return "Usage: AudioFileTransformerCLI --input <file|folder|pattern> [--input ...] --output <dir> [options]\n"
+           "\n"
+           "  -i, --input <path>       WAV file, folder of WAVs, or wildcard pattern (repeatable)\n"
+           "  -o, --output <dir>       Output directory (created if missing)\n"
+           "  -p, --processor <name>   gain | grainshifter | tdpsola (default gain)\n"
+           "      --param <id=value>   Parameter in its own units (repeatable), e.g. gain=0.5,\n"
+           "                           shift_ratio=1.5, or for tdpsola ratio / minHz / maxHz / analysisWindowMs\n"
+           "  -b, --block-size <n>     Process block size (default 512)\n"
+           "  -j, --threads <n>        Concurrent jobs (default: CPU count)\n"
+           "      --streaming          Stream read -> process -> write instead of buffering whole files\n"
+           "      --bit-depth <16|24>  Output bit depth (default 24)\n"
+           "      --dither             TPDF dither before quantisation\n"
+           "      --start <seconds>    Render from here (default: start of file)\n"
+           "      --end <seconds>      Render up to here (default: end of file)\n"
+           "      --pre-roll <seconds> Input processed ahead of --start to settle the processor, not written\n"
+           "      --timing <file>      Write JSON Lines timing here instead of stdout\n"
+           "      --block-log          Record each job's blocks to <output>.aftlog (gain / grainshifter)\n"
+           "      --block-log-every <n>\n"
+           "                           Keep only every Nth block in the log (default 1)\n"
+           "      --block-log-fraction <p>\n"
+           "                           Then keep this random fraction of those, 0..1 (default 1)\n"
+           "      --block-log-seed <n> Seed for --block-log-fraction; same seed, same blocks (default 0)\n"
+           "      --convert-block-log <file>\n"
+           "                           Convert a binary block log to input/output_samples.csv\n"
+           "                           in --output instead of rendering (no --input needed)\n"
+           "  -h, --help               Show this text\n";
+}
+
+bool CommandLine::parse(const juce::StringArray& args, Options& options, juce::String& error)
+{
+    options = Options();
+
+    for (int i = 0; i < args.size(); ++i)
+    {
+        const auto arg = args[i];
+
+        auto nextValue = [&](juce::String& value)
+        {
+            if (i + 1 >= args.size())
+            {
+                error = "Missing value for " + arg;
+                return false;
+            }
+            value = args[++i];
+            return true;
+        };
+
+        juce::String value;
+
+        if (arg == "-h" || arg == "--help")
+        {
+            options.showHelp = true;
+            return true;
+        }
+        else if (arg == "-i" || arg == "--input")
+        {
+            if (! nextValue(value)) return false;
+            options.inputs.add(value);
+        }
+        else if (arg == "-o" || arg == "--output")
+        {
+            if (! nextValue(value)) return false;
+            options.outputDirectory = resolvePath(value);
+        }
+        else if (arg == "-p" || arg == "--processor")
+        {
+            if (! nextValue(value)) return false;
+
+            bool found = false;
+            for (const auto& entry : kProcessorNames)
+            {
+                if (value.equalsIgnoreCase(entry.name))
+                {
+                    options.processor = entry.processor;
+                    found = true;
+                }
+            }
+            if (! found)
+            {
+                error = "Unknown processor: " + value;
+                return false;
+            }
+        }
+        else if (arg == "--param")
+        {
+            if (! nextValue(value)) return false;
+
+            const auto id = value.upToFirstOccurrenceOf("=", false, false).trim();
+            const auto number = value.fromFirstOccurrenceOf("=", false, false).trim();
+            if (id.isEmpty() || ! value.contains("=") || ! number.containsOnly("0123456789.-+eE") || number.isEmpty())
+            {
+                error = "Expected --param <id=value>, got: " + value;
+                return false;
+            }
+            options.parameters.set(id, number);
+        }
+        else if (arg == "-b" || arg == "--block-size")
+        {
+            if (! nextValue(value)) return false;
+            if (! parseInt(value, 1, options.blockSize))
+            {
+                error = "Invalid block size: " + value;
+                return false;
+            }
+        }
+        else if (arg == "-j" || arg == "--threads")
+        {
+            if (! nextValue(value)) return false;
+            if (! parseInt(value, 0, options.numThreads))
+            {
+                error = "Invalid thread count: " + value;
+                return false;
+            }
+        }
+        else if (arg == "--streaming")
+        {
+            options.streaming = true;
+        }
+        else if (arg == "--bit-depth")
+        {
+            if (! nextValue(value)) return false;
+            if (value != "16" && value != "24")
+            {
+                error = "Bit depth must be 16 or 24: " + value;
+                return false;
+            }
+            options.bitDepth = value.getIntValue();
+        }
+        else if (arg == "--dither")
+        {
+            options.dither = true;
+        }
+        else if (arg == "--start" || arg == "--end" || arg == "--pre-roll")
+        {
+            if (! nextValue(value)) return false;
+
+            double seconds = 0.0;
+            if (! parseSeconds(value, seconds))
+            {
+                error = "Invalid time for " + arg + ": " + value;
+                return false;
+            }
+
+            if      (arg == "--start") options.range.start   = seconds;
+            else if (arg == "--end")   options.range.end     = seconds;
+            else                       options.range.preRoll = seconds;
+        }
+        else if (arg == "--timing")
+        {
+            if (! nextValue(value)) return false;
+            options.timingFile = resolvePath(value);
+        }
+        else if (arg == "--block-log")
+        {
+            options.blockLog = true;
+        }
+        else if (arg == "--block-log-every")
+        {
+            if (! nextValue(value)) return false;
+            if (! parseInt(value, 1, options.blockLogEveryNth))
+            {
+                error = "Invalid --block-log-every: " + value;
+                return false;
+            }
+        }
+        else if (arg == "--block-log-fraction")
+        {
+            if (! nextValue(value)) return false;
+            if (! parseFraction(value, options.blockLogFraction))
+            {
+                error = "--block-log-fraction must be between 0 and 1: " + value;
+                return false;
+            }
+        }
+        else if (arg == "--block-log-seed")
+        {
+            if (! nextValue(value)) return false;
+            if (! value.containsOnly("0123456789") || value.isEmpty())
+            {
+                error = "Invalid --block-log-seed: " + value;
+                return false;
+            }
+            options.blockLogSeed = static_cast<juce::uint64>(value.getLargeIntValue());
+        }
+        else if (arg == "--convert-block-log")
+        {
+            if (! nextValue(value)) return false;
+            options.blockLogToConvert = resolvePath(value);
+        }
+        else
+        {
+            error = "Unknown argument: " + arg;
+            return false;
+        }
+    }
+
+    if (options.inputs.isEmpty() && options.blockLogToConvert == juce::File())
+    {
+        error = "No --input given";
+        return false;
+    }
+    if (options.outputDirectory == juce::File())
+    {
+        error = "No --output given";
+        return false;
+    }
+   #if ! AFT_BLOCK_LOGGING
+    if (options.blockLog)
+    {
+        error = "--block-log is unavailable: built with AFT_BLOCK_LOGGING=OFF";
+        return false;
+    }
+   #endif
+    if (options.blockLog && options.processor == Processor::kTdPsola)
+    {
+        error = "--block-log needs a block-based processor (gain or grainshifter)";
+        return false;
+    }
+    if (options.range.end >= 0.0 && options.range.end <= options.range.start)
+    {
+        error = "--end must be after --start";
+        return false;
+    }
+
+    return true;
+}
+
+juce::Array<juce::File> CommandLine::expandInputs(const juce::StringArray& inputs)
+{
+    juce::Array<juce::File> files;
+
+    for (const auto& input : inputs)
+    {
+        const auto path = resolvePath(input);
+
+        if (path.isDirectory())
+        {
+            auto children = path.findChildFiles(juce::File::findFiles, false, "*.wav");
+            children.sort();
+            for (const auto& child : children)
+                files.addIfNotAlreadyThere(child);
+        }
+        else if (path.getFileName().containsAnyOf("*?"))
+        {
+            auto matches = path.getParentDirectory().findChildFiles(juce::File::findFiles, false, path.getFileName());
+            matches.sort();
+            for (const auto& match : matches)
+                files.addIfNotAlreadyThere(match);
+        }
+        else
+        {
+            files.addIfNotAlreadyThere(path);
+        }
+    }
+
+    return files;
+}
+
+//==============================================================================
+int CommandLine::run(const Options& options,
+                     std::function<void(const juce::String&)> emitLine,
+                     juce::String& error)
+{
+    if (options.blockLogToConvert != juce::File())
+    {
+        if (! BinaryBlockLogger::convertToCsv(options.blockLogToConvert, options.outputDirectory, error))
+            return 2;
+
+        auto* record = new juce::DynamicObject();
+        record->setProperty("converted", options.blockLogToConvert.getFullPathName());
+        record->setProperty("output",    options.outputDirectory.getFullPathName());
+        emitLine(juce::JSON::toString(juce::var(record), true));
+        return 0;
+    }
+
+    const auto inputs = expandInputs(options.inputs);
+    if (inputs.isEmpty())
+    {
+        error = "No input files matched";
+        return 2;
+    }
+
+    if (options.outputDirectory.createDirectory().failed())
+    {
+        error = "Failed to create output directory: " + options.outputDirectory.getFullPathName();
+        return 2;
+    }
+
+    // Named exactly as a BatchRenderQueue run over the same inputs would name them.
+    const auto outputs = BatchRenderQueue::resolveOutputFiles(inputs, options.outputDirectory);
+
+    const int numThreads = juce::jlimit(1, inputs.size(),
+                                        options.numThreads > 0 ? options.numThreads : juce::SystemStats::getNumCpus());
+
+    // Build and configure every render slot up front, on this thread.
+    TD_PSOLA::TDPSOLA::Config psolaConfig;
+    float                     psolaRatio = 1.0f;
+    const bool                isPsola    = options.processor == Processor::kTdPsola;
+
+    std::vector<std::unique_ptr<RenderSlot>> slots;
+    for (int i = 0; i < numThreads; ++i)
+    {
+        auto slot = std::make_unique<RenderSlot>();
+        if (! isPsola)
+        {
+            slot->processor = std::make_unique<AudioFileTransformerProcessor>();
+            if (! configureProcessor(*slot->processor, options, error))
+                return 2;
+        }
+        slots.push_back(std::move(slot));
+    }
+
+    if (isPsola && ! configurePsola(options, psolaConfig, psolaRatio, error))
+        return 2;
+
+    //==============================================================================
+    juce::CriticalSection emitLock;
+    std::atomic<int>      succeeded { 0 };
+
+    auto emit = [&](const juce::var& record)
+    {
+        const juce::ScopedLock sl (emitLock);
+        if (emitLine)
+            emitLine(juce::JSON::toString(record, true));
+    };
+
+    auto renderJob = [&](int threadIndex, int job)
+    {
+        auto& slot = *slots[static_cast<size_t>(threadIndex)];
+
+        const auto& input  = inputs.getReference(job);
+        const auto& output = outputs.getReference(job);
+
+        const double startMs = juce::Time::getMillisecondCounterHiRes();
+        JobOutcome   outcome;
+
+        if (isPsola)
+        {
+            outcome = renderPsola(slot.psola, psolaConfig, psolaRatio, options.range, input, output);
+        }
+        else
+        {
+            int         numChannels = 0;
+            juce::int64 fileLength  = 0;
+            if (FileUtils::readAudioFileInfo(input, outcome.sampleRate, numChannels, fileLength))
+                outcome.inputSamples = options.range.resolve(outcome.sampleRate, fileLength).getLength();
+
+            outcome.ok = slot.processor->transformFile(input, output, nullptr, options.range);
+            if (! outcome.ok)
+                outcome.error = slot.processor->getLastTransformError();
+        }
+
+        const double wallSeconds  = (juce::Time::getMillisecondCounterHiRes() - startMs) * 0.001;
+        const double audioSeconds = outcome.sampleRate > 0.0 ? static_cast<double>(outcome.inputSamples) / outcome.sampleRate : 0.0;
+
+        if (outcome.ok)
+            succeeded.fetch_add(1);
+
+        auto* record = new juce::DynamicObject();
+        record->setProperty("job",            job);
+        record->setProperty("thread",         threadIndex);
+        record->setProperty("input",          input.getFullPathName());
+        record->setProperty("output",         output.getFullPathName());
+        record->setProperty("processor",      toString(options.processor));
+        record->setProperty("status",         outcome.ok ? "ok" : "failed");
+        record->setProperty("error",          outcome.error);
+        record->setProperty("sampleRate",     outcome.sampleRate);
+        record->setProperty("inputSamples",   outcome.inputSamples);
+        record->setProperty("audioSeconds",   audioSeconds);
+        record->setProperty("wallSeconds",    wallSeconds);
+        record->setProperty("realtimeFactor", wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0);
+        if (options.blockLog)
+            record->setProperty("blockLog", OfflineRenderer::getBlockLogFile(output).getFullPathName());
+        emit(juce::var(record));
+    };
+
+    const double runStartMs = juce::Time::getMillisecondCounterHiRes();
+
+    JobPool pool("CLI Render");
+    pool.start(numThreads, inputs.size(), renderJob);
+    pool.join();
+
+    const int numSucceeded = succeeded.load();
+
+    auto* summary = new juce::DynamicObject();
+    summary->setProperty("summary",     true);
+    summary->setProperty("processor",   toString(options.processor));
+    summary->setProperty("jobs",        inputs.size());
+    summary->setProperty("succeeded",   numSucceeded);
+    summary->setProperty("failed",      inputs.size() - numSucceeded);
+    summary->setProperty("threads",     numThreads);
+    summary->setProperty("blockSize",   options.blockSize);
+    summary->setProperty("wallSeconds", (juce::Time::getMillisecondCounterHiRes() - runStartMs) * 0.001);
+    emit(juce::var(summary));
+
+    return numSucceeded == inputs.size() ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Util/Juce_Header.h"
+#include "Processor/RenderRange.h"
+#include <functional>
+
+/**
+ * Headless render driver behind the AudioFileTransformerCLI target.
+ *
+ * Parses the command line, expands input globs and runs each file as an
+ * independent job on a pool of threads. gain / grainshifter jobs go through
+ * AudioFileTransformerProcessor::transformFile (one processor instance per
+ * thread); tdpsola jobs load the file and run TD_PSOLA::TDPSOLA directly,
+ * so they reject regions longer than 2^31 - 1 samples.
+ *
+ * Every finished job emits one JSON object on its own line (JSON Lines), and
+ * a final summary line closes the run, so farm tooling can ingest timings
+ * without scraping text.
+ *
+ * --block-log records a BinaryBlockLogger file beside each output WAV
+ * (gain / grainshifter only), optionally sampled with --block-log-every /
+ * --block-log-fraction / --block-log-seed; --convert-block-log turns such a
+ * file into CSV in the output directory instead of rendering.
+ */
+namespace CommandLine
+{
+    enum class Processor
+    {
+        kGain = 0,
+        kGrainShifter,
+        kTdPsola
+    };
+
+    struct Options
+    {
+        juce::StringArray     inputs;                         // files, folders or *.wav-style patterns
+        juce::File            outputDirectory;
+        Processor             processor      = Processor::kGain;
+        juce::StringPairArray parameters;                     // id -> value in parameter units
+        int                   blockSize      = 512;
+        int                   numThreads     = 0;             // 0 = CPU count
+        bool                  streaming      = false;
+        int                   bitDepth       = 24;
+        bool                  dither         = false;
+        RenderRange           range          = RenderRange::inSeconds(0.0);   // --start / --end / --pre-roll
+        juce::File            timingFile;                     // empty = stdout
+        bool                  blockLog       = false;         // <output>.aftlog per job
+        int                   blockLogEveryNth = 1;           // BinaryBlockLogger::Sampling
+        double                blockLogFraction = 1.0;
+        juce::uint64          blockLogSeed     = 0;
+        juce::File            blockLogToConvert;              // set: convert instead of render
+        bool                  showHelp       = false;
+    };
+
+    juce::String getUsage();
+
+    /** Parses args (argv without the program name). Returns false with error set on bad input. */
+    bool parse(const juce::StringArray& args, Options& options, juce::String& error);
+
+    /**
+     * Expands files, folders (every .wav, sorted) and wildcard patterns in the
+     * file name part ("renders/*.wav"). Relative paths resolve against the
+     * working directory. Duplicates are dropped; missing files are kept so the
+     * job reports them.
+     */
+    juce::Array<juce::File> expandInputs(const juce::StringArray& inputs);
+
+    /**
+     * Renders every input. emitLine receives each JSON line and is called from
+     * the render threads under a lock. Returns the process exit code: 0 when
+     * every job succeeded, 1 if any failed, 2 if the run could not start
+     * (error says why).
+     */
+    int run(const Options& options,
+            std::function<void(const juce::String&)> emitLine,
+            juce::String& error);
+}
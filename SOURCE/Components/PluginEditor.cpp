@@ -60,6 +60,72 @@ AudioFileTransformerEditor::AudioFileTransformerEditor(AudioFileTransformerProce
     processButton.setEnabled(false);
     addAndMakeVisible(processButton);
 
+    // Pause / cancel the running job — enabled only while processing.
+    pauseButton.setButtonText("Pause");
+    pauseButton.onClick = [this]() { togglePause(); };
+    addAndMakeVisible(pauseButton);
+
+    cancelButton.setButtonText("Cancel");
+    cancelButton.onClick = [this]() { cancelProcessing(); };
+    addAndMakeVisible(cancelButton);
+
+    updateRenderControlButtons();
+
+    // Streaming render — overlaps read/process/write and holds only a few blocks.
+    streamingToggle.setButtonText("Stream (low memory)");
+    streamingToggle.setToggleState(mProcessor.getOfflineRenderer().getRenderMode()
+                                       == OfflineRenderer::RenderMode::kStreaming,
+                                   juce::dontSendNotification);
+    streamingToggle.onClick = [this]()
+    {
+        mProcessor.getOfflineRenderer().setRenderMode(streamingToggle.getToggleState()
+                                                          ? OfflineRenderer::RenderMode::kStreaming
+                                                          : OfflineRenderer::RenderMode::kBuffered);
+    };
+    addAndMakeVisible(streamingToggle);
+
+    // Render cache — repeated input + processor state links the earlier render.
+    cacheToggle.setButtonText("Use render cache");
+    cacheToggle.setToggleState(mProcessor.isRenderCacheEnabled(), juce::dontSendNotification);
+    cacheToggle.onClick = [this]()
+    {
+        mProcessor.setRenderCacheEnabled(cacheToggle.getToggleState());
+    };
+    addAndMakeVisible(cacheToggle);
+
+    // Preview: render the first seconds at high priority and play them through
+    // the plugin output while the full render continues behind it.
+    previewToggle.setButtonText("Preview first " + juce::String(static_cast<int>(PreviewRenderer::kDefaultPreviewSeconds)) + " s");
+    previewToggle.setToggleState(true, juce::dontSendNotification);
+    addAndMakeVisible(previewToggle);
+
+    playPreviewButton.setButtonText("Play Preview");
+    playPreviewButton.onClick = [this]() { togglePreviewPlayback(); };
+    playPreviewButton.setEnabled(false);
+    addAndMakeVisible(playPreviewButton);
+
+    // Live monitor: transform the host input in realtime with the active processor.
+    liveToggle.setButtonText("Live monitor");
+    liveToggle.setToggleState(mProcessor.isLiveMode(), juce::dontSendNotification);
+    liveToggle.onClick = [this]() { mProcessor.setLiveMode(liveToggle.getToggleState()); };
+    addAndMakeVisible(liveToggle);
+
+    // Audition: play the finished render through the plugin output, seekable.
+    auditionButton.setButtonText("Audition");
+    auditionButton.onClick = [this]() { toggleAudition(); };
+    auditionButton.setEnabled(false);
+    addAndMakeVisible(auditionButton);
+
+    auditionSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    auditionSlider.setTextBoxStyle(juce::Slider::NoTextBox, false, 0, 0);
+    auditionSlider.setRange(0.0, 1.0);
+    auditionSlider.onDragEnd = [this]()
+    {
+        mProcessor.getAuditionTransport().seekToFraction(auditionSlider.getValue());
+    };
+    auditionSlider.setEnabled(false);
+    addAndMakeVisible(auditionSlider);
+
     // Logging toggle
     loggingToggle.setButtonText("Enable Data Logging");
     loggingToggle.setToggleState(mProcessor.getIsLogging(), juce::dontSendNotification);
@@ -72,37 +138,65 @@ AudioFileTransformerEditor::AudioFileTransformerEditor(AudioFileTransformerProce
     };
     addAndMakeVisible(loggingToggle);
 
-    // Per-block CSV logging toggle — independent of main logging flag.
-    // Cascades through RD_Processor children only (swapper + active processor);
-    // PitchManager / Granulator are unaffected.
-    blockLoggingToggle.setButtonText("Per-Block CSV Logging");
-    blockLoggingToggle.setToggleState(mProcessor.getIsBlockLogging(), juce::dontSendNotification);
+    // Per-block sample log — independent of main logging flag. Each render
+    // writes a binary log beside its WAV (convert with the CLI's
+    // --convert-block-log); RD's synchronous per-block CSV stays off.
+    blockLoggingToggle.setButtonText("Per-Block Sample Log");
+    blockLoggingToggle.setToggleState(mProcessor.getOfflineRenderer().isBlockLogEnabled(), juce::dontSendNotification);
     blockLoggingToggle.onClick = [this]()
     {
-        mProcessor.setIsBlockLogging(blockLoggingToggle.getToggleState());
+        mProcessor.getOfflineRenderer().setBlockLogEnabled(blockLoggingToggle.getToggleState());
     };
     addAndMakeVisible(blockLoggingToggle);
 
-    // Block-size selector — powers of 2, 32..4096.
+    // Keeps long renders' logs manageable; applies from the next render.
+    for (int everyNth : { 1, 10, 100, 1000 })
+        blockLogSamplingSelector.addItem(everyNth == 1 ? juce::String("Every block")
+                                                       : "Every " + juce::String(everyNth) + "th block",
+                                         everyNth);
+    blockLogSamplingSelector.setSelectedId(juce::jmax(1, mProcessor.getBufferProcessingManager()
+                                                                    .getBlockLogger().getSampling().everyNth),
+                                           juce::dontSendNotification);
+    blockLogSamplingSelector.onChange = [this]()
+    {
+        auto& logger   = mProcessor.getBufferProcessingManager().getBlockLogger();
+        auto  sampling = logger.getSampling();
+        sampling.everyNth = blockLogSamplingSelector.getSelectedId();
+        logger.setSampling(sampling);
+    };
+    addAndMakeVisible(blockLogSamplingSelector);
+
+   #if ! AFT_BLOCK_LOGGING
+    blockLoggingToggle      .setEnabled(false);
+    blockLogSamplingSelector.setEnabled(false);
+   #endif
+
+    // Block-size selector — powers of 2, 32..4096, plus "Auto" (probe + cache fastest).
     blockSizeLabel.setText("Block Size:", juce::dontSendNotification);
     blockSizeLabel.setFont(juce::Font(14.0f, juce::Font::bold));
     addAndMakeVisible(blockSizeLabel);
 
     {
-        const int currentBlockSize = mProcessor.getBufferProcessingManager().getBlockSize();
+        auto& bpm = mProcessor.getBufferProcessingManager();
+        const int currentBlockSize = bpm.getBlockSize();
         int idToSelect = 0;
         for (int v = 32, id = 1; v <= 4096; v <<= 1, ++id)
         {
             blockSizeSelector.addItem(juce::String(v), id);
             if (v == currentBlockSize) idToSelect = id;
         }
+        blockSizeSelector.addItem("Auto", kAutoBlockSizeId);
         if (idToSelect == 0) idToSelect = 5; // 512 fallback
+        if (bpm.getAutoTuneBlockSize()) idToSelect = kAutoBlockSizeId;
         blockSizeSelector.setSelectedId(idToSelect, juce::dontSendNotification);
     }
     blockSizeSelector.onChange = [this]()
     {
-        const int chosen = blockSizeSelector.getText().getIntValue();
-        mProcessor.getBufferProcessingManager().setBlockSize(chosen);
+        auto& bpm = mProcessor.getBufferProcessingManager();
+        const bool autoTune = blockSizeSelector.getSelectedId() == kAutoBlockSizeId;
+        bpm.setAutoTuneBlockSize(autoTune);
+        if (! autoTune)
+            bpm.setBlockSize(blockSizeSelector.getText().getIntValue());
     };
     addAndMakeVisible(blockSizeSelector);
 
@@ -276,6 +370,29 @@ void AudioFileTransformerEditor::resized()
     processorRow.removeFromLeft(15);
     statusLabel      .setBounds(processorRow);
 
+    bounds.removeFromTop(8);
+    auto renderControlRow = bounds.removeFromTop(32);
+    renderControlRow.removeFromLeft(235); // align under Process button
+    pauseButton .setBounds(renderControlRow.removeFromLeft(120));
+    renderControlRow.removeFromLeft(15);
+    cancelButton.setBounds(renderControlRow.removeFromLeft(120));
+    renderControlRow.removeFromLeft(15);
+    streamingToggle.setBounds(renderControlRow.removeFromLeft(180));
+    renderControlRow.removeFromLeft(15);
+    cacheToggle    .setBounds(renderControlRow.removeFromLeft(140));
+
+    bounds.removeFromTop(8);
+    auto previewRow = bounds.removeFromTop(32);
+    liveToggle       .setBounds(previewRow.removeFromLeft(220));
+    previewRow.removeFromLeft(15);
+    playPreviewButton.setBounds(previewRow.removeFromLeft(120));
+    previewRow.removeFromLeft(15);
+    previewToggle    .setBounds(previewRow.removeFromLeft(180));
+    previewRow.removeFromLeft(15);
+    auditionButton   .setBounds(previewRow.removeFromLeft(120));
+    previewRow.removeFromLeft(15);
+    auditionSlider   .setBounds(previewRow);
+
     bounds.removeFromTop(20); // Spacing
 
     // Parameter control (unified for both processors) — horizontal linear slider.
@@ -310,8 +427,9 @@ void AudioFileTransformerEditor::resized()
 
     // Logging toggles — side by side, taller for visible checkbox
     auto loggingRow = bounds.removeFromTop(40).reduced(60, 0);
-    loggingToggle     .setBounds(loggingRow.removeFromLeft(loggingRow.getWidth() / 2));
-    blockLoggingToggle.setBounds(loggingRow);
+    loggingToggle           .setBounds(loggingRow.removeFromLeft(loggingRow.getWidth() / 2));
+    blockLogSamplingSelector.setBounds(loggingRow.removeFromRight(160).reduced(0, 6));
+    blockLoggingToggle      .setBounds(loggingRow);
 
 }
 
@@ -324,7 +442,14 @@ void AudioFileTransformerEditor::timerCallback()
     {
         float progress = currentProgress.load();
         int percent = static_cast<int>(progress * 100.0f);
-        statusLabel.setText("Processing... " + juce::String(percent) + "%", juce::dontSendNotification);
+        const juce::String state = fbm.isPaused() ? "Paused... " : "Processing... ";
+
+        juce::String eta;
+        const double remaining = fbm.getEstimatedSecondsRemaining();
+        if (! fbm.isPaused() && remaining >= 0.0)
+            eta = " (~" + juce::String(juce::roundToInt(remaining)) + " s left)";
+
+        statusLabel.setText(state + juce::String(percent) + "%" + eta, juce::dontSendNotification);
     }
     else if (mWasProcessing)
     {
@@ -337,9 +462,22 @@ void AudioFileTransformerEditor::timerCallback()
         currentProgress.store(0.0f);
         updateProcessButtonState();
 
-        if (success)
+        if (fbm.wasCancelled())
         {
-            statusLabel.setText("Processing complete!", juce::dontSendNotification);
+            statusLabel.setText("Cancelled", juce::dontSendNotification);
+            statusLabel.setColour(juce::Label::textColourId, juce::Colours::orange);
+        }
+        else if (success)
+        {
+            // Drop the last audition so the next one picks up this render.
+            mProcessor.getAuditionTransport().unload();
+
+            const auto& metrics = fbm.getLastMetrics();
+            juce::String done = fbm.wasCacheHit() ? "Processing complete (cached)" : "Processing complete!";
+            if (metrics.isValid())
+                done << " " << juce::String(metrics.getRealtimeFactor(), 1) << "x realtime";
+
+            statusLabel.setText(done, juce::dontSendNotification);
             statusLabel.setColour(juce::Label::textColourId, juce::Colours::lightgreen);
         }
         else
@@ -349,6 +487,22 @@ void AudioFileTransformerEditor::timerCallback()
         }
     }
 
+    if (nowProcessing != mWasProcessing)
+        updateRenderControlButtons();
+
+    auto& preview = mProcessor.getPreviewRenderer();
+    playPreviewButton.setEnabled(preview.isReady());
+    playPreviewButton.setButtonText(preview.isPlaying() ? "Stop Preview" : "Play Preview");
+
+    auto& audition = mProcessor.getAuditionTransport();
+    const auto auditionLength = audition.getLength();
+    auditionButton.setEnabled(! nowProcessing && fbm.wasSuccessful());
+    auditionButton.setButtonText(audition.isPlaying() ? "Stop Audition" : "Audition");
+    auditionSlider.setEnabled(auditionLength > 0);
+    if (auditionLength > 0 && ! auditionSlider.isMouseButtonDown())
+        auditionSlider.setValue(static_cast<double>(audition.getPosition()) / static_cast<double>(auditionLength),
+                                juce::dontSendNotification);
+
     mWasProcessing = nowProcessing;
 }
 
@@ -425,9 +579,7 @@ void AudioFileTransformerEditor::processFile()
     fbm.setProgressCallback([this](float progress) {
         currentProgress.store(progress);
     });
-    const bool started = fbm.startProcessing(mProcessor.getInputBuffer(),
-                                             mProcessor.getProcessedBuffer(),
-                                             mProcessor.getBufferProcessingManager());
+    const bool started = mProcessor.startFileRender(previewToggle.getToggleState());
     if (! started)
     {
         // Pre-thread validation failed: thread never set mIsProcessing=true,
@@ -439,6 +591,61 @@ void AudioFileTransformerEditor::processFile()
     }
 }
 
+void AudioFileTransformerEditor::togglePause()
+{
+    auto& fbm = mProcessor.getFileToBufferManager();
+    if (fbm.isPaused())
+        fbm.resumeProcessing();
+    else
+        fbm.pauseProcessing();
+
+    updateRenderControlButtons();
+}
+
+void AudioFileTransformerEditor::cancelProcessing()
+{
+    // Non-blocking: the worker unwinds at its next block boundary and the
+    // timer picks up the processing -> idle transition.
+    auto& fbm = mProcessor.getFileToBufferManager();
+    fbm.resumeProcessing();
+    fbm.cancelProcessing();
+    cancelButton.setEnabled(false);
+    pauseButton .setEnabled(false);
+}
+
+void AudioFileTransformerEditor::togglePreviewPlayback()
+{
+    auto& preview = mProcessor.getPreviewRenderer();
+    if (preview.isPlaying())
+    {
+        preview.stopPlayback();
+    }
+    else
+    {
+        mProcessor.getAuditionTransport().stop();
+        preview.play();
+    }
+}
+
+void AudioFileTransformerEditor::toggleAudition()
+{
+    auto& audition = mProcessor.getAuditionTransport();
+    if (audition.isPlaying())
+    {
+        audition.stop();
+    }
+    else if (audition.hasSource())
+    {
+        mProcessor.getPreviewRenderer().stopPlayback();
+        audition.start();
+    }
+    else if (! mProcessor.auditionLastRender())
+    {
+        statusLabel.setText("Error: " + mProcessor.getLastTransformError(), juce::dontSendNotification);
+        statusLabel.setColour(juce::Label::textColourId, juce::Colours::red);
+    }
+}
+
 void AudioFileTransformerEditor::setDefaultInputFile()
 {
     auto defaultInputFile = FileToBufferManager::getDefaultInputFile();
@@ -460,6 +667,23 @@ void AudioFileTransformerEditor::updateProcessButtonState()
     processButton.setEnabled(canProcess);
 }
 
+void AudioFileTransformerEditor::updateRenderControlButtons()
+{
+    auto& fbm = mProcessor.getFileToBufferManager();
+    const bool processing = fbm.isProcessing();
+    pauseButton .setEnabled(processing);
+    cancelButton.setEnabled(processing);
+    pauseButton .setButtonText(fbm.isPaused() ? "Resume" : "Pause");
+    streamingToggle.setEnabled(! processing);
+    cacheToggle    .setEnabled(! processing);
+    previewToggle  .setEnabled(! processing);
+
+   #if AFT_BLOCK_LOGGING
+    blockLoggingToggle      .setEnabled(! processing);
+    blockLogSamplingSelector.setEnabled(! processing);
+   #endif
+}
+
 void AudioFileTransformerEditor::updateParameterValueLabel()
 {
     float paramValue = static_cast<float>(parameterSlider.getValue());
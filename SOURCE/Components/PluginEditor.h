@@ -31,13 +31,24 @@ private:
     juce::TextEditor outputNameEditor;
 
     juce::TextButton processButton;
+    juce::TextButton pauseButton;
+    juce::TextButton cancelButton;
+    juce::ToggleButton streamingToggle;
+    juce::ToggleButton cacheToggle;
+    juce::ToggleButton previewToggle;
+    juce::ToggleButton liveToggle;
+    juce::TextButton   playPreviewButton;
+    juce::TextButton   auditionButton;
+    juce::Slider       auditionSlider;
     juce::Label statusLabel;
 
     juce::ToggleButton loggingToggle;
     juce::ToggleButton blockLoggingToggle;
+    juce::ComboBox     blockLogSamplingSelector;   // item id = log every Nth block
 
     juce::Label    blockSizeLabel;
     juce::ComboBox blockSizeSelector;
+    static constexpr int kAutoBlockSizeId = 100;
 
     // GrainShifter parameter controls (visible only when GrainShifter is active)
     juce::Label  pitchWindowLabel,    pitchWindowValueLabel;
@@ -76,11 +87,16 @@ private:
     void applyOutputName();
     void syncOutputDirsToUi();
     void processFile();
+    void togglePause();
+    void cancelProcessing();
+    void togglePreviewPlayback();
+    void toggleAudition();
     void processorSelectionChanged();
 
     // Helper methods
     void setDefaultInputFile();
     void updateProcessButtonState();
+    void updateRenderControlButtons();
     void updateParameterValueLabel();
     void configureParameterControlForProcessor(ActiveProcessor processor);
 
@@ -0,0 +1,274 @@
+#include "Processor/AuditionTransport.h"
+#include "Util/FileUtils.h"
+#include <cmath>
+
+AuditionTransport::AuditionTransport() {}
+
+AuditionTransport::~AuditionTransport()
+{
+    unload();
+}
+
+//==============================================================================
+void AuditionTransport::prepare(double hostSampleRate, int maxBlockSize)
+{
+    mHostSampleRate = hostSampleRate > 0.0 ? hostSampleRate : 44100.0;
+    mMaxBlockSize   = juce::jmax(1, maxBlockSize);
+
+    // Worst case per block: maxBlockSize * ratio source frames, plus the frame
+    // the last output interpolates towards and a fractional start.
+    const int scratchFrames = static_cast<int>(std::ceil(mMaxBlockSize * kMaxSpeedRatio)) + 2;
+    mScratch.setSize(kNumChannels, scratchFrames, false, true, false);
+}
+
+bool AuditionTransport::loadBuffer(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples, double sampleRate)
+{
+    mLastError.clear();
+
+    if (numSamples <= 0 || startSample < 0 || startSample + numSamples > buffer.getNumSamples()
+        || buffer.getNumChannels() <= 0 || sampleRate <= 0.0)
+    {
+        mLastError = "Nothing to audition";
+        return false;
+    }
+
+    stop();
+    const int slot = _acquireFreeSlot();
+
+    auto& source = mSources[slot];
+    source.reader.reset();
+    source.buffer      = &buffer;
+    source.bufferStart = startSample;
+    source.length      = numSamples;
+    source.sampleRate  = sampleRate;
+    source.numChannels = buffer.getNumChannels();
+
+    _publish(slot);
+    return true;
+}
+
+bool AuditionTransport::loadFile(const juce::File& wavFile)
+{
+    mLastError.clear();
+
+    // Mapped, so the audio thread converts straight from the page cache with no I/O calls.
+    auto reader = FileUtils::createReaderFor(wavFile, FileUtils::ReadStrategy::kMemoryMapped);
+    if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+    {
+        mLastError = "Failed to map WAV: " + wavFile.getFullPathName();
+        return false;
+    }
+
+    stop();
+    const int slot = _acquireFreeSlot();
+
+    auto& source = mSources[slot];
+    source.buffer      = nullptr;
+    source.bufferStart = 0;
+    source.length      = reader->lengthInSamples;
+    source.sampleRate  = reader->sampleRate;
+    source.numChannels = static_cast<int>(reader->numChannels);
+    source.reader      = std::move(reader);
+
+    _publish(slot);
+    return true;
+}
+
+void AuditionTransport::unload()
+{
+    stop();
+
+    const int previous = mActiveSlot.exchange(-1);
+    if (previous >= 0)
+    {
+        _waitWhileReading(previous);
+        mSources[previous] = Source();
+    }
+
+    mPosition.store(0);
+}
+
+//==============================================================================
+int AuditionTransport::_acquireFreeSlot()
+{
+    // The inactive slot may still be mid-block if it was active before the last load.
+    const int slot = mActiveSlot.load() == 0 ? 1 : 0;
+    _waitWhileReading(slot);
+    return slot;
+}
+
+void AuditionTransport::_publish(int slot)
+{
+    mPosition.store(0);
+    mPendingSeek.store(0);
+
+    const int previous = mActiveSlot.exchange(slot);
+    if (previous >= 0 && previous != slot)
+    {
+        // Once the audio thread is out of it, the old source (and any buffer
+        // it pointed at) is released.
+        _waitWhileReading(previous);
+        mSources[previous] = Source();
+    }
+}
+
+void AuditionTransport::_waitWhileReading(int slot)
+{
+    // The audio thread holds a slot for at most one block.
+    while (mReaderSlot.load() == slot)
+        juce::Thread::sleep(1);
+}
+
+bool AuditionTransport::hasBufferSource() const
+{
+    const int slot = mActiveSlot.load();
+    return slot >= 0 && mSources[slot].buffer != nullptr;
+}
+
+juce::int64 AuditionTransport::getLength() const
+{
+    const int slot = mActiveSlot.load();
+    return slot >= 0 ? mSources[slot].length : 0;
+}
+
+double AuditionTransport::getSourceSampleRate() const
+{
+    const int slot = mActiveSlot.load();
+    return slot >= 0 ? mSources[slot].sampleRate : 0.0;
+}
+
+void AuditionTransport::start()
+{
+    if (! hasSource())
+        return;
+
+    // Play from the top once the end has been reached.
+    if (getPosition() >= getLength())
+        seek(0);
+
+    mIsPlaying.store(true);
+}
+
+void AuditionTransport::seek(juce::int64 sample)
+{
+    const auto target = juce::jmax<juce::int64>(0, sample);
+    mPendingSeek.store(target);
+    mPosition.store(target);
+}
+
+void AuditionTransport::seekToFraction(double fraction)
+{
+    seek(static_cast<juce::int64>(std::llround(juce::jlimit(0.0, 1.0, fraction) * static_cast<double>(getLength()))));
+}
+
+//==============================================================================
+bool AuditionTransport::renderNextBlock(juce::AudioBuffer<float>& buffer)
+{
+    const int slotIndex = mActiveSlot.load();
+    if (! mIsPlaying.load() || slotIndex < 0 || mScratch.getNumSamples() == 0)
+    {
+        buffer.clear();
+        return false;
+    }
+
+    // Mark the slot, then confirm it is still active; loads never touch a marked slot.
+    mReaderSlot.store(slotIndex);
+    if (mActiveSlot.load() != slotIndex)
+    {
+        mReaderSlot.store(-1);
+        buffer.clear();
+        return false;
+    }
+
+    const auto& source = mSources[slotIndex];
+
+    const juce::int64 seekTo = mPendingSeek.exchange(-1);
+    if (seekTo >= 0)
+        mReadPosition = static_cast<double>(seekTo);
+
+    // Hosts may exceed the prepared block size; the scratch buffer is sized per chunk.
+    const int numSamples = buffer.getNumSamples();
+    int       written    = 0;
+
+    while (written < numSamples)
+    {
+        const int chunk    = juce::jmin(mMaxBlockSize, numSamples - written);
+        const int rendered = _renderChunk(source, buffer, written, chunk);
+        written += rendered;
+
+        if (rendered < chunk)
+            break;
+    }
+
+    if (written < numSamples)
+        buffer.clear(written, numSamples - written);
+
+    const juce::int64 length = source.length;
+    mReaderSlot.store(-1);
+
+    const auto position = static_cast<juce::int64>(mReadPosition);
+    mPosition.store(position);
+
+    // A seek that arrived during this block keeps the transport running.
+    if (position >= length && mPendingSeek.load() < 0)
+        mIsPlaying.store(false);
+
+    return written > 0;
+}
+
+int AuditionTransport::_renderChunk(const Source& source, juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    const auto first = static_cast<juce::int64>(mReadPosition);
+    if (first >= source.length)
+        return 0;
+
+    const double ratio     = juce::jmin(kMaxSpeedRatio, source.sampleRate / mHostSampleRate);
+    const double frac      = mReadPosition - static_cast<double>(first);
+    const double remaining = static_cast<double>(source.length - first) - frac;
+    const int    numOut    = juce::jmin(numSamples, static_cast<int>(std::ceil(remaining / ratio)));
+    if (numOut <= 0)
+        return 0;
+
+    const int numFrames = static_cast<int>(juce::jmin<juce::int64>(
+        source.length - first,
+        static_cast<juce::int64>(frac + (numOut - 1) * ratio) + 2));
+
+    _fillScratch(source, first, numFrames);
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        const float* src = mScratch.getReadPointer(juce::jmin(ch, kNumChannels - 1));
+        float*       dst = buffer.getWritePointer(ch, startSample);
+
+        double position = frac;
+        for (int i = 0; i < numOut; ++i)
+        {
+            const int   index = static_cast<int>(position);
+            const float t     = static_cast<float>(position - index);
+            const float a     = src[index];
+            const float b     = index + 1 < numFrames ? src[index + 1] : a;
+            dst[i] = a + t * (b - a);
+            position += ratio;
+        }
+    }
+
+    mReadPosition += numOut * ratio;
+    return numOut;
+}
+
+void AuditionTransport::_fillScratch(const Source& source, juce::int64 start, int numFrames)
+{
+    if (source.buffer != nullptr)
+    {
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            mScratch.copyFrom(ch, 0, *source.buffer, juce::jmin(ch, source.numChannels - 1),
+                              source.bufferStart + static_cast<int>(start), numFrames);
+        return;
+    }
+
+    // Two destination channels: JUCE reads through stack channel pointers, no allocation.
+    source.reader->read(&mScratch, 0, numFrames, start, true, true);
+
+    if (source.numChannels == 1)
+        mScratch.copyFrom(1, 0, mScratch, 0, 0, numFrames);
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Util/Juce_Header.h"
+#include <atomic>
+
+/**
+ * @brief Plays a rendered result to the host output from the realtime path.
+ *
+ * The source is either a caller-owned AudioBuffer (the OfflineRenderer's
+ * processed buffer) or a rendered WAV, memory-mapped so the audio thread reads
+ * straight from the page cache. start / stop / seek are atomics set from the
+ * message thread and picked up at the next block.
+ *
+ * Sources live in two slots. renderNextBlock() marks the slot it reads and a
+ * load only ever fills the other one, waiting for the mark to clear; unload()
+ * waits the same way, so once it returns the caller may reuse or free the
+ * buffer it loaded. The audio thread never locks or allocates: the scratch
+ * buffer it interpolates from is sized in prepare().
+ *
+ * Playback follows the source's sample rate, linearly interpolated to the
+ * host's, up to kMaxSpeedRatio.
+ */
+class AuditionTransport
+{
+public:
+    AuditionTransport();
+    ~AuditionTransport();
+
+    static constexpr double kMaxSpeedRatio = 4.0;   // e.g. a 192 kHz render on a 48 kHz host
+    static constexpr int    kNumChannels   = 2;
+
+    //==============================================================================
+    // Message thread
+
+    /** Sizes the scratch buffer. Call from prepareToPlay, before audio runs. */
+    void prepare(double hostSampleRate, int maxBlockSize);
+
+    /**
+     * Plays numSamples of buffer from startSample. The buffer is not copied:
+     * it must stay untouched until unload() or the next load returns.
+     */
+    bool loadBuffer(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples, double sampleRate);
+
+    /** Memory-maps a rendered WAV. Returns false (see getLastError()) if it cannot be mapped. */
+    bool loadFile(const juce::File& wavFile);
+
+    /** Stops and drops the source once the audio thread has let go of it. */
+    void unload();
+
+    bool hasSource()       const { return mActiveSlot.load() >= 0; }
+    bool hasBufferSource() const;
+
+    /** Plays from the current position, or from the top if the end was reached. */
+    void start();
+    void stop() { mIsPlaying.store(false); }
+    void seek(juce::int64 sample);
+    void seekToFraction(double fraction);
+
+    bool        isPlaying() const    { return mIsPlaying.load(); }
+    juce::int64 getPosition() const  { return mPosition.load(); }
+    juce::int64 getLength() const;
+    double      getSourceSampleRate() const;
+
+    juce::String getLastError() const { return mLastError; }
+
+    //==============================================================================
+    // Audio thread
+
+    /**
+     * Overwrites buffer with the next block of the source while playing, or
+     * silence. Mono sources fill both channels. Stops at the end of the source.
+     * Returns true if source audio was written.
+     */
+    bool renderNextBlock(juce::AudioBuffer<float>& buffer);
+
+private:
+    struct Source
+    {
+        const juce::AudioBuffer<float>*          buffer = nullptr;
+        std::unique_ptr<juce::AudioFormatReader> reader;
+        int                                      bufferStart = 0;
+        juce::int64                              length      = 0;
+        double                                   sampleRate  = 0.0;
+        int                                      numChannels = 0;
+    };
+
+    int  _acquireFreeSlot();
+    void _publish(int slot);
+    void _waitWhileReading(int slot);
+    void _fillScratch(const Source& source, juce::int64 start, int numFrames);
+    int  _renderChunk(const Source& source, juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    Source mSources[2];
+
+    std::atomic<int>         mActiveSlot  { -1 };
+    std::atomic<int>         mReaderSlot  { -1 };
+    std::atomic<bool>        mIsPlaying   { false };
+    std::atomic<juce::int64> mPendingSeek { -1 };
+    std::atomic<juce::int64> mPosition    { 0 };
+
+    // Audio-thread state.
+    double                   mReadPosition   = 0.0;
+    double                   mHostSampleRate = 44100.0;
+    int                      mMaxBlockSize   = 0;
+    juce::AudioBuffer<float> mScratch;
+
+    juce::String mLastError;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AuditionTransport)
+};
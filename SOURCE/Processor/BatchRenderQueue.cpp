@@ -0,0 +1,324 @@
+#include "Processor/BatchRenderQueue.h"
+#include "PROCESSORS/GAIN/GainProcessor.h"
+#include "PROCESSORS/GRAIN/GrainShifterProcessor.h"
+
+//==============================================================================
+BatchRenderQueue::Config BatchRenderQueue::Config::fromManager(BufferProcessingManager& bpm)
+{
+    Config config;
+    config.processor = bpm.getActiveProcessor();
+    config.blockSize = bpm.getBlockSize();
+
+    auto* active = bpm.getSwapper().getActiveProcessor();
+    if (auto* gain = dynamic_cast<GainProcessor*>(active))
+        config.parameterXml = gain->getAPVTS().copyState().toXmlString();
+    else if (auto* shifter = dynamic_cast<GrainShifterProcessor*>(active))
+        config.parameterXml = shifter->getAPVTS().copyState().toXmlString();
+
+    return config;
+}
+
+void BatchRenderQueue::Config::applyTo(BufferProcessingManager& bpm) const
+{
+    bpm.setActiveProcessor(processor);
+    bpm.setBlockSize(blockSize);
+
+    if (parameterXml.isEmpty())
+        return;
+
+    auto xml = juce::parseXML(parameterXml);
+    if (xml == nullptr)
+        return;
+
+    auto state = juce::ValueTree::fromXml(*xml);
+    auto* node = bpm.getSwapper().getProcessorByIndex(processor);
+
+    if (auto* gain = dynamic_cast<GainProcessor*>(node))
+    {
+        if (state.hasType(gain->getAPVTS().state.getType()))
+            gain->getAPVTS().replaceState(state);
+    }
+    else if (auto* shifter = dynamic_cast<GrainShifterProcessor*>(node))
+    {
+        if (state.hasType(shifter->getAPVTS().state.getType()))
+            shifter->getAPVTS().replaceState(state);
+    }
+}
+
+//==============================================================================
+juce::Array<juce::File> BatchRenderQueue::resolveOutputFiles(const juce::Array<juce::File>& inputFiles,
+                                                             const juce::File&              outputDirectory)
+{
+    juce::Array<juce::File> outputs;
+    juce::StringArray       usedNames;
+
+    for (const auto& input : inputFiles)
+    {
+        const auto stem = input.getFileNameWithoutExtension();
+        auto name = stem;
+        for (int suffix = 2; usedNames.contains(name, true); ++suffix)
+            name = stem + "_" + juce::String(suffix);
+        usedNames.add(name);
+
+        outputs.add(outputDirectory.getChildFile(name + ".wav"));
+    }
+
+    return outputs;
+}
+
+//==============================================================================
+BatchRenderQueue::BatchRenderQueue(int numWorkers)
+    : mNumWorkers(numWorkers > 0 ? numWorkers : juce::jmax(1, juce::SystemStats::getNumCpus()))
+{
+}
+
+BatchRenderQueue::~BatchRenderQueue()
+{
+    stop();
+}
+
+//==============================================================================
+int BatchRenderQueue::addFile(const juce::File& inputFile)
+{
+    jassert(! isRunning());
+    if (isRunning())
+        return -1;
+
+    auto job = std::make_unique<Job>();
+    job->inputFile = inputFile;
+    mJobs.push_back(std::move(job));
+    return getNumJobs() - 1;
+}
+
+int BatchRenderQueue::addFiles(const juce::Array<juce::File>& inputFiles)
+{
+    int added = 0;
+    for (const auto& file : inputFiles)
+        if (addFile(file) >= 0)
+            ++added;
+    return added;
+}
+
+int BatchRenderQueue::addFolder(const juce::File& folder, bool recursive)
+{
+    auto files = folder.findChildFiles(juce::File::findFiles, recursive, "*.wav");
+    files.sort();
+    return addFiles(files);
+}
+
+void BatchRenderQueue::clearJobs()
+{
+    jassert(! isRunning());
+    if (! isRunning())
+        mJobs.clear();
+}
+
+//==============================================================================
+bool BatchRenderQueue::start(const juce::File& outputDirectory, const Config& config)
+{
+    mLastError.clear();
+
+    if (isRunning())
+    {
+        mLastError = "Batch already running";
+        return false;
+    }
+    if (mJobs.empty())
+    {
+        mLastError = "No jobs queued";
+        return false;
+    }
+    if (outputDirectory.getFullPathName().isEmpty() || outputDirectory.createDirectory().failed())
+    {
+        mLastError = "Failed to create output directory: " + outputDirectory.getFullPathName();
+        return false;
+    }
+
+    // Resolve output names up front so workers never race on them.
+    juce::Array<juce::File> inputs;
+    for (const auto& job : mJobs)
+        inputs.add(job->inputFile);
+
+    const auto outputs = resolveOutputFiles(inputs, outputDirectory);
+
+    for (size_t i = 0; i < mJobs.size(); ++i)
+    {
+        auto& job = mJobs[i];
+        job->outputFile    = outputs[static_cast<int>(i)];
+        job->error.clear();
+        job->renderSeconds = 0.0;
+        job->workerIndex   = -1;
+        job->progress.store(0.0f);
+        job->state.store(JobState::kPending);
+    }
+
+    // Contexts are built and configured here, on the calling thread, and kept
+    // for the next batch so their pools' capacity is reused.
+    const int numWorkers = juce::jmin(mNumWorkers, getNumJobs());
+    while (static_cast<int>(mContexts.size()) < numWorkers)
+        mContexts.push_back(std::make_unique<Context>());
+
+    for (int i = 0; i < numWorkers; ++i)
+        _applyConfig(*mContexts[static_cast<size_t>(i)], config);
+
+    mNumFinished.store(0);
+    mElapsedSeconds.store(0.0);
+    mControl.reset();
+    mAllDone.reset();
+    mStartMs = juce::Time::getMillisecondCounterHiRes();
+
+    mNumActiveWorkers.store(numWorkers);
+    mPool.start(numWorkers, getNumJobs(),
+                [this](int workerIndex, int jobIndex) { _runJob(*mContexts[static_cast<size_t>(workerIndex)], workerIndex, jobIndex); },
+                [this](int) { _onWorkerExit(); });
+
+    return true;
+}
+
+bool BatchRenderQueue::waitForCompletion(int timeoutMs)
+{
+    if (! isRunning())
+        return true;
+
+    return mAllDone.wait(timeoutMs);
+}
+
+void BatchRenderQueue::stop()
+{
+    mControl.cancel();
+
+    // Running jobs unwind at their next block; workers then drain the pending
+    // ones as cancelled without rendering them, so every job ends in a final state.
+    mPool.join();
+}
+
+//==============================================================================
+void BatchRenderQueue::_applyConfig(Context& context, const Config& config)
+{
+    config.applyTo(context.bpm);
+    context.renderer.setRenderMode(config.renderMode);
+    context.renderer.setWriterOptions(config.writerOptions);
+}
+
+void BatchRenderQueue::_runJob(Context& context, int workerIndex, int jobIndex)
+{
+    auto& job = *mJobs[static_cast<size_t>(jobIndex)];
+    job.workerIndex = workerIndex;
+
+    if (mControl.isCancelled())
+    {
+        job.error = "Cancelled";
+        job.state.store(JobState::kCancelled);
+    }
+    else
+    {
+        job.state.store(JobState::kRunning);
+
+        auto progress = [&job](float p) { job.progress.store(p); };
+
+        const double startMs = juce::Time::getMillisecondCounterHiRes();
+        const bool   ok      = context.renderer.render(job.inputFile, job.outputFile, progress, &mControl);
+        job.renderSeconds    = (juce::Time::getMillisecondCounterHiRes() - startMs) * 0.001;
+
+        if (ok)
+        {
+            job.progress.store(1.0f);
+            job.state.store(JobState::kSucceeded);
+        }
+        else
+        {
+            const bool cancelled = mControl.isCancelled();
+            job.error = cancelled ? juce::String("Cancelled") : context.renderer.getLastError();
+            job.state.store(cancelled ? JobState::kCancelled : JobState::kFailed);
+        }
+
+        // Capacity stays in the worker's pool for its next job.
+        context.renderer.releaseStorage();
+    }
+
+    mNumFinished.fetch_add(1);
+
+    if (mJobFinishedCallback)
+        mJobFinishedCallback(jobIndex);
+}
+
+void BatchRenderQueue::_onWorkerExit()
+{
+    if (mNumActiveWorkers.fetch_sub(1) == 1)
+    {
+        mElapsedSeconds.store((juce::Time::getMillisecondCounterHiRes() - mStartMs) * 0.001);
+        mAllDone.signal();
+    }
+}
+
+//==============================================================================
+float BatchRenderQueue::getJobProgress(int jobIndex) const
+{
+    if (! juce::isPositiveAndBelow(jobIndex, getNumJobs()))
+        return 0.0f;
+
+    return mJobs[static_cast<size_t>(jobIndex)]->progress.load();
+}
+
+BatchRenderQueue::JobState BatchRenderQueue::getJobState(int jobIndex) const
+{
+    if (! juce::isPositiveAndBelow(jobIndex, getNumJobs()))
+        return JobState::kPending;
+
+    return mJobs[static_cast<size_t>(jobIndex)]->state.load();
+}
+
+BatchRenderQueue::JobResult BatchRenderQueue::getJobResult(int jobIndex) const
+{
+    JobResult result;
+    if (! juce::isPositiveAndBelow(jobIndex, getNumJobs()))
+        return result;
+
+    const auto& job = *mJobs[static_cast<size_t>(jobIndex)];
+
+    // state is stored last by the worker, so a finished state publishes the rest.
+    result.state      = job.state.load();
+    result.inputFile  = job.inputFile;
+    result.outputFile = job.outputFile;
+
+    if (result.state != JobState::kPending)
+        result.workerIndex = job.workerIndex;
+
+    if (result.state != JobState::kPending && result.state != JobState::kRunning)
+    {
+        result.error         = job.error;
+        result.renderSeconds = job.renderSeconds;
+    }
+
+    return result;
+}
+
+float BatchRenderQueue::getOverallProgress() const
+{
+    if (mJobs.empty())
+        return 0.0f;
+
+    float sum = 0.0f;
+    for (const auto& job : mJobs)
+        sum += job->progress.load();
+
+    return sum / static_cast<float>(mJobs.size());
+}
+
+int BatchRenderQueue::getNumSucceeded() const
+{
+    int count = 0;
+    for (const auto& job : mJobs)
+        if (job->state.load() == JobState::kSucceeded)
+            ++count;
+    return count;
+}
+
+int BatchRenderQueue::getNumFailed() const
+{
+    int count = 0;
+    for (const auto& job : mJobs)
+        if (job->state.load() == JobState::kFailed)
+            ++count;
+    return count;
+}
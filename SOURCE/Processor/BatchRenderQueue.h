@@ -0,0 +1,172 @@
+#pragma once
+
+#include "Util/Juce_Header.h"
+#include "Util/RenderControl.h"
+#include "Util/JobPool.h"
+#include "Processor/BufferProcessingManager.h"
+#include "Processor/OfflineRenderer.h"
+#include <atomic>
+#include <functional>
+
+/**
+ * @brief Renders a list of input files concurrently on a worker pool.
+ *
+ * Each worker owns a complete render context — BufferProcessingManager (so
+ * its own processor instances), StoragePool and OfflineRenderer — configured
+ * from the same Config before any job starts. Workers pull the next pending
+ * job from a shared index, so independent files spread across cores and a
+ * long file never holds up the rest of the batch.
+ *
+ * Outputs land in the output directory as <input name>.wav (suffixed _2, _3...
+ * when two inputs share a name). A shared RenderControl cancels or pauses
+ * every running job at its next block boundary.
+ *
+ * Jobs are added while the queue is idle; start() returns immediately.
+ */
+class BatchRenderQueue
+{
+public:
+    /** Processor setup applied to every worker: which processor, and its APVTS state. */
+    struct Config
+    {
+        ActiveProcessor             processor    = ActiveProcessor::kGain;
+        juce::String                parameterXml;                                  // empty = processor defaults
+        OfflineRenderer::RenderMode renderMode   = OfflineRenderer::RenderMode::kBuffered;
+        AsyncWavWriter::Options     writerOptions;
+        int                         blockSize    = 512;
+
+        /** Snapshot of bpm's active processor, parameters and block size. */
+        static Config fromManager(BufferProcessingManager& bpm);
+
+        /** Selects processor on bpm, sets its block size and restores parameterXml. */
+        void applyTo(BufferProcessingManager& bpm) const;
+    };
+
+    enum class JobState
+    {
+        kPending = 0,
+        kRunning,
+        kSucceeded,
+        kFailed,
+        kCancelled
+    };
+
+    struct JobResult
+    {
+        juce::File   inputFile;
+        juce::File   outputFile;
+        JobState     state          = JobState::kPending;
+        juce::String error;
+        double       renderSeconds  = 0.0;
+        int          workerIndex    = -1;
+    };
+
+    /**
+     * Output file for each input: <stem>.wav in outputDirectory, suffixed _2,
+     * _3... when stems repeat (case-insensitively). Shared with the CLI so both
+     * name a batch the same way.
+     */
+    static juce::Array<juce::File> resolveOutputFiles(const juce::Array<juce::File>& inputFiles,
+                                                      const juce::File&              outputDirectory);
+
+    /** numWorkers <= 0 sizes the pool to the machine's CPU cores. */
+    explicit BatchRenderQueue(int numWorkers = 0);
+    ~BatchRenderQueue();
+
+    //==============================================================================
+    // Job list (only while idle)
+    int  addFile(const juce::File& inputFile);
+    int  addFiles(const juce::Array<juce::File>& inputFiles);
+
+    /** Adds every .wav in folder (sorted by name); returns the number added. */
+    int  addFolder(const juce::File& folder, bool recursive = false);
+
+    void clearJobs();
+    int  getNumJobs() const { return static_cast<int>(mJobs.size()); }
+
+    //==============================================================================
+    /**
+     * Validates the output directory, builds one render context per worker
+     * from config and starts the pool. Returns false (see getLastError()) if
+     * the queue is already running, empty, or the directory can't be created.
+     */
+    bool start(const juce::File& outputDirectory, const Config& config);
+
+    /** Blocks until every job has finished; returns false on timeout. */
+    bool waitForCompletion(int timeoutMs = -1);
+
+    void cancel() { mControl.cancel(); }
+    void pause()  { mControl.pause(); }
+    void resume() { mControl.resume(); }
+
+    /** Cancels and joins the pool. */
+    void stop();
+
+    bool isRunning() const { return mNumActiveWorkers.load() > 0; }
+
+    //==============================================================================
+    // Progress / results. Safe to poll from the message thread while running.
+    int      getNumWorkers() const { return mNumWorkers; }
+    float    getJobProgress(int jobIndex) const;
+    JobState getJobState(int jobIndex) const;
+
+    /** Complete once getJobState() is no longer pending/running. */
+    JobResult getJobResult(int jobIndex) const;
+
+    /** Mean of per-job progress, 0 -> 1. */
+    float getOverallProgress() const;
+
+    int getNumFinished()  const { return mNumFinished.load(); }
+    int getNumSucceeded() const;
+    int getNumFailed()    const;
+
+    /** Wall time of the last start() -> all jobs finished. */
+    double getElapsedSeconds() const { return mElapsedSeconds.load(); }
+
+    /** Called from a worker thread as each job finishes. */
+    void setJobFinishedCallback(std::function<void(int jobIndex)> cb) { mJobFinishedCallback = std::move(cb); }
+
+    juce::String getLastError() const { return mLastError; }
+
+private:
+    struct Job
+    {
+        juce::File            inputFile;
+        juce::File            outputFile;
+        std::atomic<float>    progress { 0.0f };
+        std::atomic<JobState> state    { JobState::kPending };
+        juce::String          error;
+        double                renderSeconds = 0.0;
+        int                   workerIndex   = -1;
+    };
+
+    // One per worker; declaration order keeps leases returned before the pool dies.
+    struct Context
+    {
+        BufferProcessingManager bpm;
+        StoragePool             pool;
+        OfflineRenderer         renderer { bpm, pool };
+    };
+
+    void _applyConfig(Context& context, const Config& config);
+    void _runJob(Context& context, int workerIndex, int jobIndex);
+    void _onWorkerExit();
+
+    const int mNumWorkers;
+
+    std::vector<std::unique_ptr<Job>>     mJobs;
+    std::vector<std::unique_ptr<Context>> mContexts;
+    JobPool                               mPool { "BatchRender Worker" };
+
+    std::atomic<int>    mNumFinished      { 0 };
+    std::atomic<int>    mNumActiveWorkers { 0 };
+    std::atomic<double> mElapsedSeconds   { 0.0 };
+    double              mStartMs          = 0.0;
+    juce::WaitableEvent mAllDone          { true };
+
+    RenderControl mControl;
+    std::function<void(int)> mJobFinishedCallback;
+    juce::String  mLastError;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BatchRenderQueue)
+};
@@ -0,0 +1,200 @@
+#include "Processor/BlockSizeAutoTuner.h"
+#include "Processor/BufferProcessingManager.h"
+
+namespace
+{
+    juce::CriticalSection& getDefaultCacheLock()
+    {
+        static juce::CriticalSection lock;
+        return lock;
+    }
+
+    juce::File& getDefaultCacheOverride()
+    {
+        static juce::File file;
+        return file;
+    }
+}
+
+BlockSizeAutoTuner::BlockSizeAutoTuner()
+    : mCacheFile(getDefaultCacheFile())
+{
+}
+
+BlockSizeAutoTuner::~BlockSizeAutoTuner() {}
+
+//==============================================================================
+juce::File BlockSizeAutoTuner::getDefaultCacheFile()
+{
+    {
+        const juce::ScopedLock sl(getDefaultCacheLock());
+        if (getDefaultCacheOverride() != juce::File())
+            return getDefaultCacheOverride();
+    }
+
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile("AudioFileTransformer")
+               .getChildFile("BlockSizeCache.xml");
+}
+
+void BlockSizeAutoTuner::setDefaultCacheFile(const juce::File& file)
+{
+    const juce::ScopedLock sl(getDefaultCacheLock());
+    getDefaultCacheOverride() = file;
+}
+
+void BlockSizeAutoTuner::setCacheFile(const juce::File& file)
+{
+    const juce::ScopedLock sl(mLock);
+    mCacheFile   = file;
+    mCacheLoaded = false;
+    mCache.clear();
+}
+
+void BlockSizeAutoTuner::clearCache()
+{
+    const juce::ScopedLock sl(mLock);
+    mCache.clear();
+    mCacheLoaded = true;
+    _saveCache();
+}
+
+int BlockSizeAutoTuner::getCachedBlockSize(const juce::String& processorName, double sampleRate, int numChannels) const
+{
+    const juce::ScopedLock sl(mLock);
+    _ensureCacheLoaded();
+    auto it = mCache.find(_makeKey(processorName, sampleRate, numChannels));
+    return it != mCache.end() ? it->second : 0;
+}
+
+//==============================================================================
+int BlockSizeAutoTuner::getBlockSize(BufferProcessingManager&        bpm,
+                                     const juce::AudioBuffer<float>& input,
+                                     int    inputSampleCount,
+                                     double sampleRate)
+{
+    auto* active = bpm.getSwapper().getActiveProcessor();
+    const juce::String processorName = active ? active->getName() : juce::String("None");
+
+    if (const int cached = getCachedBlockSize(processorName, sampleRate, input.getNumChannels()); cached > 0)
+        return cached;
+
+    return tune(bpm, input, inputSampleCount, sampleRate);
+}
+
+int BlockSizeAutoTuner::tune(BufferProcessingManager&        bpm,
+                             const juce::AudioBuffer<float>& input,
+                             int    inputSampleCount,
+                             double sampleRate)
+{
+    auto& swapper = bpm.getSwapper();
+    auto* active  = swapper.getActiveProcessor();
+    const juce::String processorName = active ? active->getName() : juce::String("None");
+
+    const int numChannels  = input.getNumChannels();
+    const int probeSamples = juce::jmin(inputSampleCount, static_cast<int>(kProbeSeconds * sampleRate));
+    if (numChannels == 0 || probeSamples <= 0 || sampleRate <= 0.0)
+        return bpm.getBlockSize();
+
+    // Scratch copies: the probe must never touch caller storage.
+    juce::AudioBuffer<float> probeInput (numChannels, probeSamples);
+    juce::AudioBuffer<float> probeOutput(numChannels, probeSamples);
+    for (int ch = 0; ch < numChannels; ++ch)
+        probeInput.copyFrom(ch, 0, input, ch, 0, probeSamples);
+
+    // Probes must not append to per-block CSVs or the binary block log.
+    const bool wasBlockLogging = swapper.getIsBlockLogging();
+    if (wasBlockLogging)
+        swapper.setIsBlockLogging(false);
+
+    const bool wasBlockLogSuspended = bpm.isBlockLogSuspended();
+    bpm.setBlockLogSuspended(true);
+
+    int    bestBlockSize = bpm.getBlockSize();
+    double bestSeconds   = std::numeric_limits<double>::max();
+
+    for (int blockSize = kMinBlockSize; blockSize <= kMaxBlockSize; blockSize <<= 1)
+    {
+        double fastest = std::numeric_limits<double>::max();
+
+        for (int repeat = 0; repeat < kProbeRepeats; ++repeat)
+        {
+            probeOutput.clear();
+            const auto start = juce::Time::getHighResolutionTicks();
+            const bool ok = bpm.processBuffers(probeInput, probeOutput,
+                                               probeSamples, probeSamples,
+                                               sampleRate, blockSize);
+            const auto end = juce::Time::getHighResolutionTicks();
+            if (! ok)
+                break;
+
+            fastest = juce::jmin(fastest, juce::Time::highResolutionTicksToSeconds(end - start));
+        }
+
+        if (fastest < bestSeconds)
+        {
+            bestSeconds   = fastest;
+            bestBlockSize = blockSize;
+        }
+    }
+
+    if (wasBlockLogging)
+        swapper.setIsBlockLogging(true);
+
+    bpm.setBlockLogSuspended(wasBlockLogSuspended);
+
+    {
+        const juce::ScopedLock sl(mLock);
+        _ensureCacheLoaded();   // merge with what is on disk rather than overwrite it
+        mCache[_makeKey(processorName, sampleRate, numChannels)] = bestBlockSize;
+        _saveCache();
+    }
+
+    return bestBlockSize;
+}
+
+//==============================================================================
+juce::String BlockSizeAutoTuner::_makeKey(const juce::String& processorName, double sampleRate, int numChannels)
+{
+    return processorName + "|" + juce::String(juce::roundToInt(sampleRate)) + "|" + juce::String(numChannels);
+}
+
+void BlockSizeAutoTuner::_ensureCacheLoaded() const
+{
+    if (mCacheLoaded)
+        return;
+
+    mCacheLoaded = true;
+    mCache.clear();
+
+    if (! mCacheFile.existsAsFile())
+        return;
+
+    auto xml = juce::XmlDocument::parse(mCacheFile);
+    if (xml == nullptr || ! xml->hasTagName("BlockSizeCache"))
+        return;
+
+    for (auto* entry : xml->getChildWithTagNameIterator("Entry"))
+    {
+        const int blockSize = entry->getIntAttribute("blockSize");
+        if (blockSize >= kMinBlockSize && blockSize <= kMaxBlockSize)
+            mCache[entry->getStringAttribute("key")] = blockSize;
+    }
+}
+
+void BlockSizeAutoTuner::_saveCache() const
+{
+    if (mCacheFile == juce::File())
+        return;
+
+    juce::XmlElement xml("BlockSizeCache");
+    for (const auto& [key, blockSize] : mCache)
+    {
+        auto* entry = xml.createNewChildElement("Entry");
+        entry->setAttribute("key", key);
+        entry->setAttribute("blockSize", blockSize);
+    }
+
+    mCacheFile.getParentDirectory().createDirectory();
+    xml.writeTo(mCacheFile);
+}
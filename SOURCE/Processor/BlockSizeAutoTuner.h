@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Util/Juce_Header.h"
+#include <map>
+
+class BufferProcessingManager;
+
+/**
+ * @brief Picks the fastest offline block size for the active processor.
+ *
+ * Renders a short probe segment of the loaded input through the
+ * BufferProcessingManager at every power-of-two block size in
+ * [kMinBlockSize, kMaxBlockSize], times each pass, and keeps the fastest.
+ * Results are cached per processor name / sample rate / channel count and
+ * persisted to an XML file so later renders skip the probe entirely. The file
+ * is read on the first lookup, not on construction, so a BufferProcessingManager
+ * that never autotunes never touches it.
+ *
+ * Probes render into scratch buffers, and processBuffers() re-prepares the
+ * swapper on every call, so the real render always starts from a clean state.
+ * Block-size invariant processors (e.g. Gain) therefore produce identical
+ * audio with or without autotuning.
+ */
+class BlockSizeAutoTuner
+{
+public:
+    BlockSizeAutoTuner();
+    ~BlockSizeAutoTuner();
+
+    static constexpr int    kMinBlockSize = 64;
+    static constexpr int    kMaxBlockSize = 16384;
+    static constexpr double kProbeSeconds = 2.0;
+    static constexpr int    kProbeRepeats = 2;
+
+    //==============================================================================
+    // Persistence. Defaults to <userAppData>/AudioFileTransformer/BlockSizeCache.xml.
+    void       setCacheFile(const juce::File& file);
+    juce::File getCacheFile() const { return mCacheFile; }
+    static juce::File getDefaultCacheFile();
+
+    /** Redirects getDefaultCacheFile() for tuners constructed afterwards (tests, tools). Empty restores it. */
+    static void setDefaultCacheFile(const juce::File& file);
+
+    //==============================================================================
+    /** Returns the cached block size for the active processor, probing first on a cache miss. */
+    int getBlockSize(BufferProcessingManager&        bpm,
+                     const juce::AudioBuffer<float>& input,
+                     int    inputSampleCount,
+                     double sampleRate);
+
+    /** Always probes, stores and persists the winner, and returns it. */
+    int tune(BufferProcessingManager&        bpm,
+             const juce::AudioBuffer<float>& input,
+             int    inputSampleCount,
+             double sampleRate);
+
+    /** Returns 0 when no entry exists for this processor / rate / channel count. */
+    int  getCachedBlockSize(const juce::String& processorName, double sampleRate, int numChannels) const;
+    void clearCache();
+
+private:
+    static juce::String _makeKey(const juce::String& processorName, double sampleRate, int numChannels);
+    void _ensureCacheLoaded() const;
+    void _saveCache() const;
+
+    juce::File                           mCacheFile;
+    mutable std::map<juce::String, int>  mCache;
+    mutable bool                         mCacheLoaded = false;
+    juce::CriticalSection                mLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BlockSizeAutoTuner)
+};
@@ -1,8 +1,14 @@
 #include "Processor/BufferProcessingManager.h"
 #include "PROCESSORS/BASE/RD_Processor.h"
+#include "Util/RenderControl.h"
+#include "Util/RenderTrace.h"
+#include <chrono>
 
 BufferProcessingManager::BufferProcessingManager()
 {
+    for (int i = 0; i < 2 * mSwapper.getNumProcessors(); ++i)
+        mBlockLatency.push_back(std::make_unique<LatencyHistogram>());
+
     _refreshActiveLoggerChild();
 }
 
@@ -27,7 +33,12 @@ void BufferProcessingManager::_refreshActiveLoggerChild()
         // Mirror swapper's logging state onto the freshly-active child so per-block
         // CSVs fire when a swap happens after logging has been enabled.
         active->setIsLogging (mSwapper.getIsLogging());
+       #if AFT_BLOCK_LOGGING
         active->setIsBlockLogging (mSwapper.getIsBlockLogging());
+       #else
+        // Compiled out: keep RD's per-block hooks on their early-out branch.
+        active->setIsBlockLogging (false);
+       #endif
     }
 }
 
@@ -44,7 +55,104 @@ void BufferProcessingManager::releaseResources()
 
 void BufferProcessingManager::processSingleBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiBuffer)
 {
+    _processTimedBlock(buffer, midiBuffer, BlockPath::kOffline);
+}
+
+void BufferProcessingManager::_processTimedBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiBuffer, BlockPath path)
+{
+    // The audio callback never registers with RenderTrace, so live blocks only count a drop.
+    AFT_TRACE_SCOPE("processBlock", "dsp");
+
+    // Sampled before the call: a processor swap mid-block lands on the outgoing one.
+    const auto processor  = mSwapper.getActiveProcessorIndex();
+    auto&      histogram  = _getBlockLatency(processor, path);
+
+   #if AFT_BLOCK_LOGGING
+    const bool logging    = mBlockLogger.isOpen() && ! mBlockLogSuspended.load(std::memory_order_relaxed);
+    const bool waitIfFull = path == BlockPath::kOffline;
+
+    if (logging)
+        mBlockLogger.logBlock(BinaryBlockLogger::Stage::kInput, static_cast<int>(processor), buffer, waitIfFull);
+   #endif
+
+    const auto start = std::chrono::steady_clock::now();
     mSwapper.processBlock(buffer, midiBuffer);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    histogram.record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+   #if AFT_BLOCK_LOGGING
+    if (logging)
+        mBlockLogger.logBlock(BinaryBlockLogger::Stage::kOutput, static_cast<int>(processor), buffer, waitIfFull);
+   #endif
+}
+
+//==============================================================================
+void BufferProcessingManager::prepareRealtime(double sampleRate, int samplesPerBlock)
+{
+    const juce::ScopedLock lock(mPrepareLock);
+
+    mRealtimeSampleRate = sampleRate;
+    mRealtimeBlockSize.store(juce::jmax(1, samplesPerBlock));
+
+    for (int i = 0; i < mSwapper.getNumProcessors(); ++i)
+        resetBlockLatency(static_cast<ActiveProcessor>(i), BlockPath::kRealtime);
+
+    // A render re-prepares with these settings when it lets go.
+    if (mOfflineClaims.load() == 0)
+        mSwapper.prepareToPlay(sampleRate, samplesPerBlock);
+}
+
+void BufferProcessingManager::releaseRealtime()
+{
+    const juce::ScopedLock lock(mPrepareLock);
+
+    mRealtimeBlockSize.store(0);
+
+    if (mOfflineClaims.load() == 0)
+        mSwapper.releaseResources();
+}
+
+bool BufferProcessingManager::processRealtimeBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiBuffer)
+{
+    // Mark the block, then confirm no render holds the swapper; a render
+    // waits for the mark to clear before touching it.
+    mRealtimeInBlock.store(true);
+    if (mOfflineClaims.load() > 0 || mRealtimeBlockSize.load() == 0)
+    {
+        mRealtimeInBlock.store(false);
+        return false;
+    }
+
+    _processTimedBlock(buffer, midiBuffer, BlockPath::kRealtime);
+
+    mRealtimeInBlock.store(false);
+    return true;
+}
+
+BufferProcessingManager::ScopedOfflineUse::ScopedOfflineUse(BufferProcessingManager& bpm)
+    : mBPM(bpm)
+{
+    {
+        const juce::ScopedLock lock(mBPM.mPrepareLock);
+        mBPM.mOfflineClaims.fetch_add(1);
+    }
+
+    // The audio thread holds the swapper for at most one block.
+    while (mBPM.mRealtimeInBlock.load())
+        juce::Thread::sleep(1);
+}
+
+BufferProcessingManager::ScopedOfflineUse::~ScopedOfflineUse()
+{
+    const juce::ScopedLock lock(mBPM.mPrepareLock);
+
+    // The render released the swapper; hand it back prepared for the host.
+    const int blockSize = mBPM.mRealtimeBlockSize.load();
+    if (mBPM.mOfflineClaims.load() == 1 && blockSize > 0)
+        mBPM.mSwapper.prepareToPlay(mBPM.mRealtimeSampleRate, blockSize);
+
+    mBPM.mOfflineClaims.fetch_sub(1);
 }
 
 //==============================================================================
@@ -59,6 +167,37 @@ ActiveProcessor BufferProcessingManager::getActiveProcessor() const
     return mSwapper.getActiveProcessorIndex();
 }
 
+//==============================================================================
+const LatencyHistogram& BufferProcessingManager::getBlockLatency(ActiveProcessor processor, BlockPath path) const
+{
+    return _getBlockLatency(processor, path);
+}
+
+void BufferProcessingManager::resetBlockLatency(ActiveProcessor processor, BlockPath path)
+{
+    _getBlockLatency(processor, path).reset();
+}
+
+LatencyHistogram& BufferProcessingManager::_getBlockLatency(ActiveProcessor processor, BlockPath path) const
+{
+    const int numProcessors = static_cast<int>(mBlockLatency.size()) / 2;
+    const int index         = static_cast<int>(processor);
+    jassert(index >= 0 && index < numProcessors);
+
+    const int slot = static_cast<int>(path) * numProcessors + juce::jlimit(0, numProcessors - 1, index);
+    return *mBlockLatency[static_cast<size_t>(slot)];
+}
+
+int BufferProcessingManager::resolveBlockSize(const juce::AudioBuffer<float>& inputStorage,
+                                              int    inputSampleCount,
+                                              double sampleRate)
+{
+    if (! mAutoTuneBlockSize)
+        return mBlockSize;
+
+    return mAutoTuner.getBlockSize(*this, inputStorage, inputSampleCount, sampleRate);
+}
+
 //==============================================================================
 bool BufferProcessingManager::processBuffers(const juce::AudioBuffer<float>& inputStorage,
                                               juce::AudioBuffer<float>&       outputStorage,
@@ -66,8 +205,11 @@ bool BufferProcessingManager::processBuffers(const juce::AudioBuffer<float>& inp
                                               int    outputSampleCount,
                                               double sampleRate,
                                               int    blockSize,
-                                              std::function<void(float)> progressCallback)
+                                              std::function<void(float)> progressCallback,
+                                              RenderControl* control,
+                                              BlockSink blockSink)
 {
+    AFT_TRACE_SCOPE("processBuffers", "dsp");
     lastError.clear();
 
     if (inputStorage.getNumChannels() == 0 || inputStorage.getNumSamples() == 0)
@@ -95,7 +237,9 @@ bool BufferProcessingManager::processBuffers(const juce::AudioBuffer<float>& inp
         return false;
     }
 
+    const ScopedOfflineUse offlineUse(*this);
     mSwapper.prepareToPlay(sampleRate, blockSize);
+    resetBlockLatency(getActiveProcessor(), BlockPath::kOffline);
 
     const int numChannels = juce::jmin(inputStorage.getNumChannels(), outputStorage.getNumChannels());
     juce::AudioBuffer<float> processBuffer(numChannels, blockSize);
@@ -105,6 +249,13 @@ bool BufferProcessingManager::processBuffers(const juce::AudioBuffer<float>& inp
 
     while (samplesProcessed < outputSampleCount)
     {
+        if (control != nullptr && ! control->checkpoint())
+        {
+            mSwapper.releaseResources();
+            lastError = "Cancelled";
+            return false;
+        }
+
         const int samplesThisBlock = juce::jmin(blockSize, outputSampleCount - samplesProcessed);
 
         processBuffer.clear();
@@ -118,11 +269,18 @@ bool BufferProcessingManager::processBuffers(const juce::AudioBuffer<float>& inp
                 processBuffer.copyFrom(ch, 0, inputStorage, ch, samplesProcessed, inputToCopy);
         }
 
-        mSwapper.processBlock(processBuffer, midiBuffer);
+        processSingleBlock(processBuffer, midiBuffer);
 
         for (int ch = 0; ch < numChannels; ++ch)
             outputStorage.copyFrom(ch, samplesProcessed, processBuffer, ch, 0, samplesThisBlock);
 
+        if (blockSink && ! blockSink(outputStorage, samplesProcessed, samplesThisBlock))
+        {
+            mSwapper.releaseResources();
+            lastError = "Block sink failed";
+            return false;
+        }
+
         samplesProcessed += samplesThisBlock;
 
         if (progressCallback)
@@ -2,6 +2,14 @@
 
 #include "Util/Juce_Header.h"
 #include "PROCESSORS/RD_ProcessorSwapper.h"
+#include "Processor/BlockSizeAutoTuner.h"
+#include "Util/BinaryBlockLogger.h"
+#include "Util/LatencyHistogram.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class RenderControl;
 
 using ActiveProcessor = RD_ProcessorSwapper::ProcessorIndex;
 
@@ -9,6 +17,10 @@ using ActiveProcessor = RD_ProcessorSwapper::ProcessorIndex;
  * Manages buffer processing via an RD_ProcessorSwapper.
  * Handles large audio buffers by parsing them into process blocks,
  * processing through the swapper, and writing results.
+ *
+ * Every processBlock call is timed into a per-processor LatencyHistogram,
+ * kept separately for offline renders and the realtime path. While the
+ * block logger is open, each block's input and output samples go to it too.
  */
 class BufferProcessingManager
 {
@@ -26,27 +38,123 @@ public:
     void setBlockSize(int blockSize) { mBlockSize = blockSize; }
     int  getBlockSize() const        { return mBlockSize; }
 
+    // Offline autotune: when enabled, resolveBlockSize() probes/caches the fastest
+    // block size for the active processor instead of returning mBlockSize.
+    void setAutoTuneBlockSize(bool shouldAutoTune) { mAutoTuneBlockSize = shouldAutoTune; }
+    bool getAutoTuneBlockSize() const              { return mAutoTuneBlockSize; }
+    BlockSizeAutoTuner& getAutoTuner()             { return mAutoTuner; }
+
+    int resolveBlockSize(const juce::AudioBuffer<float>& inputStorage,
+                         int    inputSampleCount,
+                         double sampleRate);
+
     //==============================================================================
+    // Called with each finished region of outputStorage (start, numSamples) so a
+    // consumer such as AsyncWavWriter can overlap with processing. Returning
+    // false aborts processBuffers.
+    using BlockSink = std::function<bool(const juce::AudioBuffer<float>& outputStorage,
+                                         int startSample,
+                                         int numSamples)>;
+
     bool processBuffers(const juce::AudioBuffer<float>& inputStorage,
                         juce::AudioBuffer<float>&       outputStorage,
                         int    inputSampleCount,
                         int    outputSampleCount,
                         double sampleRate,
                         int    blockSize = 512,
-                        std::function<void(float)> progressCallback = nullptr);
+                        std::function<void(float)> progressCallback = nullptr,
+                        RenderControl* control = nullptr,
+                        BlockSink blockSink = nullptr);
 
     void processSingleBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiBuffer);
 
     void prepareToPlay(double sampleRate, int samplesPerBlock);
     void releaseResources();
 
+    //==============================================================================
+    // Live use from the audio thread. The swapper is shared with offline
+    // renders on this manager: each render holds a ScopedOfflineUse, and
+    // processRealtimeBlock() declines while one is held instead of waiting.
+
+    /** Prepares the swapper for the host's rate and block size, or defers that
+     *  to the end of a render in progress. Message thread. */
+    void prepareRealtime(double sampleRate, int samplesPerBlock);
+    void releaseRealtime();
+
+    /**
+     * Runs buffer through processSingleBlock() and returns true, or leaves it
+     * untouched and returns false if not prepared or a render holds the
+     * swapper. Never locks or allocates itself.
+     */
+    bool processRealtimeBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiBuffer);
+
+    /**
+     * Claims the swapper for an offline render: waits for an in-flight
+     * realtime block to finish, and on release re-prepares the swapper for the
+     * host if prepareRealtime() was called. processBuffers() takes one itself.
+     */
+    class ScopedOfflineUse
+    {
+    public:
+        explicit ScopedOfflineUse(BufferProcessingManager& bpm);
+        ~ScopedOfflineUse();
+
+    private:
+        BufferProcessingManager& mBPM;
+        JUCE_DECLARE_NON_COPYABLE(ScopedOfflineUse)
+    };
+
+    //==============================================================================
+    // Per-block processBlock durations. Offline histograms cover the last render
+    // (each processBuffers() call or streaming render resets the active
+    // processor's); realtime ones cover everything since prepareRealtime().
+    enum class BlockPath { kOffline, kRealtime };
+
+    const LatencyHistogram& getBlockLatency(ActiveProcessor processor, BlockPath path = BlockPath::kOffline) const;
+
+    /** Not while that processor/path is processing. */
+    void resetBlockLatency(ActiveProcessor processor, BlockPath path);
+
+    //==============================================================================
+    // Binary per-block sample log, the non-blocking alternative to RD's
+    // setIsBlockLogging(true). OfflineRenderer opens it per render when block
+    // logging is enabled; while open, every block (outside the timed region),
+    // or the subset its setSampling() picks, is logged. Offline renders wait
+    // for ring space, the realtime path drops and counts. Built with
+    // AFT_BLOCK_LOGGING=0 the hooks are compiled out and an open logger
+    // receives nothing.
+    BinaryBlockLogger& getBlockLogger() { return mBlockLogger; }
+
+    // Blocks processed while suspended (BlockSizeAutoTuner probes) are not
+    // part of the render and skip the block log.
+    void setBlockLogSuspended(bool suspended) { mBlockLogSuspended.store(suspended); }
+    bool isBlockLogSuspended() const          { return mBlockLogSuspended.load(); }
+
     juce::String getLastError() const { return lastError; }
 
 private:
     void _refreshActiveLoggerChild();
+    void _processTimedBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiBuffer, BlockPath path);
+    LatencyHistogram& _getBlockLatency(ActiveProcessor processor, BlockPath path) const;
+
+    // Serialises prepare/release between the message thread and render
+    // threads; the audio thread only reads the atomics.
+    juce::CriticalSection mPrepareLock;
+    std::atomic<int>      mOfflineClaims      { 0 };
+    std::atomic<bool>     mRealtimeInBlock    { false };
+    std::atomic<int>      mRealtimeBlockSize  { 0 };   // 0: not prepared for realtime
+    double                mRealtimeSampleRate = 0.0;
 
     RD_ProcessorSwapper mSwapper;
+    BlockSizeAutoTuner  mAutoTuner;
+
+    // [path * numProcessors + processor], allocated up front for the audio thread.
+    std::vector<std::unique_ptr<LatencyHistogram>> mBlockLatency;
+    BinaryBlockLogger                              mBlockLogger;
+    std::atomic<bool>                              mBlockLogSuspended { false };
+
     int          mBlockSize = 512;
+    bool         mAutoTuneBlockSize = false;
     juce::String lastError  = "-";
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BufferProcessingManager)
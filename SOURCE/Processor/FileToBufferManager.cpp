@@ -1,6 +1,8 @@
 #include "Processor/FileToBufferManager.h"
 #include "Processor/BufferProcessingManager.h"
+#include "Processor/OfflineRenderer.h"
 #include "Util/FileUtils.h"
+#include "Util/RenderTrace.h"
 #include "BufferWriter.h"
 #include "PROCESSORS/GAIN/GainProcessor.h"
 #include "PROCESSORS/GRAIN/GrainShifterProcessor.h"
@@ -9,120 +11,110 @@
 class FileToBufferManager::WorkerThread : public juce::Thread
 {
 public:
-    WorkerThread(FileToBufferManager&     owner,
-                 juce::AudioBuffer<float>& inputStorage,
-                 juce::AudioBuffer<float>& outputStorage,
-                 BufferProcessingManager& bpm)
+    WorkerThread(FileToBufferManager& owner, OfflineRenderer& renderer)
         : juce::Thread("FileToBufferManager")
         , mOwner(owner)
-        , mInputStorage(inputStorage)
-        , mOutputStorage(outputStorage)
-        , mBPM(bpm)
+        , mRenderer(renderer)
     {
     }
 
     void run() override
     {
+        AFT_TRACE_THREAD();
+
         struct ScopedFlag
         {
             std::atomic<bool>& flag;
             ~ScopedFlag() { flag.store(false); }
         } scoped { mOwner.mIsProcessing };
 
-        // Phase 1: load (0.0 -> 0.33)
-        double sampleRate    = 0.0;
-        int    samplesRead   = 0;
-        const int maxSamples = mInputStorage.getNumSamples();
-
-        auto loadProgress = [this](float p)
+        // Declared after the flag so the trace is on disk before isProcessing() drops.
+        struct ScopedTrace
         {
+            juce::File file;
+            ~ScopedTrace()
+            {
+                if (file != juce::File())
+                    RenderTrace::stop(file);
+            }
+        } trace;
+
+        if (mOwner.mTraceEnabled && RenderTrace::start())
+            trace.file = mOwner.getTraceFile();
+
+        auto progress = [this](float p)
+        {
+            mOwner.mProgress.store(p);
             if (mOwner.mProgressCallback)
-                mOwner.mProgressCallback(p * 0.33f);
+                mOwner.mProgressCallback(p);
         };
 
-        if (! FileUtils::loadWavIntoBuffer(mOwner.mInputFile,
-                                            mInputStorage,
-                                            maxSamples,
-                                            sampleRate,
-                                            mNumChannelsRead,
-                                            samplesRead,
-                                            loadProgress))
-        {
-            mOwner.mError = "Failed to load WAV: " + mOwner.mInputFile.getFullPathName();
-            mOwner.mSuccess.store(false);
-            return;
-        }
-
-        if (samplesRead <= 0)
+        // Hashing reads the whole input once — far cheaper than any render —
+        // and honours pause/cancel between chunks.
+        juce::String cacheKey;
+        if (auto* cache = mOwner.mRenderCache)
         {
-            mOwner.mError = "No samples read from WAV file";
-            mOwner.mSuccess.store(false);
-            return;
+            AFT_TRACE_SCOPE("cacheLookup", "worker");
+            const auto inputHash = RenderCache::hashFile(mOwner.mInputFile, &mOwner.mControl);
+            if (mOwner.mControl.isCancelled())
+            {
+                fail("Cancelled");
+                return;
+            }
+
+            if (inputHash.isNotEmpty())
+                cacheKey = RenderCache::makeKey(inputHash, mOwner.mCacheSettings);
+
+            if (cacheKey.isNotEmpty() && cache->fetch(cacheKey, mOwner.mResolvedOutputFile))
+            {
+                mOwner.mCacheHit.store(true);
+                progress(1.0f);
+                succeed({});
+                return;
+            }
         }
 
-        // Phase 2: process (0.33 -> 0.66)
-        int    latencySamples = 0;
-        double tailSeconds    = 0.0;
-        if (auto* active = mBPM.getSwapper().getActiveProcessor())
         {
-            latencySamples = active->getLatencySamples();
-            tailSeconds    = active->getTailLengthSeconds();
+            AFT_TRACE_SCOPE("render", "worker");
+            if (! mRenderer.render(mOwner.mInputFile,
+                                   mOwner.mResolvedOutputFile,
+                                   progress,
+                                   &mOwner.mControl))
+            {
+                fail(mRenderer.getLastError());
+                return;
+            }
         }
-        const int tailSamples = static_cast<int>(tailSeconds * sampleRate);
-        const int outputSampleCount = juce::jmin(mOutputStorage.getNumSamples(),
-                                                  samplesRead + latencySamples + tailSamples);
-
-        mOutputStorage.clear();
 
-        auto processProgress = [this](float p)
+        // A failed store only costs a future render.
+        if (cacheKey.isNotEmpty())
         {
-            if (mOwner.mProgressCallback)
-                mOwner.mProgressCallback(0.33f + p * 0.33f);
-        };
-
-        if (! mBPM.processBuffers(mInputStorage,
-                                   mOutputStorage,
-                                   samplesRead,
-                                   outputSampleCount,
-                                   sampleRate,
-                                   512,
-                                   processProgress))
-        {
-            mOwner.mError = "Buffer processing failed: " + mBPM.getLastError();
-            mOwner.mSuccess.store(false);
-            return;
+            AFT_TRACE_SCOPE("cacheStore", "worker");
+            mOwner.mRenderCache->store(cacheKey, mOwner.mResolvedOutputFile);
         }
 
-        // Phase 3: write (0.66 -> 1.0)
-        auto writeProgress = [this](float p)
-        {
-            if (mOwner.mProgressCallback)
-                mOwner.mProgressCallback(0.66f + p * 0.34f);
-        };
-
-        auto result = BufferWriter::writeToWav(mOutputStorage,
-                                               mOwner.mResolvedOutputFile,
-                                               sampleRate,
-                                               outputSampleCount,
-                                               24,
-                                               writeProgress);
-
-        if (result != BufferWriter::Result::kSuccess)
-        {
-            mOwner.mError = "Failed to write WAV: " + mOwner.mResolvedOutputFile.getFullPathName();
-            mOwner.mSuccess.store(false);
-            return;
-        }
+        mOwner.mLastMetrics = mRenderer.getLastMetrics();
+        succeed(mOwner.mLastMetrics.toMarkdown());
+    }
 
+private:
+    // The sidecar is only written once there is an output WAV for it to describe.
+    void succeed(const juce::String& metricsMarkdown)
+    {
+        mOwner.mOutputDirectory.getChildFile("Transformation_Data.md")
+                               .replaceWithText(mOwner.mSidecarMarkdown + metricsMarkdown);
         mOwner.mSuccess.store(true);
     }
 
-private:
-    FileToBufferManager&      mOwner;
-    juce::AudioBuffer<float>& mInputStorage;
-    juce::AudioBuffer<float>& mOutputStorage;
-    BufferProcessingManager&  mBPM;
-    int                       mNumChannelsRead { 0 };
+    // A cancelled job reports "Cancelled" rather than whichever phase noticed it.
+    void fail(const juce::String& error)
+    {
+        mOwner.mError = mOwner.mControl.isCancelled() ? juce::String("Cancelled") : error;
+        mOwner.mSuccess.store(false);
+    }
+
+    FileToBufferManager& mOwner;
+    OfflineRenderer&     mRenderer;
 };
 
 //==============================================================================
@@ -189,16 +181,27 @@ bool FileToBufferManager::writeBufferToFile(juce::AudioBuffer<float>& srcBuffer,
     return true;
 }
 
+double FileToBufferManager::getEstimatedSecondsRemaining() const
+{
+    const float progress = mProgress.load();
+    if (! mIsProcessing.load() || progress <= 0.0f)
+        return -1.0;
+
+    const double elapsed = RenderMetrics::getWallSeconds() - mStartWall.load();
+    return elapsed * (1.0 - progress) / progress;
+}
+
 //==============================================================================
-bool FileToBufferManager::startProcessing(juce::AudioBuffer<float>& inputStorage,
-                                           juce::AudioBuffer<float>& outputStorage,
-                                           BufferProcessingManager&  bufferProcessingManager)
+bool FileToBufferManager::startProcessing(OfflineRenderer& renderer)
 {
     if (mIsProcessing.load())
         return false;
 
     mError.clear();
     mSuccess.store(false);
+    mCacheHit.store(false);
+    mProgress.store(0.0f);
+    mLastMetrics = {};
 
     juce::String validationError;
     if (! FileUtils::validateInputFile(mInputFile, validationError))
@@ -229,8 +232,8 @@ bool FileToBufferManager::startProcessing(juce::AudioBuffer<float>& inputStorage
         return false;
     }
 
-    // Write Transformation_Data.md sidecar
-    auto* activeNode = bufferProcessingManager.getSwapper().getActiveProcessor();
+    // Transformation_Data.md sidecar, written by the worker once the output exists
+    auto* activeNode = renderer.getBufferProcessingManager().getSwapper().getActiveProcessor();
     juce::String processorName = activeNode ? activeNode->getName() : juce::String("None");
     juce::String parameterXml  = "<NoParameters/>";
     if (auto* gain = dynamic_cast<GainProcessor*>(activeNode))
@@ -238,18 +241,29 @@ bool FileToBufferManager::startProcessing(juce::AudioBuffer<float>& inputStorage
     else if (auto* shifter = dynamic_cast<GrainShifterProcessor*>(activeNode))
         parameterXml = shifter->getAPVTS().copyState().toXmlString();
 
-    juce::String md;
-    md << "# Transformation Data\n\n"
-       << "- **DateTime:** " << timestamp << "\n"
-       << "- **Processor:** " << processorName << "\n"
-       << "- **Input File:** " << mInputFile.getFullPathName() << "\n\n"
-       << "## Parameter State\n\n"
-       << "```xml\n" << parameterXml << "\n```\n";
-    runDir.getChildFile("Transformation_Data.md").replaceWithText(md);
-
-    mThread = std::make_unique<WorkerThread>(*this, inputStorage, outputStorage, bufferProcessingManager);
+    mSidecarMarkdown.clear();
+    mSidecarMarkdown << "# Transformation Data\n\n"
+                     << "- **DateTime:** " << timestamp << "\n"
+                     << "- **Processor:** " << processorName << "\n"
+                     << "- **Input File:** " << mInputFile.getFullPathName() << "\n\n"
+                     << "## Parameter State\n\n"
+                     << "```xml\n" << parameterXml << "\n```\n";
+
+    // Cache key material is captured here, on the calling thread, from the same
+    // state the sidecar records.
+    auto& bpm = renderer.getBufferProcessingManager();
+    mCacheSettings.processorName     = processorName;
+    mCacheSettings.parameterXml      = parameterXml;
+    mCacheSettings.blockSize         = bpm.getBlockSize();
+    mCacheSettings.autoTuneBlockSize = bpm.getAutoTuneBlockSize();
+    mCacheSettings.bitDepth          = renderer.getWriterOptions().bitDepth;
+    mCacheSettings.dither            = renderer.getWriterOptions().dither;
+
+    mControl.reset();
+    mThread = std::make_unique<WorkerThread>(*this, renderer);
+    mStartWall.store(RenderMetrics::getWallSeconds());
     mIsProcessing.store(true);
-    mThread->startThread();
+    mThread->startThread(mThreadPriority);
     return true;
 }
 
@@ -257,6 +271,9 @@ void FileToBufferManager::stopProcessing()
 {
     if (mThread != nullptr)
     {
+        // Worker checks mControl once per block, so this join is near-immediate;
+        // the timeout only guards against a wedged processor.
+        mControl.cancel();
         mThread->stopThread(5000);
         mThread.reset();
         mIsProcessing.store(false);
@@ -1,18 +1,33 @@
 #pragma once
 
 #include "Util/Juce_Header.h"
+#include "Util/RenderControl.h"
+#include "Processor/RenderCache.h"
+#include "Processor/RenderMetrics.h"
 #include <atomic>
 #include <functional>
 
-class BufferProcessingManager;
+class OfflineRenderer;
 
 /**
  * @brief Owns offline file I/O for AudioFileTransformer.
  *
  * Holds input file + output directory paths, the progress callback, and the
- * worker thread that loads a WAV into a caller-owned input storage buffer,
- * runs it through the BufferProcessingManager, and writes the resulting
- * output storage buffer back out to a timestamped WAV.
+ * worker thread that drives a caller-owned OfflineRenderer: load the WAV into
+ * pooled storage sized from its header (or stream it block-by-block when the
+ * renderer is in streaming mode), run it through the BufferProcessingManager,
+ * and write the result to a timestamped WAV.
+ *
+ * With a RenderCache attached, the worker first hashes the input and, on a
+ * hit for the same processor / parameters / block size / format, copies the
+ * cached WAV into place instead of rendering. Fresh renders are stored.
+ *
+ * A successful job (fresh render or cache hit) writes Transformation_Data.md
+ * beside the output; a cancelled or failed job writes none. Each fresh
+ * render's per-phase timing, realtime factor and peak storage are kept in
+ * getLastMetrics() and appended to that sidecar.
+ * With tracing enabled the job also records a RenderTrace session and writes
+ * it to trace.json beside the output WAV.
  */
 class FileToBufferManager
 {
@@ -27,6 +42,9 @@ public:
     juce::File getInputFile() const                        { return mInputFile; }
     juce::File getOutputDirectory() const                  { return mOutputDirectory; }
 
+    /** The timestamped WAV of the last job (valid once wasSuccessful()). */
+    juce::File getLastOutputFile() const                   { return mResolvedOutputFile; }
+
     static juce::File getDefaultInputFile();
     static juce::File getDefaultOutputDirectory();
 
@@ -35,8 +53,31 @@ public:
     void         setProgressCallback(std::function<void(float)> cb) { mProgressCallback = std::move(cb); }
     bool         isProcessing()    const { return mIsProcessing.load(); }
     bool         wasSuccessful()   const { return mSuccess.load(); }
+    bool         wasCancelled()    const { return mControl.isCancelled(); }
+    bool         isPaused()        const { return mControl.isPaused(); }
     juce::String getError()        const { return mError; }
 
+    /** True if the last job was served from the render cache. */
+    bool         wasCacheHit()     const { return mCacheHit.load(); }
+
+    /** Progress of the running (or last) job, 0 -> 1. */
+    float        getProgress()     const { return mProgress.load(); }
+
+    /**
+     * Seconds left in the running job, extrapolated from elapsed time and
+     * progress (which is weighted by measured phase cost, so roughly linear in
+     * time). Negative until there is progress to extrapolate from.
+     */
+    double       getEstimatedSecondsRemaining() const;
+
+    /** Timing of the last fresh render; invalid for cache hits and failures. Read once isProcessing() is false. */
+    const RenderMetrics& getLastMetrics() const { return mLastMetrics; }
+
+    //==============================================================================
+    // Render cache (not owned). nullptr disables caching.
+    void         setRenderCache(RenderCache* cache) { mRenderCache = cache; }
+    RenderCache* getRenderCache() const             { return mRenderCache; }
+
     //==============================================================================
     // Synchronous load: input WAV -> destBuffer (uses RD::BufferFiller overload).
     bool loadInputToBuffer(juce::AudioBuffer<float>& destBuffer,
@@ -52,12 +93,28 @@ public:
 
     //==============================================================================
     // Threaded orchestration: load -> process -> write.
-    // Caller passes references to processor-owned storage buffers and the
-    // BufferProcessingManager that drives the DSP. Returns false if validation
-    // fails before the thread starts.
-    bool startProcessing(juce::AudioBuffer<float>& inputStorage,
-                         juce::AudioBuffer<float>& outputStorage,
-                         BufferProcessingManager&  bufferProcessingManager);
+    // Caller passes the processor-owned OfflineRenderer, which holds the
+    // BufferProcessingManager and the storage pool. Returns false if
+    // validation fails before the thread starts.
+    bool startProcessing(OfflineRenderer& renderer);
+
+    // Worker priority for the next job. Lowered while a preview renders so the
+    // preview gets the CPU first.
+    void                   setThreadPriority(juce::Thread::Priority priority) { mThreadPriority = priority; }
+    juce::Thread::Priority getThreadPriority() const                          { return mThreadPriority; }
+
+    // Record a RenderTrace of the next job into getTraceFile() (chrome://tracing
+    // or Perfetto). Skipped if another trace session is already running.
+    void       setTraceEnabled(bool enabled) { mTraceEnabled = enabled; }
+    bool       isTraceEnabled() const        { return mTraceEnabled; }
+    juce::File getTraceFile() const          { return mOutputDirectory.getChildFile("trace.json"); }
+
+    // Cooperative control of the running job. cancelProcessing() returns
+    // immediately; the worker unwinds at its next block boundary and deletes
+    // any partially written output. stopProcessing() cancels and then joins.
+    void cancelProcessing()  { mControl.cancel(); }
+    void pauseProcessing()   { mControl.pause(); }
+    void resumeProcessing()  { mControl.resume(); }
 
     void stopProcessing();
 
@@ -70,9 +127,21 @@ private:
 
     std::function<void(float)> mProgressCallback;
 
-    std::atomic<bool> mIsProcessing { false };
-    std::atomic<bool> mSuccess      { false };
-    juce::String      mError;
+    std::atomic<bool>   mIsProcessing { false };
+    std::atomic<bool>   mSuccess      { false };
+    std::atomic<bool>   mCacheHit     { false };
+    std::atomic<float>  mProgress     { 0.0f };
+    std::atomic<double> mStartWall    { 0.0 };
+    juce::String        mError;
+    juce::String        mSidecarMarkdown;
+    RenderMetrics       mLastMetrics;
+    RenderControl       mControl;
+
+    juce::Thread::Priority mThreadPriority = juce::Thread::Priority::normal;
+    bool                   mTraceEnabled   = false;
+
+    RenderCache*                mRenderCache = nullptr;
+    RenderCache::RenderSettings mCacheSettings;
 
     std::unique_ptr<WorkerThread> mThread;
 
@@ -0,0 +1,303 @@
+#include "Processor/OfflineRenderer.h"
+#include "Processor/BufferProcessingManager.h"
+#include "Util/FileUtils.h"
+
+OfflineRenderer::OfflineRenderer(BufferProcessingManager& bpm, StoragePool& pool)
+    : mBPM(bpm)
+    , mPool(pool)
+{
+}
+
+OfflineRenderer::~OfflineRenderer()
+{
+    releaseStorage();
+}
+
+//==============================================================================
+bool OfflineRenderer::_readRenderLength(const juce::File& inputFile,
+                                        const RenderRange& range,
+                                        double&      sampleRate,
+                                        int&         numChannels,
+                                        RenderRange::Resolved& region,
+                                        juce::int64& outputLength)
+{
+    juce::int64 fileLength = 0;
+    if (! FileUtils::readAudioFileInfo(inputFile, sampleRate, numChannels, fileLength))
+        return false;
+
+    region = range.resolve(sampleRate, fileLength);
+
+    int    latencySamples = 0;
+    double tailSeconds    = 0.0;
+    if (auto* active = mBPM.getSwapper().getActiveProcessor())
+    {
+        latencySamples = active->getLatencySamples();
+        tailSeconds    = active->getTailLengthSeconds();
+    }
+
+    // Pre-roll is processed (and held in storage) ahead of the region.
+    outputLength = region.getReadLength() + latencySamples + static_cast<juce::int64>(tailSeconds * sampleRate);
+    return true;
+}
+
+bool OfflineRenderer::exceedsBufferedLimit(const juce::File& inputFile, const RenderRange& range)
+{
+    double                sampleRate   = 0.0;
+    int                   numChannels  = 0;
+    RenderRange::Resolved region;
+    juce::int64           outputLength = 0;
+
+    return _readRenderLength(inputFile, range, sampleRate, numChannels, region, outputLength)
+        && outputLength > kMaxBufferedSamples;
+}
+
+bool OfflineRenderer::prepareStorage(const juce::File& inputFile, const RenderRange& range)
+{
+    double                sampleRate   = 0.0;
+    int                   numChannels  = 0;
+    RenderRange::Resolved region;
+    juce::int64           outputLength = 0;
+
+    if (! _readRenderLength(inputFile, range, sampleRate, numChannels, region, outputLength))
+    {
+        mLastError = "Failed to read audio header: " + inputFile.getFullPathName();
+        return false;
+    }
+
+    if (region.getLength() <= 0)
+    {
+        mLastError = "Render range is empty";
+        return false;
+    }
+
+    if (outputLength > kMaxBufferedSamples)
+    {
+        mLastError = "Input too long for a buffered render: " + inputFile.getFullPathName();
+        return false;
+    }
+
+    const int storageChannels = juce::jmax(numChannels, kMinStorageChannels);
+
+    // Hand the previous job's buffers back first so their capacity is reused.
+    releaseStorage();
+    mInputLease  = mPool.acquire(storageChannels, static_cast<int>(region.getReadLength()));
+    mOutputLease = mPool.acquire(storageChannels, static_cast<int>(outputLength));
+
+    mRegion            = region;
+    mSampleRate        = sampleRate;
+    mSamplesRead       = 0;
+    mOutputSampleCount = static_cast<int>(outputLength);
+    return true;
+}
+
+void OfflineRenderer::releaseStorage()
+{
+    mInputLease.release();
+    mOutputLease.release();
+}
+
+//==============================================================================
+bool OfflineRenderer::render(const juce::File& inputFile,
+                             const juce::File& outputFile,
+                             std::function<void(float)> progressCallback,
+                             RenderControl* control,
+                             const RenderRange& range)
+{
+    mLastError.clear();
+    mLastMetrics = {};
+
+   #if AFT_BLOCK_LOGGING
+    // Closed on every exit path so the header's counts are always filled in.
+    struct ScopedBlockLog
+    {
+        BinaryBlockLogger* logger = nullptr;
+        ~ScopedBlockLog()
+        {
+            if (logger != nullptr)
+                logger->close();
+        }
+    } blockLog;
+
+    auto& logger = mBPM.getBlockLogger();
+    if (isBlockLogEnabled() && ! logger.isOpen())
+    {
+        if (! logger.open(getBlockLogFile(outputFile)))
+        {
+            mLastError = "Failed to open block log: " + logger.getLastError();
+            return false;
+        }
+        blockLog.logger = &logger;
+    }
+   #endif
+
+    // AudioBuffer indices are int; anything longer streams with 64-bit file positions.
+    if (getRenderMode() == RenderMode::kStreaming || exceedsBufferedLimit(inputFile, range))
+        return _renderStreaming(inputFile, outputFile, std::move(progressCallback), control, range);
+
+    return _renderBuffered(inputFile, outputFile, std::move(progressCallback), control, range);
+}
+
+bool OfflineRenderer::_renderStreaming(const juce::File& inputFile,
+                                       const juce::File& outputFile,
+                                       std::function<void(float)> progressCallback,
+                                       RenderControl* control,
+                                       const RenderRange& range)
+{
+    // Nothing buffered survives a streaming job; hand capacity back to the pool.
+    releaseStorage();
+    mRegion            = {};
+    mSamplesRead       = 0;
+    mOutputSampleCount = 0;
+
+    const bool ok = mPipeline.render(inputFile, outputFile, std::move(progressCallback), control, range);
+
+    mSampleRate = mPipeline.getSampleRate();
+    if (ok)
+        mLastMetrics = mPipeline.getLastMetrics();
+    else
+        mLastError = mPipeline.getLastError();
+
+    return ok;
+}
+
+bool OfflineRenderer::_renderBuffered(const juce::File& inputFile,
+                                      const juce::File& outputFile,
+                                      std::function<void(float)> progressCallback,
+                                      RenderControl* control,
+                                      const RenderRange& range)
+{
+    RenderMetrics metrics;
+    const double startWall = RenderMetrics::getWallSeconds();
+    const double startCpu  = RenderMetrics::getProcessCpuSeconds();
+    const MemoryAccounting::ScopedPeak memoryPeak;
+    double phaseWall = startWall;
+    double phaseCpu  = startCpu;
+
+    // Closes the running phase into phase and starts the next one.
+    auto endPhase = [&phaseWall, &phaseCpu](RenderMetrics::Phase& phase)
+    {
+        const double wall = RenderMetrics::getWallSeconds();
+        const double cpu  = RenderMetrics::getProcessCpuSeconds();
+        phase.wallSeconds = wall - phaseWall;
+        phase.cpuSeconds  = cpu - phaseCpu;
+        phaseWall = wall;
+        phaseCpu  = cpu;
+    };
+
+    if (! prepareStorage(inputFile, range))
+        return false;
+
+    auto& inputStorage  = mInputLease.getBuffer();
+    auto& outputStorage = mOutputLease.getBuffer();
+
+    // Progress spans follow the measured cost of each phase on earlier renders.
+    const auto weights = mPhaseWeights;
+
+    // Phase 1: load
+    auto loadProgress = [progressCallback, weights](float p)
+    {
+        if (progressCallback) progressCallback(p * weights.load);
+    };
+
+    double sampleRate  = 0.0;
+    int    numChannels = 0;
+    int    samplesRead = 0;
+
+    if (! FileUtils::loadWavIntoBuffer(inputFile, inputStorage, inputStorage.getNumSamples(),
+                                        sampleRate, numChannels, samplesRead, loadProgress, control,
+                                        FileUtils::ReadStrategy::kAuto, mRegion.getReadStart()))
+    {
+        mLastError = "Failed to load WAV: " + inputFile.getFullPathName();
+        return false;
+    }
+    if (samplesRead <= 0)
+    {
+        mLastError = "No samples read from WAV file";
+        return false;
+    }
+
+    mSampleRate  = sampleRate;
+    mSamplesRead = samplesRead;
+    endPhase(metrics.load);
+
+    int    latencySamples = 0;
+    double tailSeconds    = 0.0;
+    if (auto* active = mBPM.getSwapper().getActiveProcessor())
+    {
+        latencySamples = active->getLatencySamples();
+        tailSeconds    = active->getTailLengthSeconds();
+    }
+    const int tailSamples = static_cast<int>(tailSeconds * sampleRate);
+    mOutputSampleCount    = juce::jmin(outputStorage.getNumSamples(),
+                                       samplesRead + latencySamples + tailSamples);
+
+    outputStorage.clear();
+
+    // Phase 2: process. Each finished block goes to the async writer, so PCM
+    // conversion and disk I/O overlap with processing.
+    AsyncWavWriter writer;
+    if (! writer.open(outputFile, sampleRate, outputStorage.getNumChannels(), mWriterOptions))
+    {
+        mLastError = "Failed to write WAV: " + outputFile.getFullPathName();
+        return false;
+    }
+
+    auto processProgress = [progressCallback, weights](float p)
+    {
+        if (progressCallback) progressCallback(weights.load + p * weights.process);
+    };
+
+    // Output before the region is pre-roll: processed for state, never written.
+    const int preRoll = static_cast<int>(mRegion.preRoll);
+
+    auto writeBlock = [&writer, preRoll](const juce::AudioBuffer<float>& output, int startSample, int numSamples)
+    {
+        const int skip = juce::jlimit(0, numSamples, preRoll - startSample);
+        return skip == numSamples || writer.write(output, startSample + skip, numSamples - skip);
+    };
+
+    const int blockSize = mBPM.resolveBlockSize(inputStorage, samplesRead, sampleRate);
+
+    if (! mBPM.processBuffers(inputStorage,
+                              outputStorage,
+                              samplesRead,
+                              mOutputSampleCount,
+                              sampleRate,
+                              blockSize,
+                              processProgress,
+                              control,
+                              writeBlock))
+    {
+        const bool writeFailed = writer.hasFailed();
+        writer.abort();
+        mLastError = writeFailed ? "Failed to write WAV: " + outputFile.getFullPathName()
+                                 : "Buffer processing failed: " + mBPM.getLastError();
+        return false;
+    }
+
+    endPhase(metrics.process);
+
+    // Phase 3: write — drain whatever the writer still has queued.
+    if (! writer.close())
+    {
+        mLastError = "Failed to write WAV: " + outputFile.getFullPathName();
+        return false;
+    }
+
+    endPhase(metrics.write);
+    metrics.total.wallSeconds = phaseWall - startWall;
+    metrics.total.cpuSeconds  = phaseCpu - startCpu;
+    metrics.audioSeconds      = static_cast<double>(mOutputSampleCount - preRoll) / sampleRate;
+    metrics.peakStorageBytes  = StoragePool::bytesFor(inputStorage.getNumChannels(), inputStorage.getNumSamples())
+                              + StoragePool::bytesFor(outputStorage.getNumChannels(), outputStorage.getNumSamples());
+    metrics.blockLatency      = mBPM.getBlockLatency(mBPM.getActiveProcessor()).getSummary();
+    metrics.memory            = memoryPeak.getSnapshot();
+
+    mLastMetrics = metrics;
+    mPhaseWeights.update(metrics);
+
+    if (progressCallback)
+        progressCallback(1.0f);
+
+    return true;
+}
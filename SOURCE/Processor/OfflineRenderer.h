@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Util/Juce_Header.h"
+#include "Processor/StoragePool.h"
+#include "Processor/StreamingRenderPipeline.h"
+#include "Processor/RenderRange.h"
+#include "Processor/RenderMetrics.h"
+#include <atomic>
+#include <limits>
+#include <functional>
+
+class BufferProcessingManager;
+class RenderControl;
+
+/**
+ * @brief Offline file render: load WAV -> process -> write WAV.
+ *
+ * Shared by AudioFileTransformerProcessor::transformFile and the
+ * FileToBufferManager worker thread. Two modes:
+ *
+ *  - kBuffered: storage is sized from the input file's header (channels,
+ *    lengthInSamples, plus the active processor's latency and tail) and leased
+ *    from a StoragePool, so memory tracks the actual file and nothing is
+ *    allocated until the first render. The leases are held until the next
+ *    render (or releaseStorage()) so the last result stays inspectable.
+ *  - kStreaming: delegates to StreamingRenderPipeline. Read, process and write
+ *    overlap on three threads and only a small block ring is held; the
+ *    input/output buffers stay empty.
+ *
+ * Both modes accept a RenderRange: the input is read from the region's
+ * pre-roll start (a seek, not a decode from zero) and only the region is written.
+ *
+ * With block logging enabled, each render opens the manager's
+ * BinaryBlockLogger on getBlockLogFile() beside the output WAV and closes it
+ * when the render ends, so every job leaves its own log.
+ */
+class OfflineRenderer
+{
+public:
+    OfflineRenderer(BufferProcessingManager& bpm, StoragePool& pool);
+    ~OfflineRenderer();
+
+    // Mono sources are duplicated across the stereo bus, matching the plugin layout.
+    static constexpr int kMinStorageChannels = 2;
+
+    // A single AudioBuffer is int-indexed; longer jobs always stream.
+    static constexpr juce::int64 kMaxBufferedSamples = std::numeric_limits<int>::max();
+
+    enum class RenderMode
+    {
+        kBuffered = 0,
+        kStreaming
+    };
+
+    void       setRenderMode(RenderMode mode) { mRenderMode.store(mode); }
+    RenderMode getRenderMode() const          { return mRenderMode.load(); }
+
+    /** Output bit depth / TPDF dither / staging depth, for both render modes. */
+    void setWriterOptions(const AsyncWavWriter::Options& options)
+    {
+        mWriterOptions = options;
+        mPipeline.setWriterOptions(options);
+    }
+    const AsyncWavWriter::Options& getWriterOptions() const { return mWriterOptions; }
+
+    /**
+     * Records each render's blocks, as picked by the block logger's
+     * setSampling(), to getBlockLogFile(outputFile). Skipped if the logger is
+     * already open; a no-op when built with AFT_BLOCK_LOGGING=0.
+     */
+    void setBlockLogEnabled(bool enabled) { mBlockLogEnabled.store(enabled); }
+    bool isBlockLogEnabled() const        { return mBlockLogEnabled.load(); }
+
+    static juce::File getBlockLogFile(const juce::File& outputFile) { return outputFile.withFileExtension("aftlog"); }
+
+    //==============================================================================
+    /**
+     * Sizes input/output storage for inputFile (or range of it, pre-roll
+     * included) without reading any samples. Returns false (see getLastError())
+     * if the header cannot be read, the range is empty or the render is longer
+     * than a single AudioBuffer can index.
+     */
+    bool prepareStorage(const juce::File& inputFile, const RenderRange& range = {});
+
+    /**
+     * Full load -> process -> write in the current RenderMode. Inputs beyond
+     * kMaxBufferedSamples stream regardless of mode. Buffered progress is split
+     * across load, process and the writer drain by getPhaseWeights(), which
+     * tracks measured renders; streaming follows the writer.
+     * range limits the render to a region of the input (default: whole file).
+     */
+    bool render(const juce::File& inputFile,
+                const juce::File& outputFile,
+                std::function<void(float)> progressCallback = nullptr,
+                RenderControl* control = nullptr,
+                const RenderRange& range = {});
+
+    /** True if the render's storage (pre-roll + region + latency + tail) will not fit one AudioBuffer. */
+    bool exceedsBufferedLimit(const juce::File& inputFile, const RenderRange& range = {});
+
+    /** Returns storage to the pool; capacity stays in the pool for the next job. */
+    void releaseStorage();
+
+    //==============================================================================
+    // Buffered results. Both buffers start at the pre-roll; the written region
+    // begins getNumPreRollSamples() in.
+    juce::AudioBuffer<float>& getInputBuffer()  { return mInputLease.isValid()  ? mInputLease.getBuffer()  : mEmptyBuffer; }
+    juce::AudioBuffer<float>& getOutputBuffer() { return mOutputLease.isValid() ? mOutputLease.getBuffer() : mEmptyBuffer; }
+
+    double       getSampleRate()          const { return mSampleRate; }
+    int          getNumInputSamples()     const { return mSamplesRead; }
+    int          getNumOutputSamples()    const { return mOutputSampleCount; }
+    int          getNumPreRollSamples()   const { return static_cast<int>(mRegion.preRoll); }
+    juce::String getLastError()           const { return mLastError; }
+
+    /** Timing and storage of the last successful render (invalid after a failure). */
+    const RenderMetrics&      getLastMetrics()  const { return mLastMetrics; }
+    const RenderPhaseWeights& getPhaseWeights() const { return mPhaseWeights; }
+
+    BufferProcessingManager& getBufferProcessingManager() { return mBPM; }
+    StoragePool&             getStoragePool()             { return mPool; }
+    StreamingRenderPipeline& getStreamingPipeline()       { return mPipeline; }
+
+private:
+    bool _readRenderLength(const juce::File& inputFile,
+                           const RenderRange& range,
+                           double&      sampleRate,
+                           int&         numChannels,
+                           RenderRange::Resolved& region,
+                           juce::int64& outputLength);
+
+    bool _renderBuffered(const juce::File& inputFile,
+                         const juce::File& outputFile,
+                         std::function<void(float)> progressCallback,
+                         RenderControl* control,
+                         const RenderRange& range);
+
+    bool _renderStreaming(const juce::File& inputFile,
+                          const juce::File& outputFile,
+                          std::function<void(float)> progressCallback,
+                          RenderControl* control,
+                          const RenderRange& range);
+
+    BufferProcessingManager& mBPM;
+    StoragePool&             mPool;
+    StreamingRenderPipeline  mPipeline { mBPM };
+    AsyncWavWriter::Options  mWriterOptions;
+    std::atomic<RenderMode>  mRenderMode { RenderMode::kBuffered };
+    std::atomic<bool>        mBlockLogEnabled { false };
+
+    StoragePool::Lease       mInputLease;
+    StoragePool::Lease       mOutputLease;
+    juce::AudioBuffer<float> mEmptyBuffer;
+    RenderRange::Resolved    mRegion;
+
+    double       mSampleRate        = 0.0;
+    int          mSamplesRead       = 0;
+    int          mOutputSampleCount = 0;
+    juce::String mLastError;
+
+    RenderMetrics      mLastMetrics;
+    RenderPhaseWeights mPhaseWeights;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderer)
+};
@@ -1,15 +1,11 @@
 #include "Processor/PluginProcessor.h"
 #include "Components/PluginEditor.h"
 #include "Util/FileUtils.h"
-#include "BufferWriter.h"
 
 //==============================================================================
 AudioFileTransformerProcessor::AudioFileTransformerProcessor()
     : RD_Processor()
 {
-    mInputBuffer.clear();
-    mProcessedBuffer.clear();
-
     // Stable outputName — default is construction timestamp, which moves every
     // plugin instantiation. Pin to processor name so the log dir stays predictable.
     setDataLogOutputName (getName());
@@ -97,15 +93,21 @@ void AudioFileTransformerProcessor::changeProgramName(int index, const juce::Str
 //==============================================================================
 void AudioFileTransformerProcessor::doPrepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    mBufferProcessingManager.prepareToPlay(sampleRate, samplesPerBlock);
+    // An offline bounce still arrives in the host's small blocks: regroup them
+    // so the processors run at the accumulator's block size instead.
+    const bool accumulate = isNonRealtime() && samplesPerBlock < BlockAccumulator::kDefaultBlockSize;
+    mBounceAccumulator.prepare(juce::jmax(2, getTotalNumOutputChannels()), samplesPerBlock);
+    mIsAccumulatingBounce.store(accumulate);
+
+    mBufferProcessingManager.prepareRealtime(sampleRate, accumulate ? mBounceAccumulator.getBlockSize() : samplesPerBlock);
+    mAuditionTransport.prepare(sampleRate, samplesPerBlock);
 
-    if (auto* active = mBufferProcessingManager.getSwapper().getActiveProcessor())
-        setLatencySamples(active->getLatencySamples());
+    _updateLatency();
 }
 
 void AudioFileTransformerProcessor::releaseResources()
 {
-    mBufferProcessingManager.releaseResources();
+    mBufferProcessingManager.releaseRealtime();
     RD_Processor::releaseResources();
 }
 
@@ -131,10 +133,45 @@ bool AudioFileTransformerProcessor::isBusesLayoutSupported(const BusesLayout& la
 void AudioFileTransformerProcessor::doProcessBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
-    juce::ignoreUnused(midiMessages);
 
-    // Offline-only plugin: realtime audio path outputs silence.
-    buffer.clear();
+    // Rendered audio plays first: an audition, then a preview. Otherwise live
+    // mode transforms the input in place; silence when offline-only, or while
+    // an offline render holds the processors.
+    if (mAuditionTransport.isPlaying())
+        mAuditionTransport.renderNextBlock(buffer);
+    else if (mPreviewRenderer.isPlaying())
+        mPreviewRenderer.readNextBlock(buffer);
+    else if (! mLiveMode.load())
+        buffer.clear();
+    else if (mIsAccumulatingBounce.load())
+        mBounceAccumulator.process(buffer, [this, &midiMessages](juce::AudioBuffer<float>& block)
+        {
+            if (! mBufferProcessingManager.processRealtimeBlock(block, midiMessages))
+                block.clear();
+        });
+    else if (! mBufferProcessingManager.processRealtimeBlock(buffer, midiMessages))
+        buffer.clear();
+}
+
+void AudioFileTransformerProcessor::setLiveMode(bool shouldBeLive)
+{
+    mLiveMode.store(shouldBeLive);
+    _updateLatency();
+}
+
+void AudioFileTransformerProcessor::_updateLatency()
+{
+    int latencySamples = 0;
+    if (mLiveMode.load())
+    {
+        if (auto* active = mBufferProcessingManager.getSwapper().getActiveProcessor())
+            latencySamples = active->getLatencySamples();
+
+        if (mIsAccumulatingBounce.load())
+            latencySamples += mBounceAccumulator.getLatencySamples();
+    }
+
+    setLatencySamples(latencySamples);
 }
 
 //==============================================================================
@@ -174,6 +211,7 @@ GrainShifterProcessor* AudioFileTransformerProcessor::getGrainShifterNode()
 void AudioFileTransformerProcessor::setActiveProcessor(ActiveProcessor processor)
 {
     mBufferProcessingManager.setActiveProcessor(processor);
+    _updateLatency();
 }
 
 
@@ -185,7 +223,8 @@ ActiveProcessor AudioFileTransformerProcessor::getActiveProcessor() const
 //==============================================================================
 bool AudioFileTransformerProcessor::transformFile (const juce::File& inputFile,
                                                     const juce::File& outputFile,
-                                                    std::function<void(float)> progressCallback)
+                                                    std::function<void(float)> progressCallback,
+                                                    const RenderRange& range)
 {
     
     logData();
@@ -203,77 +242,16 @@ bool AudioFileTransformerProcessor::transformFile (const juce::File& inputFile,
         return false;
     }
 
-    auto loadProgress = [progressCallback] (float p)
-    {
-        if (progressCallback) progressCallback (p * 0.33f);
-    };
-
-    double sampleRate    = 0.0;
-    int    numChannels   = 0;
-    int    samplesRead   = 0;
-    const int maxSamples = mInputBuffer.getNumSamples();
-
-    if (! FileUtils::loadWavIntoBuffer (inputFile, mInputBuffer, maxSamples,
-                                         sampleRate, numChannels, samplesRead, loadProgress))
-    {
-        mLastTransformError = "Failed to load WAV: " + inputFile.getFullPathName();
-        return false;
-    }
-    if (samplesRead <= 0)
-    {
-        mLastTransformError = "No samples read from input";
-        return false;
-    }
-
-    int    latencySamples = 0;
-    double tailSeconds    = 0.0;
-    if (auto* active = mBufferProcessingManager.getSwapper().getActiveProcessor())
-    {
-        latencySamples = active->getLatencySamples();
-        tailSeconds    = active->getTailLengthSeconds();
-    }
-    const int tailSamples       = static_cast<int> (tailSeconds * sampleRate);
-    const int outputSampleCount = juce::jmin (mProcessedBuffer.getNumSamples(),
-                                              samplesRead + latencySamples + tailSamples);
-
-    mProcessedBuffer.clear();
-
     // If logging, cascade once before processing so child loggers sync parent
     // dirs from this processor — required so per-block CSVs nest correctly.
     if (getIsLogging())
         logData();
 
-    auto processProgress = [progressCallback] (float p)
-    {
-        if (progressCallback) progressCallback (0.33f + p * 0.33f);
-    };
-
-    if (! mBufferProcessingManager.processBuffers (mInputBuffer,
-                                                    mProcessedBuffer,
-                                                    samplesRead,
-                                                    outputSampleCount,
-                                                    sampleRate,
-                                                    mBufferProcessingManager.getBlockSize(),
-                                                    processProgress))
-    {
-        mLastTransformError = "Processing failed: " + mBufferProcessingManager.getLastError();
-        return false;
-    }
+    _releaseAuditionBuffer();
 
-    auto writeProgress = [progressCallback] (float p)
+    if (! mOfflineRenderer.render (inputFile, outputFile, std::move (progressCallback), nullptr, range))
     {
-        if (progressCallback) progressCallback (0.66f + p * 0.34f);
-    };
-
-    auto result = BufferWriter::writeToWav (mProcessedBuffer,
-                                            outputFile,
-                                            sampleRate,
-                                            outputSampleCount,
-                                            24,
-                                            writeProgress);
-    if (result != BufferWriter::Result::kSuccess)
-    {
-        mLastTransformError = "Failed to write WAV: " + outputFile.getFullPathName();
+        mLastTransformError = mOfflineRenderer.getLastError();
         return false;
     }
 
@@ -304,6 +282,116 @@ bool AudioFileTransformerProcessor::doFileTransform (std::function<void(float)>
     return transformFile (inputFile, outputFile, std::move (progressCallback));
 }
 
+bool AudioFileTransformerProcessor::startBatchRender (const juce::File& inputFolder, const juce::File& outputDirectory)
+{
+    mLastTransformError.clear();
+
+    if (mBatchRenderQueue.isRunning())
+    {
+        mLastTransformError = "Batch already running";
+        return false;
+    }
+
+    mBatchRenderQueue.clearJobs();
+    if (mBatchRenderQueue.addFolder (inputFolder) == 0)
+    {
+        mLastTransformError = "No WAV files in " + inputFolder.getFullPathName();
+        return false;
+    }
+
+    auto config = BatchRenderQueue::Config::fromManager (mBufferProcessingManager);
+    config.renderMode    = mOfflineRenderer.getRenderMode();
+    config.writerOptions = mOfflineRenderer.getWriterOptions();
+
+    if (! mBatchRenderQueue.start (outputDirectory, config))
+    {
+        mLastTransformError = mBatchRenderQueue.getLastError();
+        return false;
+    }
+
+    return true;
+}
+
+bool AudioFileTransformerProcessor::startPreviewRender (const RenderRange& range)
+{
+    mLastTransformError.clear();
+
+    if (! mPreviewRenderer.start (mFileToBufferManager.getInputFile(),
+                                  BatchRenderQueue::Config::fromManager (mBufferProcessingManager),
+                                  range))
+    {
+        mLastTransformError = mPreviewRenderer.getLastError();
+        return false;
+    }
+
+    return true;
+}
+
+bool AudioFileTransformerProcessor::startFileRender (bool withPreview)
+{
+    // A failed preview is not fatal; the full render still runs, at normal priority.
+    const bool previewStarted = withPreview && startPreviewRender();
+
+    mFileToBufferManager.setThreadPriority (previewStarted ? juce::Thread::Priority::low
+                                                           : juce::Thread::Priority::normal);
+
+    _releaseAuditionBuffer();
+    return mFileToBufferManager.startProcessing (mOfflineRenderer);
+}
+
+//==============================================================================
+bool AudioFileTransformerProcessor::auditionProcessedBuffer()
+{
+    mLastTransformError.clear();
+
+    // Buffered output starts at the region's pre-roll; play only the region.
+    const int preRoll = mOfflineRenderer.getNumPreRollSamples();
+    if (mFileToBufferManager.isProcessing()
+        || ! mAuditionTransport.loadBuffer (mOfflineRenderer.getOutputBuffer(),
+                                            preRoll,
+                                            mOfflineRenderer.getNumOutputSamples() - preRoll,
+                                            mOfflineRenderer.getSampleRate()))
+    {
+        mLastTransformError = "No processed buffer to audition";
+        return false;
+    }
+
+    mPreviewRenderer.stopPlayback();
+    mAuditionTransport.start();
+    return true;
+}
+
+bool AudioFileTransformerProcessor::auditionFile (const juce::File& renderedFile)
+{
+    mLastTransformError.clear();
+
+    if (! mAuditionTransport.loadFile (renderedFile))
+    {
+        mLastTransformError = mAuditionTransport.getLastError();
+        return false;
+    }
+
+    mPreviewRenderer.stopPlayback();
+    mAuditionTransport.start();
+    return true;
+}
+
+bool AudioFileTransformerProcessor::auditionLastRender()
+{
+    // The written file is authoritative: a cache hit never touches the buffer.
+    const auto rendered = mFileToBufferManager.getLastOutputFile();
+    if (! mFileToBufferManager.isProcessing() && mFileToBufferManager.wasSuccessful() && rendered.existsAsFile())
+        return auditionFile (rendered);
+
+    return auditionProcessedBuffer();
+}
+
+void AudioFileTransformerProcessor::_releaseAuditionBuffer()
+{
+    if (mAuditionTransport.hasBufferSource())
+        mAuditionTransport.unload();
+}
+
 //==============================================================================
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 {
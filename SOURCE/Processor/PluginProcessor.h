@@ -1,8 +1,15 @@
 #pragma once
 
 #include "Util/Juce_Header.h"
+#include "Processor/AuditionTransport.h"
+#include "Processor/BatchRenderQueue.h"
 #include "Processor/BufferProcessingManager.h"
 #include "Processor/FileToBufferManager.h"
+#include "Processor/OfflineRenderer.h"
+#include "Processor/PreviewRenderer.h"
+#include "Processor/RenderCache.h"
+#include "Processor/StoragePool.h"
+#include "BlockAccumulator.h"
 #include "PROCESSORS/BASE/RD_Processor.h"
 #include "PROCESSORS/GAIN/GainProcessor.h"
 #include "PROCESSORS/GRAIN/GrainShifterProcessor.h"
@@ -60,12 +67,15 @@ public:
 
     //==============================================================================
     /** End-to-end synchronous file transform: load inputFile -> process -> write outputFile.
-     *  Uses mInputBuffer / mProcessedBuffer storage and the active processor in the swapper.
+     *  Storage is leased from mStoragePool, sized from inputFile's header, and the
+     *  active processor in the swapper does the DSP.
+     *  range renders only a region of inputFile (see RenderRange); default is the whole file.
      *  Returns false on any failure; lastError available via getLastTransformError().
      */
     bool transformFile (const juce::File& inputFile,
                         const juce::File& outputFile,
-                        std::function<void(float)> progressCallback = nullptr);
+                        std::function<void(float)> progressCallback = nullptr,
+                        const RenderRange& range = {});
 
     /** Composes paths from stored DataLogger parent dir / output-dir name and the
      *  FileToBufferManager input file, then calls transformFile.
@@ -75,25 +85,114 @@ public:
 
     juce::String getLastTransformError() const { return mLastTransformError; }
 
-    juce::AudioBuffer<float>& getInputBuffer()     { return mInputBuffer; }
-    juce::AudioBuffer<float>& getProcessedBuffer() { return mProcessedBuffer; }
+    //==============================================================================
+    // Render storage. Empty until a file is prepared/rendered; afterwards it holds
+    // the last job's input and output until the next job reuses the capacity.
+    bool prepareStorageForFile (const juce::File& inputFile)
+    {
+        _releaseAuditionBuffer();
+        return mOfflineRenderer.prepareStorage (inputFile);
+    }
+
+    juce::AudioBuffer<float>& getInputBuffer()     { return mOfflineRenderer.getInputBuffer(); }
+    juce::AudioBuffer<float>& getProcessedBuffer() { return mOfflineRenderer.getOutputBuffer(); }
+
+    OfflineRenderer& getOfflineRenderer() { return mOfflineRenderer; }
+    StoragePool&     getStoragePool()     { return mStoragePool; }
+
+    //==============================================================================
+    /** Queues every .wav in inputFolder and renders them concurrently into
+     *  outputDirectory with the current processor, parameters, render mode and
+     *  writer options. Returns immediately; poll getBatchRenderQueue() for
+     *  per-job / aggregate progress and results.
+     */
+    bool startBatchRender (const juce::File& inputFolder, const juce::File& outputDirectory);
+
+    BatchRenderQueue& getBatchRenderQueue() { return mBatchRenderQueue; }
 
     //==============================================================================
-    // Storage buffer sizing: 2ch x 60s at the maximum supported sample rate.
-    static constexpr double kMaxSupportedSampleRate = 192000.0;
-    static constexpr double kStorageSeconds         = 60.0;
-    static constexpr int    kStorageChannels        = 2;
-    static constexpr int    kStorageSamples         = static_cast<int>(kMaxSupportedSampleRate * kStorageSeconds);
+    /** Renders range of the FileToBufferManager input with the current processor
+     *  and parameters on a high-priority thread; doProcessBlock plays it as soon
+     *  as it is ready. */
+    bool startPreviewRender (const RenderRange& range = PreviewRenderer::getDefaultRange());
+
+    /** Starts the threaded FileToBufferManager render. withPreview first starts
+     *  a preview render and runs the full render at low priority behind it. */
+    bool startFileRender (bool withPreview);
+
+    PreviewRenderer& getPreviewRenderer() { return mPreviewRenderer; }
+
+    //==============================================================================
+    // Audition: play a finished render through doProcessBlock. Takes precedence
+    // over preview playback while playing.
+
+    /** Loads the processed buffer of the last buffered render and starts playback. */
+    bool auditionProcessedBuffer();
+
+    /** Memory-maps a rendered WAV and starts playback. */
+    bool auditionFile (const juce::File& renderedFile);
+
+    /** The FileToBufferManager's last output if it succeeded, else the processed buffer. */
+    bool auditionLastRender();
+
+    AuditionTransport& getAuditionTransport() { return mAuditionTransport; }
+
+    //==============================================================================
+    /** Live mode: doProcessBlock runs the host input through the active
+     *  processor and reports its latency to the host. Preview and audition
+     *  playback still take precedence, and blocks are silent while an offline
+     *  render holds the processors. Off by default.
+     *
+     *  Prepared while the host bounces (isNonRealtime()) with blocks smaller
+     *  than BlockAccumulator::kDefaultBlockSize, host blocks are regrouped
+     *  into accumulator-sized blocks first; the added latency is reported. */
+    void setLiveMode (bool shouldBeLive);
+    bool isLiveMode() const { return mLiveMode.load(); }
+
+    /** True if the last prepare set up bounce accumulation (see setLiveMode). */
+    bool isAccumulatingBounce() const { return mIsAccumulatingBounce.load(); }
+
+    //==============================================================================
+    /** Threaded renders (FileToBufferManager) reuse cached output for repeated
+     *  input + processor state. Off by default. */
+    void setRenderCacheEnabled (bool shouldUseCache)
+    {
+        mFileToBufferManager.setRenderCache (shouldUseCache ? &mRenderCache : nullptr);
+    }
+    bool         isRenderCacheEnabled() const { return mFileToBufferManager.getRenderCache() != nullptr; }
+    RenderCache& getRenderCache()             { return mRenderCache; }
 
 private:
     //==============================================================================
     BufferProcessingManager mBufferProcessingManager;
+    RenderCache             mRenderCache;          // outlives the manager that points at it
     FileToBufferManager     mFileToBufferManager;
 
     juce::String mLastTransformError;
 
-    juce::AudioBuffer<float> mInputBuffer     { kStorageChannels, kStorageSamples };
-    juce::AudioBuffer<float> mProcessedBuffer { kStorageChannels, kStorageSamples };
+    // Declared before the renderer: leases must be returned before the pool dies.
+    StoragePool     mStoragePool;
+    OfflineRenderer mOfflineRenderer { mBufferProcessingManager, mStoragePool };
+
+    // Owns its own processors and storage per worker; only the config is copied from here.
+    BatchRenderQueue mBatchRenderQueue;
+
+    // Own processor instances too; read lock-free from doProcessBlock.
+    PreviewRenderer mPreviewRenderer;
+
+    // May point at mOfflineRenderer's output buffer, so declared after it.
+    AuditionTransport mAuditionTransport;
+
+    std::atomic<bool> mLiveMode             { false };
+    std::atomic<bool> mIsAccumulatingBounce { false };
+    BlockAccumulator  mBounceAccumulator;
+
+    /** A render is about to reuse the processed buffer: let go of it first. */
+    void _releaseAuditionBuffer();
+
+    /** Live mode reports the active processor's latency plus any bounce accumulation;
+     *  playback of rendered audio has none. */
+    void _updateLatency();
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioFileTransformerProcessor)
@@ -0,0 +1,236 @@
+#include "Processor/PreviewRenderer.h"
+#include "Util/FileUtils.h"
+#include "Util/RenderTrace.h"
+#include <limits>
+
+//==============================================================================
+class PreviewRenderer::RenderThread : public juce::Thread
+{
+public:
+    explicit RenderThread(PreviewRenderer& owner)
+        : juce::Thread("Preview Render")
+        , mOwner(owner)
+    {
+    }
+
+    void run() override
+    {
+        AFT_TRACE_THREAD();
+        mOwner._render(*this);
+    }
+
+private:
+    PreviewRenderer& mOwner;
+};
+
+//==============================================================================
+PreviewRenderer::PreviewRenderer() {}
+
+PreviewRenderer::~PreviewRenderer()
+{
+    stop();
+}
+
+//==============================================================================
+bool PreviewRenderer::start(const juce::File& inputFile,
+                            const BatchRenderQueue::Config& config,
+                            const RenderRange& range,
+                            bool playWhenReady)
+{
+    stop();
+    mError.clear();
+
+    juce::String validationError;
+    if (! FileUtils::validateInputFile(inputFile, validationError))
+    {
+        mError = "Input file validation failed: " + validationError;
+        return false;
+    }
+
+    // mBPM is idle here: the previous render thread has been joined.
+    config.applyTo(mBPM);
+
+    mInputFile     = inputFile;
+    mRange         = range;
+    mPlayWhenReady = playWhenReady;
+
+    mControl.reset();
+    mFinished.reset();
+    mLatencyMs.store(0.0);
+    mStartMs = juce::Time::getMillisecondCounterHiRes();
+
+    mThread = std::make_unique<RenderThread>(*this);
+    mIsRendering.store(true);
+    mThread->startThread(juce::Thread::Priority::high);
+    return true;
+}
+
+void PreviewRenderer::stop()
+{
+    if (mThread != nullptr)
+    {
+        mControl.cancel();
+        mThread->stopThread(5000);
+        mThread.reset();
+        mIsRendering.store(false);
+    }
+}
+
+bool PreviewRenderer::waitUntilReady(int timeoutMs)
+{
+    return mFinished.wait(timeoutMs) && mError.isEmpty() && isReady();
+}
+
+//==============================================================================
+void PreviewRenderer::_fail(const juce::String& error)
+{
+    mError = mControl.isCancelled() ? juce::String("Cancelled") : error;
+    mIsRendering.store(false);
+    mFinished.signal();
+}
+
+void PreviewRenderer::_render(juce::Thread& thread)
+{
+    double      sampleRate  = 0.0;
+    int         numChannels = 0;
+    juce::int64 fileLength  = 0;
+    if (! FileUtils::readAudioFileInfo(mInputFile, sampleRate, numChannels, fileLength))
+    {
+        _fail("Failed to read audio header: " + mInputFile.getFullPathName());
+        return;
+    }
+
+    const auto region = mRange.resolve(sampleRate, fileLength);
+    if (region.getLength() <= 0)
+    {
+        _fail("Render range is empty");
+        return;
+    }
+    if (region.getReadLength() > std::numeric_limits<int>::max() / 2)
+    {
+        _fail("Preview range too long");
+        return;
+    }
+
+    // Load: seek straight to the pre-roll and read only the region.
+    const int storageChannels = juce::jmax(numChannels, 2);
+    const int readLength      = static_cast<int>(region.getReadLength());
+    mInput.setSize(storageChannels, readLength, false, false, true);
+
+    int samplesRead = 0;
+    if (! FileUtils::loadWavIntoBuffer(mInputFile, mInput, readLength, sampleRate, numChannels, samplesRead,
+                                        nullptr, &mControl, FileUtils::ReadStrategy::kAuto, region.getReadStart())
+        || samplesRead <= 0)
+    {
+        _fail("Failed to load WAV: " + mInputFile.getFullPathName());
+        return;
+    }
+
+    int    latencySamples = 0;
+    double tailSeconds    = 0.0;
+    if (auto* active = mBPM.getSwapper().getActiveProcessor())
+    {
+        latencySamples = active->getLatencySamples();
+        tailSeconds    = active->getTailLengthSeconds();
+    }
+    const int outputLength = samplesRead + latencySamples + static_cast<int>(tailSeconds * sampleRate);
+
+    // Render into the slot the audio thread is not playing. It may still be
+    // finishing a block from it if it was published before the last preview.
+    const int target = mPublishedSlot.load() == 0 ? 1 : 0;
+    while (mReaderSlot.load() == target)
+    {
+        if (thread.threadShouldExit())
+        {
+            _fail("Cancelled");
+            return;
+        }
+        juce::Thread::sleep(1);
+    }
+
+    auto& slot = mSlots[target];
+    slot.buffer.setSize(storageChannels, outputLength, false, true, true);
+
+    if (! mBPM.processBuffers(mInput, slot.buffer, samplesRead, outputLength, sampleRate,
+                              juce::jmax(1, mBPM.getBlockSize()), nullptr, &mControl))
+    {
+        _fail("Preview processing failed: " + mBPM.getLastError());
+        return;
+    }
+
+    slot.start      = static_cast<int>(region.preRoll);
+    slot.numSamples = outputLength - slot.start;
+    slot.sampleRate = sampleRate;
+
+    // Publish: the audio thread sees either the old slot or this complete one.
+    mPlayPosition.store(0);
+    mPublishedSlot.store(target);
+    if (mPlayWhenReady)
+        mIsPlaying.store(true);
+
+    mLatencyMs.store(juce::Time::getMillisecondCounterHiRes() - mStartMs);
+    mIsRendering.store(false);
+    mFinished.signal();
+}
+
+//==============================================================================
+void PreviewRenderer::play()
+{
+    mPlayPosition.store(0);
+    mIsPlaying.store(true);
+}
+
+int PreviewRenderer::getNumSamples() const
+{
+    const int slot = mPublishedSlot.load();
+    return slot >= 0 ? mSlots[slot].numSamples : 0;
+}
+
+double PreviewRenderer::getSampleRate() const
+{
+    const int slot = mPublishedSlot.load();
+    return slot >= 0 ? mSlots[slot].sampleRate : 0.0;
+}
+
+bool PreviewRenderer::readNextBlock(juce::AudioBuffer<float>& buffer)
+{
+    const int slotIndex = mPublishedSlot.load();
+    if (! mIsPlaying.load() || slotIndex < 0)
+    {
+        buffer.clear();
+        return false;
+    }
+
+    // Mark the slot, then confirm it is still the published one; the render
+    // thread only writes the unpublished slot and waits while it is marked.
+    mReaderSlot.store(slotIndex);
+    if (mPublishedSlot.load() != slotIndex)
+    {
+        mReaderSlot.store(-1);
+        buffer.clear();
+        return false;
+    }
+
+    const auto& slot        = mSlots[slotIndex];
+    const int   numSamples  = buffer.getNumSamples();
+    int         position    = mPlayPosition.load();
+    const int   toCopy      = juce::jlimit(0, numSamples, slot.numSamples - position);
+    const int   srcChannels = slot.buffer.getNumChannels();
+    const bool  reachedEnd  = position + toCopy >= slot.numSamples;
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        if (toCopy > 0)
+            buffer.copyFrom(ch, 0, slot.buffer, juce::jmin(ch, srcChannels - 1), slot.start + position, toCopy);
+        if (toCopy < numSamples)
+            buffer.clear(ch, toCopy, numSamples - toCopy);
+    }
+
+    mReaderSlot.store(-1);
+
+    // A play() from another thread in the meantime wins over this advance.
+    if (mPlayPosition.compare_exchange_strong(position, position + toCopy) && reachedEnd)
+        mIsPlaying.store(false);
+
+    return toCopy > 0;
+}
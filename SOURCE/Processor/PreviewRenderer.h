@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Util/Juce_Header.h"
+#include "Util/RenderControl.h"
+#include "Processor/BatchRenderQueue.h"
+#include "Processor/BufferProcessingManager.h"
+#include "Processor/RenderRange.h"
+#include <atomic>
+
+/**
+ * @brief Renders a short region of the input into memory at high priority and
+ *        plays it back on the realtime path.
+ *
+ * start() applies a processor snapshot (BatchRenderQueue::Config) to a private
+ * BufferProcessingManager, so the preview never shares processor state with a
+ * full render on the plugin's own manager, then renders the range — the first
+ * kDefaultPreviewSeconds unless told otherwise — on a high-priority thread.
+ *
+ * Finished previews are published into one of two slots. The audio thread
+ * reaches the published slot through atomics only: readNextBlock() marks the
+ * slot it is reading and the render thread never writes a marked slot, so a
+ * new preview can land mid-playback without locks or allocation on the audio
+ * thread. Samples play back one-for-one at the host's rate; the preview is
+ * not resampled.
+ */
+class PreviewRenderer
+{
+public:
+    PreviewRenderer();
+    ~PreviewRenderer();
+
+    static constexpr double kDefaultPreviewSeconds = 10.0;
+
+    static RenderRange getDefaultRange() { return RenderRange::inSeconds(0.0, kDefaultPreviewSeconds); }
+
+    //==============================================================================
+    /**
+     * Cancels any running preview, then renders range of inputFile with config
+     * on a high-priority thread. With playWhenReady the preview starts playing
+     * as soon as it is published. Returns false (see getLastError()) if the
+     * input is not a readable file.
+     */
+    bool start(const juce::File& inputFile,
+               const BatchRenderQueue::Config& config,
+               const RenderRange& range = getDefaultRange(),
+               bool playWhenReady = true);
+
+    /** Cancels the running preview and joins its thread; the published preview stays. */
+    void stop();
+
+    bool isRendering() const { return mIsRendering.load(); }
+    bool isReady()     const { return mPublishedSlot.load() >= 0; }
+
+    /** Blocks until the current preview is published; false on timeout or failure. */
+    bool waitUntilReady(int timeoutMs = -1);
+
+    /** Wall time from start() to the preview being playable, in ms. */
+    double getLatencyMs() const { return mLatencyMs.load(); }
+
+    juce::String getLastError() const { return mError; }
+
+    //==============================================================================
+    // Playback. play()/stopPlayback() from any thread; readNextBlock() from the
+    // audio thread.
+    void play();
+    void stopPlayback()     { mIsPlaying.store(false); }
+    bool isPlaying() const  { return mIsPlaying.load(); }
+
+    /** Samples of the published preview (region + latency + tail) and its rate. */
+    int    getNumSamples() const;
+    double getSampleRate() const;
+
+    /**
+     * Copies the next buffer.getNumSamples() preview samples into buffer and
+     * advances; anything past the end of the preview, or while stopped, is
+     * silence. Mono previews fill every output channel. Returns true if any
+     * preview audio was written. Lock- and allocation-free.
+     */
+    bool readNextBlock(juce::AudioBuffer<float>& buffer);
+
+private:
+    struct Slot
+    {
+        juce::AudioBuffer<float> buffer;
+        int                      start      = 0;   // pre-roll samples ahead of the region
+        int                      numSamples = 0;
+        double                   sampleRate = 0.0;
+    };
+
+    class RenderThread;
+
+    void _render(juce::Thread& thread);
+    void _fail(const juce::String& error);
+
+    BufferProcessingManager  mBPM;
+    juce::AudioBuffer<float> mInput;
+    Slot                     mSlots[2];
+
+    juce::File  mInputFile;
+    RenderRange mRange;
+    bool        mPlayWhenReady = true;
+
+    std::atomic<int>    mPublishedSlot { -1 };
+    std::atomic<int>    mReaderSlot    { -1 };
+    std::atomic<int>    mPlayPosition  { 0 };
+    std::atomic<bool>   mIsPlaying     { false };
+    std::atomic<bool>   mIsRendering   { false };
+    std::atomic<double> mLatencyMs     { 0.0 };
+    double              mStartMs       = 0.0;
+    juce::WaitableEvent mFinished      { true };
+
+    juce::String  mError;
+    RenderControl mControl;
+
+    std::unique_ptr<RenderThread> mThread;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PreviewRenderer)
+};
@@ -0,0 +1,280 @@
+#include "Processor/RenderCache.h"
+#include "Util/RenderControl.h"
+#include <algorithm>
+#include <map>
+
+namespace
+{
+    constexpr const char* kIndexFileName = "index.xml";
+    constexpr int         kHashChunkBytes = 1 << 20;
+}
+
+RenderCache::RenderCache(const juce::File& directory)
+    : mDirectory(directory)
+{
+}
+
+RenderCache::~RenderCache() {}
+
+juce::File RenderCache::getDefaultDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile("AudioFileTransformer")
+               .getChildFile("RenderCache");
+}
+
+//==============================================================================
+void RenderCache::setDirectory(const juce::File& directory)
+{
+    const juce::ScopedLock sl (mLock);
+    mDirectory = directory;
+    mEntries.clear();
+    mTotalBytes = 0;
+    mIndexed    = false;
+}
+
+juce::File RenderCache::getDirectory() const
+{
+    const juce::ScopedLock sl (mLock);
+    return mDirectory;
+}
+
+void RenderCache::setLimits(const Limits& limits)
+{
+    const juce::ScopedLock sl (mLock);
+    mLimits = limits;
+    if (mIndexed)
+    {
+        _evict();
+        _saveIndex();
+    }
+}
+
+RenderCache::Limits RenderCache::getLimits() const
+{
+    const juce::ScopedLock sl (mLock);
+    return mLimits;
+}
+
+//==============================================================================
+juce::String RenderCache::hashFile(const juce::File& file, RenderControl* control)
+{
+    juce::FileInputStream in (file);
+    if (! in.openedOk())
+        return {};
+
+    // juce::SHA256 has no incremental API; hashing the per-chunk digests keeps
+    // memory flat and gives the checkpoint a place to land.
+    juce::HeapBlock<char>    chunk (kHashChunkBytes);
+    juce::MemoryOutputStream digests;
+    digests.writeInt64(in.getTotalLength());
+
+    while (! in.isExhausted())
+    {
+        if (control != nullptr && ! control->checkpoint())
+            return {};
+
+        const auto numRead = in.read(chunk.get(), kHashChunkBytes);
+        if (numRead <= 0)
+            break;
+
+        const auto digest = juce::SHA256(chunk.get(), static_cast<size_t>(numRead)).getRawData();
+        digests.write(digest.getData(), digest.getSize());
+    }
+
+    return juce::SHA256(digests.getData(), digests.getDataSize()).toHexString();
+}
+
+juce::String RenderCache::makeKey(const juce::String& inputHash, const RenderSettings& settings)
+{
+    // Field separators keep e.g. ("ab", "c") and ("a", "bc") from colliding.
+    juce::String material;
+    material << "input="     << inputHash                                      << "\n"
+             << "processor=" << settings.processorName                         << "\n"
+             << "block="     << (settings.autoTuneBlockSize ? juce::String("auto")
+                                                            : juce::String(settings.blockSize)) << "\n"
+             << "bits="      << settings.bitDepth                              << "\n"
+             << "dither="    << (settings.dither ? 1 : 0)                      << "\n"
+             << "params="    << settings.parameterXml;
+
+    return juce::SHA256(material.toUTF8()).toHexString();
+}
+
+//==============================================================================
+bool RenderCache::fetch(const juce::String& key, const juce::File& destination)
+{
+    const juce::ScopedLock sl (mLock);
+    _ensureIndexed();
+
+    // Copied, never linked, so in-place edits to the output can't reach the entry.
+    // Land under a temp name, then rename: a miss or failed copy leaves destination alone.
+    auto* entry = _find(key);
+    const auto temp = destination.getSiblingFile(destination.getFileName() + ".tmp");
+    if (entry == nullptr || ! entry->file.existsAsFile()
+        || ! entry->file.copyFileTo(temp) || ! temp.moveFileTo(destination))
+    {
+        temp.deleteFile();
+        mMisses.fetch_add(1);
+        return false;
+    }
+
+    entry->lastUsed = juce::Time::currentTimeMillis();
+    _saveIndex();
+    mHits.fetch_add(1);
+    return true;
+}
+
+bool RenderCache::store(const juce::String& key, const juce::File& renderedFile)
+{
+    const juce::ScopedLock sl (mLock);
+    _ensureIndexed();
+
+    const juce::int64 bytes = renderedFile.getSize();
+    if (key.isEmpty() || bytes <= 0 || bytes > mLimits.maxBytes || mLimits.maxEntries <= 0)
+        return false;
+
+    if (mDirectory.createDirectory().failed())
+        return false;
+
+    // Copied, never linked, so the entry can't change with the user's file.
+    // Land under a temp name, then rename: a crash never leaves a truncated entry.
+    const auto target = mDirectory.getChildFile(key + ".wav");
+    const auto temp   = mDirectory.getChildFile(key + ".tmp");
+    if (! renderedFile.copyFileTo(temp) || ! temp.moveFileTo(target))
+    {
+        temp.deleteFile();
+        return false;
+    }
+
+    const auto now = juce::Time::currentTimeMillis();
+
+    if (auto* existing = _find(key))
+    {
+        mTotalBytes     += bytes - existing->bytes;
+        existing->bytes    = bytes;
+        existing->lastUsed = now;
+    }
+    else
+    {
+        mEntries.push_back({ key, target, bytes, now });
+        mTotalBytes += bytes;
+    }
+
+    _evict();
+    _saveIndex();
+    return true;
+}
+
+bool RenderCache::contains(const juce::String& key)
+{
+    const juce::ScopedLock sl (mLock);
+    _ensureIndexed();
+    return _find(key) != nullptr;
+}
+
+void RenderCache::clear()
+{
+    const juce::ScopedLock sl (mLock);
+    _ensureIndexed();
+
+    for (auto& entry : mEntries)
+        entry.file.deleteFile();
+
+    mEntries.clear();
+    mTotalBytes = 0;
+    mDirectory.getChildFile(kIndexFileName).deleteFile();
+}
+
+int RenderCache::getNumEntries()
+{
+    const juce::ScopedLock sl (mLock);
+    _ensureIndexed();
+    return static_cast<int>(mEntries.size());
+}
+
+juce::int64 RenderCache::getTotalBytes()
+{
+    const juce::ScopedLock sl (mLock);
+    _ensureIndexed();
+    return mTotalBytes;
+}
+
+//==============================================================================
+void RenderCache::_ensureIndexed()
+{
+    if (mIndexed)
+        return;
+
+    mIndexed = true;
+    mEntries.clear();
+    mTotalBytes = 0;
+
+    if (! mDirectory.isDirectory())
+        return;
+
+    std::map<juce::String, juce::int64> lastUsed;
+    if (auto xml = juce::XmlDocument::parse(mDirectory.getChildFile(kIndexFileName)))
+        if (xml->hasTagName("RenderCacheIndex"))
+            for (auto* e : xml->getChildWithTagNameIterator("Entry"))
+                lastUsed[e->getStringAttribute("key")] = e->getStringAttribute("lastUsed").getLargeIntValue();
+
+    for (const auto& file : mDirectory.findChildFiles(juce::File::findFiles, false, "*.wav"))
+    {
+        // An entry missing from the index (e.g. written before it) ranks by its file time.
+        const auto key  = file.getFileNameWithoutExtension();
+        const auto used = lastUsed.find(key);
+        Entry entry { key, file, file.getSize(),
+                      used != lastUsed.end() ? used->second : file.getLastModificationTime().toMilliseconds() };
+        mTotalBytes += entry.bytes;
+        mEntries.push_back(std::move(entry));
+    }
+
+    // Leftovers from an interrupted store().
+    for (const auto& file : mDirectory.findChildFiles(juce::File::findFiles, false, "*.tmp"))
+        file.deleteFile();
+
+    _evict();
+}
+
+void RenderCache::_saveIndex() const
+{
+    if (! mDirectory.isDirectory())
+        return;
+
+    juce::XmlElement xml("RenderCacheIndex");
+    for (const auto& entry : mEntries)
+    {
+        auto* e = xml.createNewChildElement("Entry");
+        e->setAttribute("key", entry.key);
+        e->setAttribute("lastUsed", juce::String(entry.lastUsed));
+    }
+
+    xml.writeTo(mDirectory.getChildFile(kIndexFileName));
+}
+
+void RenderCache::_evict()
+{
+    if (mTotalBytes <= mLimits.maxBytes && static_cast<int>(mEntries.size()) <= mLimits.maxEntries)
+        return;
+
+    // Most recent first; trim from the back.
+    std::sort(mEntries.begin(), mEntries.end(),
+              [](const Entry& a, const Entry& b) { return a.lastUsed > b.lastUsed; });
+
+    while (! mEntries.empty()
+           && (mTotalBytes > mLimits.maxBytes || static_cast<int>(mEntries.size()) > mLimits.maxEntries))
+    {
+        auto& victim = mEntries.back();
+        victim.file.deleteFile();
+        mTotalBytes -= victim.bytes;
+        mEntries.pop_back();
+    }
+}
+
+RenderCache::Entry* RenderCache::_find(const juce::String& key)
+{
+    for (auto& entry : mEntries)
+        if (entry.key == key)
+            return &entry;
+    return nullptr;
+}
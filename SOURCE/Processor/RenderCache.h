@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Util/Juce_Header.h"
+#include <atomic>
+#include <vector>
+
+class RenderControl;
+
+/**
+ * @brief Content-addressed cache of rendered WAVs.
+ *
+ * An entry is keyed by a SHA-256 over the input file's bytes and everything
+ * that shapes the output: the active processor's name, its APVTS state XML
+ * (the same XML written to Transformation_Data.md), the block size and the
+ * writer format. A hit copies the cached WAV to the requested output instead
+ * of rendering.
+ *
+ * Entries live as <key>.wav in one directory. Both store() and fetch() copy,
+ * never link, so the cache and the user's files share no storage: editing a
+ * fetched output in place leaves the entry untouched. Recency lives in
+ * index.xml beside the entries rather than in file times. store() evicts
+ * least-recently-used entries until the cache is within both Limits.
+ *
+ * Thread-safe; the directory is only scanned/created on first use.
+ */
+class RenderCache
+{
+public:
+    struct Limits
+    {
+        juce::int64 maxBytes   = juce::int64 (2) * 1024 * 1024 * 1024;
+        int         maxEntries = 256;
+    };
+
+    /** Everything besides the input audio that determines the rendered bytes. */
+    struct RenderSettings
+    {
+        juce::String processorName;
+        juce::String parameterXml;
+        int          blockSize         = 512;
+        bool         autoTuneBlockSize = false;
+        int          bitDepth          = 24;
+        bool         dither            = false;
+    };
+
+    explicit RenderCache(const juce::File& directory = getDefaultDirectory());
+    ~RenderCache();
+
+    static juce::File getDefaultDirectory();
+
+    void       setDirectory(const juce::File& directory);
+    juce::File getDirectory() const;
+
+    /** Applies immediately: evicts down to the new limits. */
+    void   setLimits(const Limits& limits);
+    Limits getLimits() const;
+
+    //==============================================================================
+    /**
+     * Hex digest of the file's bytes: a SHA-256 over the SHA-256 of each 1 MB
+     * chunk. Between chunks it calls control->checkpoint(), so a large input
+     * can be paused or cancelled before the render starts. Empty if the file
+     * is unreadable or the hash was cancelled.
+     */
+    static juce::String hashFile(const juce::File& file, RenderControl* control = nullptr);
+
+    /** Combines an input hash with the render settings into a cache key. */
+    static juce::String makeKey(const juce::String& inputHash, const RenderSettings& settings);
+
+    /**
+     * On a hit, copies the cached render to destination, marks the entry
+     * most recently used and returns true. A miss returns false and leaves
+     * destination alone.
+     */
+    bool fetch(const juce::String& key, const juce::File& destination);
+
+    /**
+     * Copies renderedFile in under key, then evicts. Returns false if the file
+     * alone exceeds maxBytes or cannot be added.
+     */
+    bool store(const juce::String& key, const juce::File& renderedFile);
+
+    bool contains(const juce::String& key);
+
+    /** Deletes every entry. */
+    void clear();
+
+    int         getNumEntries();
+    juce::int64 getTotalBytes();
+    int         getNumHits()   const { return mHits.load(); }
+    int         getNumMisses() const { return mMisses.load(); }
+
+private:
+    struct Entry
+    {
+        juce::String key;
+        juce::File   file;
+        juce::int64  bytes    = 0;
+        juce::int64  lastUsed = 0;    // ms since epoch
+    };
+
+    void   _ensureIndexed();
+    void   _saveIndex() const;
+    void   _evict();
+    Entry* _find(const juce::String& key);
+
+    juce::File         mDirectory;
+    Limits             mLimits;
+    std::vector<Entry> mEntries;
+    juce::int64        mTotalBytes = 0;
+    bool               mIndexed    = false;
+    std::atomic<int>   mHits       { 0 };
+    std::atomic<int>   mMisses     { 0 };
+
+    mutable juce::CriticalSection mLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderCache)
+};
@@ -0,0 +1,109 @@
+#include "Processor/RenderMetrics.h"
+
+#if JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #include <windows.h>
+#else
+ #include <time.h>
+#endif
+
+namespace
+{
+#if JUCE_WINDOWS
+    double fileTimeSeconds(const FILETIME& kernel, const FILETIME& user)
+    {
+        auto toTicks = [](const FILETIME& t)
+        {
+            return (static_cast<unsigned long long>(t.dwHighDateTime) << 32) | t.dwLowDateTime;
+        };
+
+        // FILETIME ticks are 100 ns.
+        return static_cast<double>(toTicks(kernel) + toTicks(user)) * 1.0e-7;
+    }
+#else
+    double clockSeconds(clockid_t clock)
+    {
+        timespec ts {};
+        if (clock_gettime(clock, &ts) != 0)
+            return 0.0;
+
+        return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1.0e-9;
+    }
+#endif
+
+    juce::String formatSeconds(double seconds)
+    {
+        return juce::String(seconds, 3) + " s";
+    }
+}
+
+//==============================================================================
+double RenderMetrics::getProcessCpuSeconds()
+{
+#if JUCE_WINDOWS
+    FILETIME created, exited, kernel, user;
+    return GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user) ? fileTimeSeconds(kernel, user) : 0.0;
+#else
+    return clockSeconds(CLOCK_PROCESS_CPUTIME_ID);
+#endif
+}
+
+double RenderMetrics::getThreadCpuSeconds()
+{
+#if JUCE_WINDOWS
+    FILETIME created, exited, kernel, user;
+    return GetThreadTimes(GetCurrentThread(), &created, &exited, &kernel, &user) ? fileTimeSeconds(kernel, user) : 0.0;
+#else
+    return clockSeconds(CLOCK_THREAD_CPUTIME_ID);
+#endif
+}
+
+juce::String RenderMetrics::toMarkdown() const
+{
+    juce::String md;
+    md << "\n## Render Metrics\n\n";
+
+    if (overlapped)
+        md << "Streaming render: phases overlap, so phase wall times are per-stage busy time.\n\n";
+
+    md << "| Phase | Wall | CPU |\n"
+       << "|---|---|---|\n";
+
+    auto row = [&md](const char* name, const Phase& phase)
+    {
+        md << "| " << name << " | " << formatSeconds(phase.wallSeconds) << " | " << formatSeconds(phase.cpuSeconds) << " |\n";
+    };
+
+    row("Load",    load);
+    row("Process", process);
+    row("Write",   write);
+    row("Total",   total);
+
+    md << "\n- **Audio Length:** " << formatSeconds(audioSeconds) << "\n"
+       << "- **Realtime Factor:** " << juce::String(getRealtimeFactor(), 2) << "x\n"
+       << "- **Peak Storage:** " << juce::File::descriptionOfSizeInBytes(static_cast<juce::int64>(peakStorageBytes)) << "\n";
+
+    if (memory.isValid())
+        md << "- **Peak Memory:** " << memory.toString() << ", "
+           << juce::File::descriptionOfSizeInBytes(memory.getRenderBytes()) << " above the render's start\n";
+
+    if (blockLatency.isValid())
+        md << "- **Block Latency:** " << blockLatency.toString() << " over " << juce::String(blockLatency.count) << " blocks\n";
+
+    return md;
+}
+
+//==============================================================================
+void RenderPhaseWeights::update(const RenderMetrics& metrics, float smoothing)
+{
+    const double sum = metrics.load.wallSeconds + metrics.process.wallSeconds + metrics.write.wallSeconds;
+    if (metrics.isOverlapped() || sum <= 0.0)
+        return;
+
+    const float keep = juce::jlimit(0.0f, 1.0f, smoothing);
+    load    = keep * load    + (1.0f - keep) * static_cast<float>(metrics.load.wallSeconds    / sum);
+    process = keep * process + (1.0f - keep) * static_cast<float>(metrics.process.wallSeconds / sum);
+    write   = keep * write   + (1.0f - keep) * static_cast<float>(metrics.write.wallSeconds   / sum);
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Util/Juce_Header.h"
+#include "Util/LatencyHistogram.h"
+#include "Util/MemoryAccounting.h"
+
+/**
+ * @brief Timing and storage report for one offline render.
+ *
+ * Buffered renders run load, process and write one after another on the
+ * render thread; "write" is the drain of the async writer after the last
+ * block, since every earlier write overlaps processing. Phase CPU time is
+ * process-wide, so it includes the writer thread's work.
+ *
+ * Streaming renders overlap all three phases on separate threads
+ * (isOverlapped()). Each phase's wall time is then how long its stage was
+ * busy, so the phases add up to more than the total, and CPU time is split
+ * by thread: reader, processing thread, and the remainder (writer).
+ *
+ * blockLatency is the distribution of the active processor's processBlock
+ * durations over the render. memory is the process-wide high water of the
+ * tracked allocations (MemoryAccounting) while the render ran.
+ */
+struct RenderMetrics
+{
+    struct Phase
+    {
+        double wallSeconds = 0.0;
+        double cpuSeconds  = 0.0;
+    };
+
+    Phase  load;
+    Phase  process;
+    Phase  write;
+    Phase  total;
+
+    double audioSeconds     = 0.0;  // written region, latency and tail included
+    size_t peakStorageBytes = 0;    // sample storage held for the render (pool or block ring)
+    bool   overlapped       = false;
+
+    LatencyHistogram::Summary  blockLatency;
+    MemoryAccounting::Snapshot memory;
+
+    bool   isValid()         const { return total.wallSeconds > 0.0; }
+    bool   isOverlapped()    const { return overlapped; }
+
+    /** Audio seconds rendered per wall-clock second; above 1 is faster than realtime. */
+    double getRealtimeFactor() const { return total.wallSeconds > 0.0 ? audioSeconds / total.wallSeconds : 0.0; }
+
+    /** Markdown section appended to Transformation_Data.md. */
+    juce::String toMarkdown() const;
+
+    /** CPU seconds used so far by the whole process / the calling thread. */
+    static double getProcessCpuSeconds();
+    static double getThreadCpuSeconds();
+
+    /** Wall-clock seconds from a monotonic high-resolution counter. */
+    static double getWallSeconds() { return juce::Time::getMillisecondCounterHiRes() * 0.001; }
+};
+
+/**
+ * @brief Share of a buffered render's wall time spent in each phase.
+ *
+ * Drives progress so the bar moves at an even pace: starts at the old fixed
+ * split and tracks measured renders from then on.
+ */
+struct RenderPhaseWeights
+{
+    float load    = 0.33f;
+    float process = 0.62f;
+    float write   = 0.05f;
+
+    /** Blends a measured render in; smoothing is the weight kept from the previous estimate. */
+    void update(const RenderMetrics& metrics, float smoothing = 0.5f);
+};
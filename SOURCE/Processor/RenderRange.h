@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Util/Juce_Header.h"
+#include <cmath>
+
+/**
+ * @brief Region of an input file to render, plus processor pre-roll.
+ *
+ * start/end/preRoll are in samples or seconds (units). end < 0 means the end
+ * of the file. Pre-roll is input fed through the processor ahead of start so
+ * its internal state (windows, grain buffers, smoothing) has settled by the
+ * first written sample; that output is discarded. Pre-roll never reaches
+ * before the start of the file.
+ *
+ * The written file holds only the region: (end - start) samples plus the
+ * processor's latency and tail, exactly as a whole-file render would.
+ */
+struct RenderRange
+{
+    enum class Units
+    {
+        kSamples = 0,
+        kSeconds
+    };
+
+    Units  units   = Units::kSamples;
+    double start   = 0.0;
+    double end     = -1.0;
+    double preRoll = 0.0;
+
+    static RenderRange inSamples(juce::int64 start, juce::int64 end = -1, juce::int64 preRoll = 0)
+    {
+        return { Units::kSamples, static_cast<double>(start), static_cast<double>(end), static_cast<double>(preRoll) };
+    }
+
+    static RenderRange inSeconds(double start, double end = -1.0, double preRoll = 0.0)
+    {
+        return { Units::kSeconds, start, end, preRoll };
+    }
+
+    bool isWholeFile() const { return start <= 0.0 && end < 0.0; }
+
+    /** A range in sample positions, clamped to one file. */
+    struct Resolved
+    {
+        juce::int64 start   = 0;
+        juce::int64 end     = 0;
+        juce::int64 preRoll = 0;
+
+        juce::int64 getLength()     const { return end - start; }
+        juce::int64 getReadStart()  const { return start - preRoll; }
+        juce::int64 getReadLength() const { return end - getReadStart(); }
+    };
+
+    /** Converts to samples at sampleRate and clamps to [0, inputLength]. */
+    Resolved resolve(double sampleRate, juce::int64 inputLength) const
+    {
+        auto toSamples = [this, sampleRate](double value)
+        {
+            return units == Units::kSeconds ? static_cast<juce::int64>(std::llround(value * sampleRate))
+                                            : static_cast<juce::int64>(value);
+        };
+
+        Resolved resolved;
+        resolved.start   = juce::jlimit<juce::int64>(0, inputLength, toSamples(start));
+        resolved.end     = end < 0.0 ? inputLength
+                                     : juce::jlimit<juce::int64>(resolved.start, inputLength, toSamples(end));
+        resolved.preRoll = juce::jlimit<juce::int64>(0, resolved.start, toSamples(preRoll));
+        return resolved;
+    }
+};
@@ -0,0 +1,148 @@
+#include "Processor/StoragePool.h"
+
+//==============================================================================
+StoragePool::Lease::~Lease()
+{
+    release();
+}
+
+StoragePool::Lease::Lease(Lease&& other) noexcept
+    : mPool(other.mPool)
+    , mSlotIndex(other.mSlotIndex)
+    , mBuffer(other.mBuffer)
+{
+    other.mPool      = nullptr;
+    other.mSlotIndex = -1;
+    other.mBuffer    = nullptr;
+}
+
+StoragePool::Lease& StoragePool::Lease::operator=(Lease&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        mPool            = other.mPool;
+        mSlotIndex       = other.mSlotIndex;
+        mBuffer          = other.mBuffer;
+        other.mPool      = nullptr;
+        other.mSlotIndex = -1;
+        other.mBuffer    = nullptr;
+    }
+    return *this;
+}
+
+juce::AudioBuffer<float>& StoragePool::Lease::getBuffer()
+{
+    jassert(isValid());
+    return *mBuffer;
+}
+
+const juce::AudioBuffer<float>& StoragePool::Lease::getBuffer() const
+{
+    jassert(isValid());
+    return *mBuffer;
+}
+
+void StoragePool::Lease::release()
+{
+    if (mPool != nullptr)
+        mPool->_release(mSlotIndex);
+
+    mPool      = nullptr;
+    mSlotIndex = -1;
+    mBuffer    = nullptr;
+}
+
+//==============================================================================
+StoragePool::StoragePool() {}
+
+StoragePool::~StoragePool()
+{
+    // Every Lease must be returned before the pool goes away.
+    jassert(getNumLeased() == 0);
+}
+
+StoragePool::Lease StoragePool::acquire(int numChannels, int numSamples)
+{
+    const juce::ScopedLock sl(mLock);
+
+    const size_t needed = bytesFor(numChannels, numSamples);
+
+    int bestFit  = -1;
+    int largest  = -1;
+    for (int i = 0; i < static_cast<int>(mSlots.size()); ++i)
+    {
+        const auto& slot = mSlots[static_cast<size_t>(i)];
+        if (slot.leased)
+            continue;
+
+        if (slot.capacityBytes >= needed
+            && (bestFit < 0 || slot.capacityBytes < mSlots[static_cast<size_t>(bestFit)].capacityBytes))
+            bestFit = i;
+
+        if (largest < 0 || slot.capacityBytes > mSlots[static_cast<size_t>(largest)].capacityBytes)
+            largest = i;
+    }
+
+    int index = bestFit >= 0 ? bestFit : largest;
+    if (index < 0)
+    {
+        mSlots.push_back({ std::make_unique<juce::AudioBuffer<float>>(), 0, false });
+        index = static_cast<int>(mSlots.size()) - 1;
+    }
+
+    auto& slot = mSlots[static_cast<size_t>(index)];
+    // avoidReallocating: shrinking or same-size reuse keeps the existing block.
+    slot.buffer->setSize(numChannels, numSamples, false, false, true);
+    slot.capacityBytes = juce::jmax(slot.capacityBytes, needed);
+    slot.leased        = true;
+    mTrackedBytes.set(static_cast<juce::int64>(getAllocatedBytes()));
+
+    return Lease(*this, index, *slot.buffer);
+}
+
+void StoragePool::_release(int slotIndex)
+{
+    const juce::ScopedLock sl(mLock);
+    if (juce::isPositiveAndBelow(slotIndex, static_cast<int>(mSlots.size())))
+        mSlots[static_cast<size_t>(slotIndex)].leased = false;
+}
+
+size_t StoragePool::getAllocatedBytes() const
+{
+    const juce::ScopedLock sl(mLock);
+    size_t total = 0;
+    for (const auto& slot : mSlots)
+        total += slot.capacityBytes;
+    return total;
+}
+
+int StoragePool::getNumBuffers() const
+{
+    const juce::ScopedLock sl(mLock);
+    return static_cast<int>(mSlots.size());
+}
+
+int StoragePool::getNumLeased() const
+{
+    const juce::ScopedLock sl(mLock);
+    int leased = 0;
+    for (const auto& slot : mSlots)
+        if (slot.leased)
+            ++leased;
+    return leased;
+}
+
+void StoragePool::releaseIdleStorage()
+{
+    const juce::ScopedLock sl(mLock);
+    for (auto& slot : mSlots)
+    {
+        if (slot.leased)
+            continue;
+
+        slot.buffer->setSize(0, 0);
+        slot.capacityBytes = 0;
+    }
+    mTrackedBytes.set(static_cast<juce::int64>(getAllocatedBytes()));
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Util/Juce_Header.h"
+#include "Util/MemoryAccounting.h"
+#include <vector>
+
+/**
+ * @brief Reusable pool of render storage buffers.
+ *
+ * Buffers are handed out as RAII Leases sized to the job at hand. Released
+ * buffers keep their allocation, so a follow-up job of equal or smaller size
+ * reuses the memory instead of reallocating. Nothing is allocated until the
+ * first acquire(), which keeps plugin instantiation cheap.
+ *
+ * acquire() / release are guarded by a lock and must not be called from the
+ * audio thread. Reserved capacity counts as MemoryAccounting storage.
+ */
+class StoragePool
+{
+public:
+    StoragePool();
+    ~StoragePool();
+
+    //==============================================================================
+    class Lease
+    {
+    public:
+        Lease() = default;
+        ~Lease();
+
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+
+        bool isValid() const { return mPool != nullptr; }
+
+        juce::AudioBuffer<float>&       getBuffer();
+        const juce::AudioBuffer<float>& getBuffer() const;
+
+        /** Returns the buffer to the pool early. Capacity is retained by the pool. */
+        void release();
+
+    private:
+        friend class StoragePool;
+        Lease(StoragePool& pool, int slotIndex, juce::AudioBuffer<float>& buffer)
+            : mPool(&pool), mSlotIndex(slotIndex), mBuffer(&buffer) {}
+
+        // Cached so getBuffer() never touches the pool's slot vector, which
+        // another thread may be growing inside acquire().
+        StoragePool*              mPool      = nullptr;
+        int                       mSlotIndex = -1;
+        juce::AudioBuffer<float>* mBuffer    = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE(Lease)
+    };
+
+    //==============================================================================
+    /**
+     * Hands out a buffer sized to numChannels x numSamples. Prefers the idle
+     * buffer whose capacity fits most tightly; grows the largest idle buffer
+     * otherwise. Contents are unspecified — callers clear as needed.
+     */
+    Lease acquire(int numChannels, int numSamples);
+
+    /** Bytes currently reserved across all buffers, leased or idle. */
+    size_t getAllocatedBytes() const;
+
+    int getNumBuffers() const;
+    int getNumLeased() const;
+
+    /** Frees the allocation of every idle buffer. */
+    void releaseIdleStorage();
+
+    static size_t bytesFor(int numChannels, int numSamples)
+    {
+        return static_cast<size_t>(juce::jmax(0, numChannels))
+             * static_cast<size_t>(juce::jmax(0, numSamples))
+             * sizeof(float);
+    }
+
+private:
+    struct Slot
+    {
+        std::unique_ptr<juce::AudioBuffer<float>> buffer;
+        size_t capacityBytes = 0;
+        bool   leased        = false;
+    };
+
+    void _release(int slotIndex);
+
+    std::vector<Slot>             mSlots;
+    mutable juce::CriticalSection mLock;
+    MemoryAccounting::Tracked     mTrackedBytes { MemoryAccounting::Category::kStorage };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StoragePool)
+};
@@ -0,0 +1,339 @@
+#include "Processor/StreamingRenderPipeline.h"
+#include "Processor/BufferProcessingManager.h"
+#include "Util/RenderControl.h"
+#include "Util/FileUtils.h"
+#include "Util/RenderTrace.h"
+
+//==============================================================================
+class StreamingRenderPipeline::ReaderThread : public juce::Thread
+{
+public:
+    ReaderThread(StreamingRenderPipeline& owner, std::unique_ptr<juce::AudioFormatReader> reader)
+        : juce::Thread("StreamingRender Reader")
+        , mOwner(owner)
+        , mReader(std::move(reader))
+    {
+    }
+
+    void run() override
+    {
+        AFT_TRACE_THREAD();
+
+        const bool        isMono    = mReader->numChannels == 1;
+        const juce::int64 outputEnd = mOwner.mPreRollLength + mOwner.mOutputLength;
+        const juce::int64 inputEnd  = mOwner.mInputLength;
+        const juce::int64 readStart = mOwner.mReadStart;
+        juce::int64       position  = 0;
+
+        const double startCpu = RenderMetrics::getThreadCpuSeconds();
+        struct ScopedCpu
+        {
+            ReaderThread& thread;
+            double start;
+            ~ScopedCpu() { thread.mCpuSeconds = RenderMetrics::getThreadCpuSeconds() - start; }
+        } scopedCpu { *this, startCpu };
+
+        while (position < outputEnd)
+        {
+            int index = -1;
+            if (! mOwner._waitForBlock(mOwner.mFreeQueue, mOwner.mFreeReady, index))
+                return;
+
+            auto& block = mOwner.mBlocks[static_cast<size_t>(index)];
+            const int blockSize   = block.buffer.getNumSamples();
+            const int numChannels = block.buffer.getNumChannels();
+            const int numSamples  = static_cast<int>(juce::jmin<juce::int64>(blockSize, outputEnd - position));
+            const int toRead      = static_cast<int>(juce::jlimit<juce::int64>(0, numSamples, inputEnd - position));
+
+            AFT_TRACE_SCOPE("readChunk", "io");
+            const double busyStart = RenderMetrics::getWallSeconds();
+
+            // Past the end of the input the block carries silence for latency + tail.
+            block.buffer.clear();
+
+            if (toRead > 0)
+            {
+                if (! mReader->read(&block.buffer, 0, toRead, readStart + position, true, numChannels > 1))
+                {
+                    mError = "Failed to read WAV at sample " + juce::String(readStart + position);
+                    mOwner._abort();
+                    return;
+                }
+
+                if (isMono)
+                    for (int ch = 1; ch < numChannels; ++ch)
+                        block.buffer.copyFrom(ch, 0, block.buffer, 0, 0, toRead);
+            }
+
+            block.numSamples = numSamples;
+            position += numSamples;
+            mBusySeconds += RenderMetrics::getWallSeconds() - busyStart;
+
+            const bool pushed = mOwner.mFilledQueue.push(index);
+            jassertquiet(pushed);
+            mOwner.mFilledReady.signal();
+        }
+    }
+
+    juce::String getError() const { return mError; }
+
+    // Valid once the thread has exited.
+    double getBusySeconds() const { return mBusySeconds; }
+    double getCpuSeconds()  const { return mCpuSeconds; }
+
+private:
+    StreamingRenderPipeline&                 mOwner;
+    std::unique_ptr<juce::AudioFormatReader> mReader;
+    juce::String                             mError;
+    double                                   mBusySeconds = 0.0;
+    double                                   mCpuSeconds  = 0.0;
+};
+
+//==============================================================================
+StreamingRenderPipeline::StreamingRenderPipeline(BufferProcessingManager& bpm)
+    : mBPM(bpm)
+{
+}
+
+StreamingRenderPipeline::~StreamingRenderPipeline() {}
+
+//==============================================================================
+int StreamingRenderPipeline::_resolveBlockSize(double sampleRate, int numChannels)
+{
+    // The autotuner probes against a buffered input, which a stream never has;
+    // reuse a cached result when one exists, otherwise the fixed block size.
+    if (mBPM.getAutoTuneBlockSize())
+    {
+        auto* active = mBPM.getSwapper().getActiveProcessor();
+        const juce::String processorName = active ? active->getName() : juce::String("None");
+
+        if (const int cached = mBPM.getAutoTuner().getCachedBlockSize(processorName, sampleRate, numChannels); cached > 0)
+            return cached;
+    }
+
+    return juce::jmax(1, mBPM.getBlockSize());
+}
+
+bool StreamingRenderPipeline::_waitForBlock(SpscQueue<int>& queue, juce::WaitableEvent& event, int& index)
+{
+    for (;;)
+    {
+        if (mAborted.load())
+            return false;
+
+        if (queue.pop(index))
+            return true;
+
+        // Timed so a missed signal or an abort from another stage never hangs us.
+        event.wait(5);
+    }
+}
+
+void StreamingRenderPipeline::_abort()
+{
+    mAborted.store(true);
+    mFreeReady.signal();
+    mFilledReady.signal();
+}
+
+//==============================================================================
+bool StreamingRenderPipeline::render(const juce::File& inputFile,
+                                     const juce::File& outputFile,
+                                     std::function<void(float)> progressCallback,
+                                     RenderControl* control,
+                                     const RenderRange& range)
+{
+    mLastError.clear();
+    mAborted.store(false);
+    mReadStart      = 0;
+    mPreRollLength  = 0;
+    mOutputLength   = 0;
+    mProducerStalls = 0;
+    mLastMetrics    = {};
+
+    const double startWall = RenderMetrics::getWallSeconds();
+    const double startCpu  = RenderMetrics::getProcessCpuSeconds();
+    const MemoryAccounting::ScopedPeak memoryPeak;
+
+    //==============================================================================
+    // Open input
+    // Mapped for WAV: the reader thread then decodes straight from the page cache.
+    auto reader = FileUtils::createReaderFor(inputFile);
+    if (reader == nullptr)
+    {
+        mLastError = "Failed to read audio header: " + inputFile.getFullPathName();
+        return false;
+    }
+
+    mSampleRate = reader->sampleRate;
+    if (reader->lengthInSamples <= 0 || mSampleRate <= 0.0)
+    {
+        mLastError = "No samples read from WAV file";
+        return false;
+    }
+
+    // The reader seeks straight to the pre-roll start; nothing before it is decoded.
+    const auto region = range.resolve(mSampleRate, reader->lengthInSamples);
+    if (region.getLength() <= 0)
+    {
+        mLastError = "Render range is empty";
+        return false;
+    }
+
+    mReadStart     = region.getReadStart();
+    mPreRollLength = region.preRoll;
+    mInputLength   = region.getReadLength();
+
+    int    latencySamples = 0;
+    double tailSeconds    = 0.0;
+    if (auto* active = mBPM.getSwapper().getActiveProcessor())
+    {
+        latencySamples = active->getLatencySamples();
+        tailSeconds    = active->getTailLengthSeconds();
+    }
+    mOutputLength = region.getLength() + latencySamples + static_cast<juce::int64>(tailSeconds * mSampleRate);
+
+    const int numChannels = juce::jmax(static_cast<int>(reader->numChannels), kMinChannels);
+    const int blockSize   = _resolveBlockSize(mSampleRate, numChannels);
+
+    //==============================================================================
+    // Block ring + queues. No other thread is running, so draining is safe.
+    mBlocks.resize(kNumBlocks);
+    for (auto& block : mBlocks)
+    {
+        block.buffer.setSize(numChannels, blockSize, false, false, true);
+        block.numSamples = 0;
+    }
+    mStorageBytes = static_cast<size_t>(kNumBlocks) * static_cast<size_t>(numChannels)
+                  * static_cast<size_t>(blockSize) * sizeof(float);
+    mBlockBytes.set(static_cast<juce::int64>(mStorageBytes));
+
+    int drained = 0;
+    while (mFreeQueue.pop(drained))   {}
+    while (mFilledQueue.pop(drained)) {}
+    mFreeReady.reset();
+    mFilledReady.reset();
+
+    for (int i = 0; i < kNumBlocks; ++i)
+        mFreeQueue.push(i);
+
+    //==============================================================================
+    // Open output: conversion + disk I/O run on the writer's own thread.
+    AsyncWavWriter writer;
+    if (! writer.open(outputFile, mSampleRate, numChannels, mWriterOptions))
+    {
+        mLastError = "Failed to write WAV: " + outputFile.getFullPathName();
+        return false;
+    }
+
+    //==============================================================================
+    // Run: reader on its own thread, processing on this one, writer on its own.
+    ReaderThread readerThread (*this, std::move(reader));
+
+    const BufferProcessingManager::ScopedOfflineUse offlineUse (mBPM);
+    mBPM.prepareToPlay(mSampleRate, blockSize);
+    mBPM.resetBlockLatency(mBPM.getActiveProcessor(), BufferProcessingManager::BlockPath::kOffline);
+    readerThread.startThread();
+
+    juce::MidiBuffer  midiBuffer;
+    const juce::int64 totalLength = mPreRollLength + mOutputLength;
+    juce::int64       processed   = 0;
+    bool              ok          = true;
+
+    RenderMetrics metrics;
+    metrics.overlapped = true;
+    const double processingCpuStart = RenderMetrics::getThreadCpuSeconds();
+
+    while (processed < totalLength)
+    {
+        if (control != nullptr && ! control->checkpoint())
+        {
+            mLastError = "Cancelled";
+            ok = false;
+            break;
+        }
+
+        int index = -1;
+        if (! _waitForBlock(mFilledQueue, mFilledReady, index))
+        {
+            ok = false;
+            break;
+        }
+
+        // Whole block, as in processBuffers: the last one is zero-padded and
+        // the writer keeps only numSamples.
+        auto& block = mBlocks[static_cast<size_t>(index)];
+        const double processStart = RenderMetrics::getWallSeconds();
+        mBPM.processSingleBlock(block.buffer, midiBuffer);
+        const double processEnd = RenderMetrics::getWallSeconds();
+        metrics.process.wallSeconds += processEnd - processStart;
+
+        // Pre-roll output only settles the processor's state and is dropped.
+        const int skip = static_cast<int>(juce::jlimit<juce::int64>(0, block.numSamples, mPreRollLength - processed));
+        processed += block.numSamples;
+
+        // Copies into the writer's staging buffer; only blocks if the disk is
+        // a full staging depth behind.
+        const bool written = skip == block.numSamples
+                          || writer.write(block.buffer, skip, block.numSamples - skip);
+        metrics.write.wallSeconds += RenderMetrics::getWallSeconds() - processEnd;
+
+        const bool pushed = mFreeQueue.push(index);
+        jassertquiet(pushed);
+        mFreeReady.signal();
+
+        if (! written)
+        {
+            mLastError = "Failed to write WAV: " + outputFile.getFullPathName();
+            ok = false;
+            break;
+        }
+
+        if (progressCallback)
+            progressCallback(static_cast<float>(writer.getFramesWritten()) / static_cast<float>(mOutputLength));
+    }
+
+    if (! ok)
+        _abort();
+
+    metrics.process.cpuSeconds = RenderMetrics::getThreadCpuSeconds() - processingCpuStart;
+
+    readerThread.waitForThreadToExit(-1);
+    mBPM.releaseResources();
+
+    if (mLastError.isEmpty())
+        mLastError = readerThread.getError();
+
+    if (! ok || mLastError.isNotEmpty())
+    {
+        writer.abort(); // stops the writer thread and deletes the partial file
+        return false;
+    }
+
+    const double drainStart = RenderMetrics::getWallSeconds();
+    if (! writer.close())
+    {
+        mLastError = "Failed to write WAV: " + outputFile.getFullPathName();
+        return false;
+    }
+
+    mProducerStalls = writer.getNumProducerStalls();
+
+    // Writer-thread CPU is whatever the reader and processing threads didn't use.
+    metrics.write.wallSeconds += RenderMetrics::getWallSeconds() - drainStart;
+    metrics.load.wallSeconds   = readerThread.getBusySeconds();
+    metrics.load.cpuSeconds    = readerThread.getCpuSeconds();
+    metrics.total.wallSeconds  = RenderMetrics::getWallSeconds() - startWall;
+    metrics.total.cpuSeconds   = RenderMetrics::getProcessCpuSeconds() - startCpu;
+    metrics.write.cpuSeconds   = juce::jmax(0.0, metrics.total.cpuSeconds - metrics.load.cpuSeconds - metrics.process.cpuSeconds);
+    metrics.audioSeconds       = static_cast<double>(mOutputLength) / mSampleRate;
+    metrics.peakStorageBytes   = mStorageBytes;
+    metrics.blockLatency       = mBPM.getBlockLatency(mBPM.getActiveProcessor()).getSummary();
+    metrics.memory             = memoryPeak.getSnapshot();
+    mLastMetrics = metrics;
+
+    if (progressCallback)
+        progressCallback(1.0f);
+
+    return true;
+}
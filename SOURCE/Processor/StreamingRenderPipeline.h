@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Util/Juce_Header.h"
+#include "Util/SpscQueue.h"
+#include "Util/AsyncWavWriter.h"
+#include "Util/MemoryAccounting.h"
+#include "Processor/RenderRange.h"
+#include "Processor/RenderMetrics.h"
+#include <atomic>
+#include <functional>
+
+class BufferProcessingManager;
+class RenderControl;
+
+/**
+ * @brief Streaming offline render: reader -> processor -> writer threads.
+ *
+ * The file is never held in memory. A fixed ring of kNumBlocks block buffers
+ * circulates between the reader thread and the processing stage through two
+ * bounded SPSC queues:
+ *
+ *   free -> [reader thread] -> filled -> [processing thread] -> free
+ *
+ * The thread calling render() is the processing stage; it hands each
+ * processed block to an AsyncWavWriter, whose own thread does PCM
+ * conversion and disk writes. I/O and DSP overlap, so wall time approaches
+ * max(read + write, process) instead of their sum, and peak storage is the
+ * block ring plus the writer's staging buffers however long the file is.
+ *
+ * Output matches the buffered path: input length + active processor latency +
+ * tail, at least kMinChannels wide, PCM WAV (24-bit unless configured).
+ * A RenderRange narrows this to a region: the reader starts at the region's
+ * pre-roll and the pre-roll output is processed but not written.
+ */
+class StreamingRenderPipeline
+{
+public:
+    explicit StreamingRenderPipeline(BufferProcessingManager& bpm);
+    ~StreamingRenderPipeline();
+
+    static constexpr int kNumBlocks   = 8;
+    static constexpr int kMinChannels = 2;
+
+    void setWriterOptions(const AsyncWavWriter::Options& options) { mWriterOptions = options; }
+    const AsyncWavWriter::Options& getWriterOptions() const       { return mWriterOptions; }
+
+    //==============================================================================
+    /**
+     * Streams inputFile through the active processor into outputFile.
+     * Progress (0 -> 1) follows the writer and is reported from the calling
+     * thread. On failure or cancellation any partial output is deleted and
+     * getLastError() says why ("Cancelled" for a cancelled job).
+     */
+    bool render(const juce::File& inputFile,
+                const juce::File& outputFile,
+                std::function<void(float)> progressCallback = nullptr,
+                RenderControl* control = nullptr,
+                const RenderRange& range = {});
+
+    juce::String getLastError() const { return mLastError; }
+
+    /** Block ring used by the last render, in bytes (writer staging excluded). */
+    size_t getStorageBytes() const { return mStorageBytes; }
+
+    /** Times the last render waited on the writer because the disk fell behind. */
+    int getNumWriterStalls() const { return mProducerStalls; }
+
+    /** Frames written by the last render (region + latency + tail; pre-roll excluded). */
+    juce::int64 getNumOutputSamples() const { return mOutputLength; }
+
+    double getSampleRate() const { return mSampleRate; }
+
+    /** Per-stage timing of the last successful render (overlapped phases). */
+    const RenderMetrics& getLastMetrics() const { return mLastMetrics; }
+
+private:
+    struct Block
+    {
+        juce::AudioBuffer<float> buffer;
+        int                      numSamples = 0;
+    };
+
+    class ReaderThread;
+
+    int  _resolveBlockSize(double sampleRate, int numChannels);
+    bool _waitForBlock(SpscQueue<int>& queue, juce::WaitableEvent& event, int& index);
+    void _abort();
+
+    BufferProcessingManager& mBPM;
+
+    std::vector<Block>        mBlocks;
+    MemoryAccounting::Tracked mBlockBytes { MemoryAccounting::Category::kStorage };
+    SpscQueue<int>            mFreeQueue   { kNumBlocks };
+    SpscQueue<int>            mFilledQueue { kNumBlocks };
+
+    // Signalled after every push so an idle consumer wakes without spinning.
+    juce::WaitableEvent mFreeReady;
+    juce::WaitableEvent mFilledReady;
+
+    AsyncWavWriter::Options mWriterOptions;
+
+    std::atomic<bool> mAborted { false };
+
+    juce::int64  mReadStart     = 0;
+    juce::int64  mPreRollLength = 0;
+    juce::int64  mInputLength   = 0;   // frames read from mReadStart, pre-roll included
+    juce::int64  mOutputLength  = 0;
+    double       mSampleRate    = 0.0;
+    size_t       mStorageBytes  = 0;
+    int          mProducerStalls = 0;
+    juce::String mLastError;
+
+    RenderMetrics mLastMetrics;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingRenderPipeline)
+};
@@ -5,6 +5,7 @@
 
 #include "TD_PSOLA.h"
 #include "BufferFiller.h"
+#include "Util/RenderTrace.h"
 #include <cmath>
 #include <algorithm>
 
@@ -49,25 +50,26 @@ bool TDPSOLA::process(const juce::AudioBuffer<float>& inputBuffer,
         juce::AudioBuffer<float> outputChannel(outputBuffer.getArrayOfWritePointers() + ch, 1, numSamples);
 
         // Step 1: Detect pitch periods
-        std::vector<int> periods = detectPitchPeriods(inputChannel, sampleRate, config);
+        detectPitchPeriods(inputChannel, sampleRate, config, mPeriods);
 
-        if (periods.empty())
+        if (mPeriods.empty())
             return false;
 
         // Step 2: Place pitch marks
         int hopSize = static_cast<int>(config.analysisWindowMs / 1000.0f * sampleRate);
-        std::vector<int> analysisPitchMarks = placePitchMarks(inputChannel, periods, hopSize);
+        placePitchMarks(inputChannel, mPeriods, hopSize, mAnalysisPitchMarks);
 
-        if (analysisPitchMarks.empty())
+        if (mAnalysisPitchMarks.empty())
             return false;
 
         // Step 3: Interpolate pitch marks for synthesis
-        std::vector<float> synthesisPitchMarks = interpolatePitchMarks(analysisPitchMarks, fRatio);
+        interpolatePitchMarks(mAnalysisPitchMarks, fRatio, mSynthesisPitchMarks);
 
         // Step 4: Perform PSOLA overlap-add
-        psolaOverlapAdd(inputChannel, analysisPitchMarks, synthesisPitchMarks, fRatio, outputChannel);
+        psolaOverlapAdd(inputChannel, mAnalysisPitchMarks, mSynthesisPitchMarks, fRatio, outputChannel);
     }
 
+    updateTrackedMemory();
     return true;
 }
 
@@ -101,48 +103,69 @@ bool TDPSOLA::processWithGrainExport(const juce::AudioBuffer<float>& inputBuffer
     juce::AudioBuffer<float> outputChannel(outputBuffer.getArrayOfWritePointers(), 1, numSamples);
 
     // Step 1: Detect pitch periods
-    std::vector<int> periods = detectPitchPeriods(inputChannel, sampleRate, config);
+    detectPitchPeriods(inputChannel, sampleRate, config, mPeriods);
 
-    if (periods.empty())
+    if (mPeriods.empty())
         return false;
 
     // Step 2: Place pitch marks
     int hopSize = static_cast<int>(config.analysisWindowMs / 1000.0f * sampleRate);
-    std::vector<int> analysisPitchMarks = placePitchMarks(inputChannel, periods, hopSize);
+    placePitchMarks(inputChannel, mPeriods, hopSize, mAnalysisPitchMarks);
 
-    if (analysisPitchMarks.empty())
+    if (mAnalysisPitchMarks.empty())
         return false;
 
     // Step 3: Interpolate pitch marks for synthesis
-    std::vector<float> synthesisPitchMarks = interpolatePitchMarks(analysisPitchMarks, fRatio);
+    interpolatePitchMarks(mAnalysisPitchMarks, fRatio, mSynthesisPitchMarks);
 
     // Initialize grain data
     grainData.fRatio = fRatio;
     grainData.signalLength = numSamples;
-    grainData.numAnalysisGrains = static_cast<int>(analysisPitchMarks.size());
-    grainData.numSynthesisGrains = static_cast<int>(synthesisPitchMarks.size());
+    grainData.numAnalysisGrains = static_cast<int>(mAnalysisPitchMarks.size());
+    grainData.numSynthesisGrains = static_cast<int>(mSynthesisPitchMarks.size());
     grainData.synthesisGrains.clear();
 
     // Step 4: Perform PSOLA overlap-add with grain export
-    psolaOverlapAddWithGrainExport(inputChannel, analysisPitchMarks, synthesisPitchMarks, fRatio, outputChannel, grainData);
+    psolaOverlapAddWithGrainExport(inputChannel, mAnalysisPitchMarks, mSynthesisPitchMarks, fRatio, outputChannel, grainData);
 
+    updateTrackedMemory();
     return true;
 }
 
-std::vector<int> TDPSOLA::detectPitchPeriods(const juce::AudioBuffer<float>& channelData,
-                                              float sampleRate,
-                                              const Config& config)
+void TDPSOLA::updateTrackedMemory()
+{
+    // Capacities only grow while processing, so this is also the high water.
+    auto bufferBytes = [](const juce::AudioBuffer<float>& buffer)
+    {
+        return static_cast<size_t>(buffer.getNumChannels()) * static_cast<size_t>(buffer.getNumSamples()) * sizeof(float);
+    };
+
+    const size_t bytes = mPeriods.capacity() * sizeof(int)
+                       + mAnalysisPitchMarks.capacity() * sizeof(int)
+                       + mSynthesisPitchMarks.capacity() * sizeof(double)
+                       + bufferBytes(mFFTBuffer)
+                       + bufferBytes(mWindowBuffer);
+
+    mScratchBytes.set(static_cast<juce::int64>(bytes));
+}
+
+void TDPSOLA::detectPitchPeriods(const juce::AudioBuffer<float>& channelData,
+                                 float sampleRate,
+                                 const Config& config,
+                                 std::vector<int>& periods)
 {
+    AFT_TRACE_SCOPE("detect", "psola");
+
     int numSamples = channelData.getNumSamples();
     int minPeriod = static_cast<int>(sampleRate / config.maxHz);
     int maxPeriod = static_cast<int>(sampleRate / config.minHz);
     int sequenceLength = static_cast<int>(config.analysisWindowMs / 1000.0f * sampleRate);
 
     // First pass: compute periods
-    std::vector<int> periods = computePeriodsPerSequence(channelData, sequenceLength, minPeriod, maxPeriod);
+    computePeriodsPerSequence(channelData, sequenceLength, minPeriod, maxPeriod, periods);
 
     if (periods.empty())
-        return periods;
+        return;
 
     // Calculate mean and std for period variation bounds
     float meanPeriod = 0.0f;
@@ -162,13 +185,13 @@ std::vector<int> TDPSOLA::detectPitchPeriods(const juce::AudioBuffer<float>& cha
     minPeriod = std::max(minPeriod, minVariedPeriod);
     maxPeriod = std::min(maxPeriod, maxVariedPeriod);
 
-    return computePeriodsPerSequence(channelData, sequenceLength, minPeriod, maxPeriod);
+    computePeriodsPerSequence(channelData, sequenceLength, minPeriod, maxPeriod, periods);
 }
 
-std::vector<int> TDPSOLA::computePeriodsPerSequence(const juce::AudioBuffer<float>& signal, int sequenceLength, 
-                                                    int minPeriod, int maxPeriod)
+void TDPSOLA::computePeriodsPerSequence(const juce::AudioBuffer<float>& signal, int sequenceLength,
+                                        int minPeriod, int maxPeriod, std::vector<int>& periods)
 {
-    std::vector<int> periods;
+    periods.clear();
     int numSamples = signal.getNumSamples();
     const float* signalData = signal.getReadPointer(0);
 
@@ -179,7 +202,7 @@ std::vector<int> TDPSOLA::computePeriodsPerSequence(const juce::AudioBuffer<floa
     if (!mFFT || mFFT->getSize() != fftSize)
         mFFT = std::make_unique<juce::dsp::FFT>(fftOrder);
 
-    mFFTBuffer.setSize(1, fftSize * 2, false, true, false); // Complex data needs 2x space
+    mFFTBuffer.setSize(1, fftSize * 2, false, true, true); // Complex data needs 2x space
 
     int offset = 0;
     while (offset < numSamples)
@@ -236,19 +259,20 @@ std::vector<int> TDPSOLA::computePeriodsPerSequence(const juce::AudioBuffer<floa
         periods.push_back(peakIndex);
         offset += sequenceLength;
     }
-
-    return periods;
 }
 
-std::vector<int> TDPSOLA::placePitchMarks(const juce::AudioBuffer<float>& channelData,
-                                           const std::vector<int>& periods, int hopSize)
+void TDPSOLA::placePitchMarks(const juce::AudioBuffer<float>& channelData,
+                              const std::vector<int>& periods, int hopSize,
+                              std::vector<int>& pitchMarks)
 {
-    std::vector<int> pitchMarks;
+    AFT_TRACE_SCOPE("mark", "psola");
+
+    pitchMarks.clear();
     int numSamples = channelData.getNumSamples();
     const float* signal = channelData.getReadPointer(0);
 
     if (periods.empty())
-        return pitchMarks;
+        return;
 
     // Find first peak in first period
     int firstPeriod = periods[0];
@@ -303,50 +327,56 @@ std::vector<int> TDPSOLA::placePitchMarks(const juce::AudioBuffer<float>& channe
 
         pitchMarks.push_back(peakInRange);
     }
-
-    return pitchMarks;
 }
 
-std::vector<float> TDPSOLA::interpolatePitchMarks(const std::vector<int>& pitchMarks,
-                                                   float fRatio)
+void TDPSOLA::interpolatePitchMarks(const std::vector<int>& pitchMarks,
+                                    float fRatio,
+                                    std::vector<double>& newPitchMarks)
 {
-    std::vector<float> newPitchMarks;
+    AFT_TRACE_SCOPE("interpolate", "psola");
+
+    newPitchMarks.clear();
 
     if (pitchMarks.empty())
-        return newPitchMarks;
+        return;
 
     // Generate linearly spaced reference indices
-    int numNewMarks = static_cast<int>(pitchMarks.size() * fRatio);
-    int numOriginalMarks = static_cast<int>(pitchMarks.size());
+    const juce::int64 numNewMarks      = static_cast<juce::int64>(static_cast<double>(pitchMarks.size()) * fRatio);
+    const juce::int64 numOriginalMarks = static_cast<juce::int64>(pitchMarks.size());
+    const juce::int64 denominator      = numNewMarks - 1 > 0 ? numNewMarks - 1 : 1;
 
-    for (int i = 0; i < numNewMarks; i++)
+    newPitchMarks.reserve(static_cast<size_t>(juce::jmax<juce::int64>(0, numNewMarks)));
+
+    for (juce::int64 i = 0; i < numNewMarks; i++)
     {
-        // Linear interpolation index
-        float refIndex = (i * (numOriginalMarks - 1)) / static_cast<float>(numNewMarks - 1 > 0 ? numNewMarks - 1 : 1);
+        // Linear interpolation index. 64-bit product + double: i * (N - 1) overflows
+        // int and float loses whole samples past 2^24 on multi-hour inputs.
+        double refIndex = static_cast<double>(i * (numOriginalMarks - 1)) / static_cast<double>(denominator);
 
-        int leftIdx = static_cast<int>(std::floor(refIndex));
-        int rightIdx = static_cast<int>(std::ceil(refIndex));
+        auto leftIdx  = static_cast<juce::int64>(std::floor(refIndex));
+        auto rightIdx = static_cast<juce::int64>(std::ceil(refIndex));
 
         // Clamp indices
-        leftIdx = std::clamp(leftIdx, 0, numOriginalMarks - 1);
-        rightIdx = std::clamp(rightIdx, 0, numOriginalMarks - 1);
+        leftIdx  = std::clamp<juce::int64>(leftIdx,  0, numOriginalMarks - 1);
+        rightIdx = std::clamp<juce::int64>(rightIdx, 0, numOriginalMarks - 1);
 
         // Linear interpolation
-        float weight = refIndex - leftIdx;
-        float interpolatedMark = pitchMarks[leftIdx] * (1.0f - weight) + pitchMarks[rightIdx] * weight;
+        double weight = refIndex - static_cast<double>(leftIdx);
+        double interpolatedMark = pitchMarks[static_cast<size_t>(leftIdx)] * (1.0 - weight)
+                                + pitchMarks[static_cast<size_t>(rightIdx)] * weight;
 
         newPitchMarks.push_back(interpolatedMark);
     }
-
-    return newPitchMarks;
 }
 
 void TDPSOLA::psolaOverlapAdd(const juce::AudioBuffer<float>& inputChannel,
                                const std::vector<int>& analysisPitchMarks,
-                               const std::vector<float>& synthesisPitchMarks,
+                               const std::vector<double>& synthesisPitchMarks,
                                float fRatio,
                                juce::AudioBuffer<float>& outputChannel)
 {
+    AFT_TRACE_SCOPE("overlapAdd", "psola");
+
     int numSamples = inputChannel.getNumSamples();
     const float* inputData = inputChannel.getReadPointer(0);
     float* outputData = outputChannel.getWritePointer(0);
@@ -361,13 +391,13 @@ void TDPSOLA::psolaOverlapAdd(const juce::AudioBuffer<float>& inputChannel,
     for (size_t j = 0; j < synthesisPitchMarks.size(); j++)
     {
         // Find corresponding analysis pitch mark
-        float synthMark = synthesisPitchMarks[j];
+        double synthMark = synthesisPitchMarks[j];
         size_t closestIdx = 0;
-        float minDist = std::abs(analysisPitchMarks[0] - synthMark);
+        double minDist = std::abs(analysisPitchMarks[0] - synthMark);
 
         for (size_t i = 1; i < analysisPitchMarks.size(); i++)
         {
-            float dist = std::abs(analysisPitchMarks[i] - synthMark);
+            double dist = std::abs(analysisPitchMarks[i] - synthMark);
             if (dist < minDist)
             {
                 minDist = dist;
@@ -398,8 +428,8 @@ void TDPSOLA::psolaOverlapAdd(const juce::AudioBuffer<float>& inputChannel,
 
         int windowLength = newWindowEnd - newWindowStart;
 
-        // Generate Tukey window
-        mWindowBuffer.setSize(1, windowLength, false, true, false);
+        // Generate Tukey window (reuses the allocation once it has seen the longest grain)
+        mWindowBuffer.setSize(1, windowLength, false, true, true);
         BufferFiller::generateTukey(mWindowBuffer, alpha);
 
         // Extract and apply window to original signal segment
@@ -426,11 +456,13 @@ void TDPSOLA::psolaOverlapAdd(const juce::AudioBuffer<float>& inputChannel,
 
 void TDPSOLA::psolaOverlapAddWithGrainExport(const juce::AudioBuffer<float>& inputChannel,
                                               const std::vector<int>& analysisPitchMarks,
-                                              const std::vector<float>& synthesisPitchMarks,
+                                              const std::vector<double>& synthesisPitchMarks,
                                               float fRatio,
                                               juce::AudioBuffer<float>& outputChannel,
                                               GrainData& grainData)
 {
+    AFT_TRACE_SCOPE("overlapAdd", "psola");
+
     int numSamples = inputChannel.getNumSamples();
     const float* inputData = inputChannel.getReadPointer(0);
     float* outputData = outputChannel.getWritePointer(0);
@@ -445,13 +477,13 @@ void TDPSOLA::psolaOverlapAddWithGrainExport(const juce::AudioBuffer<float>& inp
     for (size_t j = 0; j < synthesisPitchMarks.size(); j++)
     {
         // Find corresponding analysis pitch mark
-        float synthMark = synthesisPitchMarks[j];
+        double synthMark = synthesisPitchMarks[j];
         size_t closestIdx = 0;
-        float minDist = std::abs(analysisPitchMarks[0] - synthMark);
+        double minDist = std::abs(analysisPitchMarks[0] - synthMark);
 
         for (size_t i = 1; i < analysisPitchMarks.size(); i++)
         {
-            float dist = std::abs(analysisPitchMarks[i] - synthMark);
+            double dist = std::abs(analysisPitchMarks[i] - synthMark);
             if (dist < minDist)
             {
                 minDist = dist;
@@ -482,8 +514,8 @@ void TDPSOLA::psolaOverlapAddWithGrainExport(const juce::AudioBuffer<float>& inp
 
         int windowLength = newWindowEnd - newWindowStart;
 
-        // Generate Tukey window
-        mWindowBuffer.setSize(1, windowLength, false, true, false);
+        // Generate Tukey window (reuses the allocation once it has seen the longest grain)
+        mWindowBuffer.setSize(1, windowLength, false, true, true);
         BufferFiller::generateTukey(mWindowBuffer, alpha);
 
         // Extract and apply window to original signal segment
@@ -7,11 +7,16 @@
  *
  * This implementation focuses on offline processing of audio buffers.
  * No threading or circular buffering - designed for simple buffer-in, buffer-out processing.
+ *
+ * The whole signal is analysed at once from an int-indexed AudioBuffer, so
+ * inputs are limited to 2^31 - 1 samples per channel (about 12 hours at
+ * 48 kHz). Pitch marks, periods and exported GrainData positions are int.
  */
 
 #pragma once
 
 #include "Util/Juce_Header.h"
+#include "Util/MemoryAccounting.h"
 #include "GrainExport.h"
 #include <vector>
 
@@ -81,11 +86,12 @@ private:
      * @param channelData Input signal (single channel)
      * @param sampleRate Sample rate in Hz
      * @param config Detection configuration
-     * @return Vector of period lengths in samples, one per analysis window
+     * @param periods Receives period lengths in samples, one per analysis window
      */
-    std::vector<int> detectPitchPeriods(const juce::AudioBuffer<float>& channelData,
-                                         float sampleRate,
-                                         const Config& config);
+    void detectPitchPeriods(const juce::AudioBuffer<float>& channelData,
+                            float sampleRate,
+                            const Config& config,
+                            std::vector<int>& periods);
 
     /**
      * @brief Place pitch marks at signal peaks based on detected periods
@@ -95,21 +101,24 @@ private:
      * @param channelData Input signal
      * @param periods Detected pitch periods
      * @param hopSize Hop size used for period detection
-     * @return Vector of pitch mark sample indices
+     * @param pitchMarks Receives pitch mark sample indices
      */
-    std::vector<int> placePitchMarks(const juce::AudioBuffer<float>& channelData,
-                                      const std::vector<int>& periods,
-                                      int hopSize);
+    void placePitchMarks(const juce::AudioBuffer<float>& channelData,
+                         const std::vector<int>& periods,
+                         int hopSize,
+                         std::vector<int>& pitchMarks);
 
     /**
      * @brief Interpolate pitch marks to generate synthesis positions
      *
      * @param pitchMarks Original analysis pitch marks
      * @param fRatio Pitch shift ratio
-     * @return Vector of synthesis pitch mark positions
+     * @param newPitchMarks Receives synthesis pitch mark positions (double: float
+     *        drops whole samples beyond 2^24, i.e. a few minutes of audio)
      */
-    std::vector<float> interpolatePitchMarks(const std::vector<int>& pitchMarks,
-                                              float fRatio);
+    void interpolatePitchMarks(const std::vector<int>& pitchMarks,
+                               float fRatio,
+                               std::vector<double>& newPitchMarks);
 
     /**
      * @brief Core PSOLA overlap-add algorithm
@@ -122,7 +131,7 @@ private:
      */
     void psolaOverlapAdd(const juce::AudioBuffer<float>& inputChannel,
                          const std::vector<int>& analysisPitchMarks,
-                         const std::vector<float>& synthesisPitchMarks,
+                         const std::vector<double>& synthesisPitchMarks,
                          float fRatio,
                          juce::AudioBuffer<float>& outputChannel);
 
@@ -138,18 +147,24 @@ private:
      */
     void psolaOverlapAddWithGrainExport(const juce::AudioBuffer<float>& inputChannel,
                                          const std::vector<int>& analysisPitchMarks,
-                                         const std::vector<float>& synthesisPitchMarks,
+                                         const std::vector<double>& synthesisPitchMarks,
                                          float fRatio,
                                          juce::AudioBuffer<float>& outputChannel,
                                          GrainData& grainData);
 
+    /**
+     * @brief Reports the analysis vectors and scratch buffers to MemoryAccounting
+     */
+    void updateTrackedMemory();
+
     /**
      * @brief Compute periods using autocorrelation per analysis window
      */
-    std::vector<int> computePeriodsPerSequence(const juce::AudioBuffer<float>& signal,
-                                                int sequenceLength,
-                                                int minPeriod,
-                                                int maxPeriod);
+    void computePeriodsPerSequence(const juce::AudioBuffer<float>& signal,
+                                   int sequenceLength,
+                                   int minPeriod,
+                                   int maxPeriod,
+                                   std::vector<int>& periods);
 
     // FFT for autocorrelation
     std::unique_ptr<juce::dsp::FFT> mFFT;
@@ -157,6 +172,14 @@ private:
 
     // Reusable window buffer
     juce::AudioBuffer<float> mWindowBuffer;
+
+    // Per-channel analysis results, kept so that repeated renders of the same
+    // length reuse their capacity instead of allocating.
+    std::vector<int>    mPeriods;
+    std::vector<int>    mAnalysisPitchMarks;
+    std::vector<double> mSynthesisPitchMarks;
+
+    MemoryAccounting::Tracked mScratchBytes { MemoryAccounting::Category::kPsola };
 };
 
 } // namespace TD_PSOLA
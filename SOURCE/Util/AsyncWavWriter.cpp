@@ -0,0 +1,367 @@
+#include "AsyncWavWriter.h"
+#include "RenderTrace.h"
+
+namespace
+{
+    constexpr juce::int64 kMaxRiffSize = 0xFFFFFFFFLL;
+
+    // RIFF header is padded with a JUNK chunk the size of ds64 so it can be
+    // rewritten as RF64 in place.
+    constexpr int kDs64Size = 28;
+
+    // KSDATAFORMAT_SUBTYPE_PCM
+    constexpr juce::uint8 kPcmSubFormat[16] = { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+                                                0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 };
+
+    int chunkName(const char* name)
+    {
+        return static_cast<int>(juce::ByteOrder::littleEndianInt(name));
+    }
+}
+
+//==============================================================================
+class AsyncWavWriter::WriterThread : public juce::Thread
+{
+public:
+    explicit WriterThread(AsyncWavWriter& owner)
+        : juce::Thread("AsyncWavWriter")
+        , mOwner(owner)
+    {
+    }
+
+    void run() override
+    {
+        AFT_TRACE_THREAD();
+
+        for (;;)
+        {
+            int index = -1;
+            if (mOwner.mFilledQueue->pop(index))
+            {
+                auto& slot = mOwner.mSlots[static_cast<size_t>(index)];
+
+                // After a failure (or abort) keep recycling slots so the producer never wedges.
+                if (! mOwner.mFailed.load() && ! mOwner._convertAndWrite(slot))
+                    mOwner.mFailed.store(true);
+
+                slot.numFrames = 0;
+                mOwner.mFreeQueue->push(index);
+                mOwner.mFreeReady.signal();
+                continue;
+            }
+
+            // mClosing is set after the producer's last push, so empty + closing means done.
+            if (mOwner.mClosing.load() && mOwner.mFilledQueue->isEmpty())
+                return;
+
+            mOwner.mFilledReady.wait(5);
+        }
+    }
+
+private:
+    AsyncWavWriter& mOwner;
+};
+
+//==============================================================================
+AsyncWavWriter::AsyncWavWriter() {}
+
+AsyncWavWriter::~AsyncWavWriter()
+{
+    // An unclosed writer is treated as abandoned output.
+    if (isOpen())
+        abort();
+}
+
+//==============================================================================
+bool AsyncWavWriter::open(const juce::File& wavFile, double sampleRate, int numChannels)
+{
+    return open(wavFile, sampleRate, numChannels, Options());
+}
+
+bool AsyncWavWriter::open(const juce::File& wavFile, double sampleRate, int numChannels, const Options& options)
+{
+    jassert(! isOpen());
+    if (isOpen())
+        return false;
+
+    if (sampleRate <= 0.0 || numChannels <= 0
+        || (options.bitDepth != 16 && options.bitDepth != 24)
+        || options.numBuffers < 2 || options.bufferFrames <= 0)
+        return false;
+
+    mFile        = wavFile;
+    mOptions     = options;
+    mSampleRate  = sampleRate;
+    mNumChannels = numChannels;
+
+    mFile.deleteFile();
+    mStream = std::make_unique<juce::FileOutputStream>(mFile);
+    if (mStream->failedToOpen())
+    {
+        mStream.reset();
+        return false;
+    }
+
+    mSlots.resize(static_cast<size_t>(options.numBuffers));
+    for (auto& slot : mSlots)
+    {
+        slot.audio.setSize(numChannels, options.bufferFrames, false, false, true);
+        slot.numFrames = 0;
+    }
+
+    mFreeQueue   = std::make_unique<SpscQueue<int>>(options.numBuffers);
+    mFilledQueue = std::make_unique<SpscQueue<int>>(options.numBuffers);
+    for (int i = 0; i < options.numBuffers; ++i)
+        mFreeQueue->push(i);
+
+    mScaled.allocate(static_cast<size_t>(options.bufferFrames), false);
+    mPcm   .allocate(static_cast<size_t>(options.bufferFrames) * static_cast<size_t>(_getBytesPerFrame()), false);
+
+    const auto frames = static_cast<juce::int64>(options.bufferFrames);
+    mStagingBytes.set(frames * (options.numBuffers * numChannels + 1) * static_cast<juce::int64>(sizeof(float))
+                      + frames * _getBytesPerFrame());
+
+    mCurrentSlot    = -1;
+    mDitherState    = 0x9E3779B9u;
+    mFramesQueued   = 0;
+    mProducerStalls = 0;
+    mFramesWritten.store(0);
+    mFailed.store(false);
+    mClosing.store(false);
+    mFreeReady.reset();
+    mFilledReady.reset();
+
+    if (! _writeHeader(0))
+    {
+        mStream.reset();
+        mFile.deleteFile();
+        return false;
+    }
+
+    mThread = std::make_unique<WriterThread>(*this);
+    mThread->startThread();
+    return true;
+}
+
+//==============================================================================
+bool AsyncWavWriter::write(const juce::AudioBuffer<float>& source, int startSample, int numSamples)
+{
+    if (! isOpen() || mFailed.load())
+        return false;
+
+    const int sourceChannels = source.getNumChannels();
+    if (sourceChannels == 0)
+        return false;
+
+    int done = 0;
+    while (done < numSamples)
+    {
+        if (mCurrentSlot < 0 && ! mFreeQueue->pop(mCurrentSlot))
+        {
+            // Every staging buffer is queued: the disk is numBuffers behind.
+            ++mProducerStalls;
+            while (! mFreeQueue->pop(mCurrentSlot))
+            {
+                if (mFailed.load())
+                    return false;
+                mFreeReady.wait(5);
+            }
+        }
+
+        auto& slot = mSlots[static_cast<size_t>(mCurrentSlot)];
+        const int n = juce::jmin(mOptions.bufferFrames - slot.numFrames, numSamples - done);
+
+        for (int ch = 0; ch < mNumChannels; ++ch)
+            slot.audio.copyFrom(ch, slot.numFrames, source, juce::jmin(ch, sourceChannels - 1), startSample + done, n);
+
+        slot.numFrames += n;
+        done           += n;
+        mFramesQueued  += n;
+
+        if (slot.numFrames == mOptions.bufferFrames)
+        {
+            mFilledQueue->push(mCurrentSlot);
+            mFilledReady.signal();
+            mCurrentSlot = -1;
+        }
+    }
+
+    return ! mFailed.load();
+}
+
+bool AsyncWavWriter::close()
+{
+    return _finish(true);
+}
+
+void AsyncWavWriter::abort()
+{
+    _finish(false);
+}
+
+bool AsyncWavWriter::_finish(bool keepFile)
+{
+    if (! isOpen())
+        return false;
+
+    AFT_TRACE_SCOPE("writerDrain", "io");
+
+    if (mCurrentSlot >= 0)
+    {
+        if (keepFile && mSlots[static_cast<size_t>(mCurrentSlot)].numFrames > 0)
+        {
+            mFilledQueue->push(mCurrentSlot);
+            mFilledReady.signal();
+        }
+        else
+        {
+            // Only the writer thread pushes to the free queue; open() rebuilds it anyway.
+            mSlots[static_cast<size_t>(mCurrentSlot)].numFrames = 0;
+        }
+        mCurrentSlot = -1;
+    }
+
+    if (! keepFile)
+        mFailed.store(true); // writer thread drops anything still queued
+
+    mClosing.store(true);
+    mFilledReady.signal();
+    mThread->waitForThreadToExit(-1);
+    mThread.reset();
+
+    bool ok = keepFile && ! mFailed.load();
+    if (ok)
+    {
+        const juce::int64 dataBytes = mFramesWritten.load() * _getBytesPerFrame();
+        if ((dataBytes & 1) != 0)
+            ok = mStream->writeByte(0);
+
+        ok = ok && _writeHeader(dataBytes);
+        mStream->flush();
+        ok = ok && mStream->getStatus().wasOk();
+    }
+
+    mStream.reset();
+    mClosing.store(false);
+
+    if (! ok)
+        mFile.deleteFile();
+
+    return ok;
+}
+
+//==============================================================================
+bool AsyncWavWriter::_convertAndWrite(Slot& slot)
+{
+    AFT_TRACE_SCOPE("writeChunk", "io");
+
+    const int   numFrames      = slot.numFrames;
+    const int   bytesPerSample = mOptions.bitDepth / 8;
+    const int   bytesPerFrame  = _getBytesPerFrame();
+    const float scale          = static_cast<float>((1 << (mOptions.bitDepth - 1)) - 1);
+
+    for (int ch = 0; ch < mNumChannels; ++ch)
+    {
+        float* scaled = mScaled.get();
+        juce::FloatVectorOperations::multiply(scaled, slot.audio.getReadPointer(ch), scale, numFrames);
+
+        if (mOptions.dither)
+        {
+            // TPDF: difference of two uniforms, +-1 LSB, from a per-writer xorshift.
+            auto uniform = [this]
+            {
+                mDitherState ^= mDitherState << 13;
+                mDitherState ^= mDitherState >> 17;
+                mDitherState ^= mDitherState << 5;
+                return static_cast<float>(mDitherState >> 8) * (1.0f / 16777216.0f);
+            };
+
+            for (int i = 0; i < numFrames; ++i)
+                scaled[i] += uniform() - uniform();
+        }
+
+        juce::FloatVectorOperations::clip(scaled, scaled, -scale, scale, numFrames);
+
+        char* dest = mPcm.get() + ch * bytesPerSample;
+        if (bytesPerSample == 3)
+        {
+            for (int i = 0; i < numFrames; ++i, dest += bytesPerFrame)
+            {
+                const int v = juce::roundToInt(scaled[i]);
+                dest[0] = static_cast<char>(v);
+                dest[1] = static_cast<char>(v >> 8);
+                dest[2] = static_cast<char>(v >> 16);
+            }
+        }
+        else
+        {
+            for (int i = 0; i < numFrames; ++i, dest += bytesPerFrame)
+            {
+                const int v = juce::roundToInt(scaled[i]);
+                dest[0] = static_cast<char>(v);
+                dest[1] = static_cast<char>(v >> 8);
+            }
+        }
+    }
+
+    // One write per staging buffer: bufferFrames x bytesPerFrame bytes.
+    if (! mStream->write(mPcm.get(), static_cast<size_t>(numFrames) * static_cast<size_t>(bytesPerFrame)))
+        return false;
+
+    mFramesWritten.store(mFramesWritten.load() + numFrames);
+    return true;
+}
+
+bool AsyncWavWriter::_writeHeader(juce::int64 dataBytes)
+{
+    const bool  isExtensible  = mNumChannels > 2;
+    const int   fmtSize       = isExtensible ? 40 : 16;
+    const int   headerSize    = 12 + (8 + kDs64Size) + (8 + fmtSize) + 8;
+    const auto  riffSize      = static_cast<juce::int64>(headerSize - 8) + dataBytes + (dataBytes & 1);
+    const bool  isRF64        = riffSize > kMaxRiffSize;
+    const int   bytesPerFrame = _getBytesPerFrame();
+
+    if (! mStream->setPosition(0))
+        return false;
+
+    auto& out = *mStream;
+
+    out.writeInt(chunkName(isRF64 ? "RF64" : "RIFF"));
+    out.writeInt(isRF64 ? -1 : static_cast<int>(static_cast<juce::uint32>(riffSize)));
+    out.writeInt(chunkName("WAVE"));
+
+    out.writeInt(chunkName(isRF64 ? "ds64" : "JUNK"));
+    out.writeInt(kDs64Size);
+    if (isRF64)
+    {
+        out.writeInt64(riffSize);
+        out.writeInt64(dataBytes);
+        out.writeInt64(dataBytes / bytesPerFrame);
+        out.writeInt(0); // table length
+    }
+    else
+    {
+        out.writeRepeatedByte(0, kDs64Size);
+    }
+
+    out.writeInt(chunkName("fmt "));
+    out.writeInt(fmtSize);
+    out.writeShort(static_cast<short>(isExtensible ? 0xFFFE : 1));
+    out.writeShort(static_cast<short>(mNumChannels));
+    out.writeInt(static_cast<int>(mSampleRate));
+    out.writeInt(static_cast<int>(mSampleRate) * bytesPerFrame);
+    out.writeShort(static_cast<short>(bytesPerFrame));
+    out.writeShort(static_cast<short>(mOptions.bitDepth));
+    if (isExtensible)
+    {
+        out.writeShort(22);                                        // cbSize
+        out.writeShort(static_cast<short>(mOptions.bitDepth));    // valid bits
+        out.writeInt(mNumChannels < 32 ? (1 << mNumChannels) - 1 : 0);
+        out.write(kPcmSubFormat, sizeof(kPcmSubFormat));
+    }
+
+    out.writeInt(chunkName("data"));
+    out.writeInt(isRF64 ? -1 : static_cast<int>(static_cast<juce::uint32>(dataBytes)));
+
+    return out.getStatus().wasOk() && out.getPosition() == headerSize;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Juce_Header.h"
+#include "SpscQueue.h"
+#include "MemoryAccounting.h"
+#include <atomic>
+
+/**
+ * Asynchronous PCM WAV writer.
+ *
+ * The producer (render thread) appends float blocks with write(); they are
+ * copied into one of numBuffers staging buffers and handed to a dedicated
+ * writer thread, which converts float -> 16/24-bit PCM (optional TPDF
+ * dither, FloatVectorOperations scale + clip) and writes each staging
+ * buffer to disk in a single large write. write() only blocks when every
+ * staging buffer is queued, i.e. when the disk is more than numBuffers
+ * behind the producer.
+ *
+ * The header reserves a JUNK chunk that close() turns into ds64, so output
+ * beyond 4 GB is finalised as RF64 like JUCE's own WAV writer.
+ *
+ * Staging and conversion buffers count as MemoryAccounting storage from
+ * open() until the writer is destroyed.
+ */
+class AsyncWavWriter
+{
+public:
+    struct Options
+    {
+        int  bitDepth     = 24;       // 16 or 24
+        bool dither       = false;    // TPDF, +-1 LSB, applied before quantisation
+        int  numBuffers   = 3;        // double/triple buffering depth
+        int  bufferFrames = 65536;    // frames per staging buffer (and per disk write)
+    };
+
+    AsyncWavWriter();
+    ~AsyncWavWriter();
+
+    /** Replaces wavFile and starts the writer thread. */
+    bool open(const juce::File& wavFile, double sampleRate, int numChannels, const Options& options);
+    bool open(const juce::File& wavFile, double sampleRate, int numChannels);
+
+    /**
+     * Queues numSamples frames of source (from startSample) for writing. The
+     * first getNumChannels() channels are used. Returns false once the writer
+     * has failed or the file is not open.
+     */
+    bool write(const juce::AudioBuffer<float>& source, int startSample, int numSamples);
+
+    /** Flushes queued audio, finalises the header and closes the file. */
+    bool close();
+
+    /** Stops the writer thread, closes and deletes the partial file. */
+    void abort();
+
+    bool        isOpen()           const { return mThread != nullptr; }
+    bool        hasFailed()        const { return mFailed.load(); }
+    int         getNumChannels()   const { return mNumChannels; }
+    juce::int64 getFramesQueued()  const { return mFramesQueued; }
+    juce::int64 getFramesWritten() const { return mFramesWritten.load(); }
+
+    /** Times write() had to wait for a free staging buffer. */
+    int getNumProducerStalls() const { return mProducerStalls; }
+
+private:
+    struct Slot
+    {
+        juce::AudioBuffer<float> audio;
+        int                      numFrames = 0;
+    };
+
+    class WriterThread;
+
+    int  _getBytesPerFrame() const { return mNumChannels * (mOptions.bitDepth / 8); }
+    bool _writeHeader(juce::int64 dataBytes);
+    bool _convertAndWrite(Slot& slot);
+    bool _finish(bool keepFile);
+
+    juce::File                              mFile;
+    std::unique_ptr<juce::FileOutputStream> mStream;
+    std::unique_ptr<WriterThread>           mThread;
+
+    Options mOptions;
+    double  mSampleRate  = 0.0;
+    int     mNumChannels = 0;
+
+    std::vector<Slot>               mSlots;
+    std::unique_ptr<SpscQueue<int>> mFreeQueue;    // producer <- writer thread
+    std::unique_ptr<SpscQueue<int>> mFilledQueue;  // producer -> writer thread
+    int                             mCurrentSlot = -1;
+
+    juce::WaitableEvent mFreeReady;
+    juce::WaitableEvent mFilledReady;
+
+    // Writer-thread scratch: one channel of scaled floats, interleaved PCM bytes.
+    juce::HeapBlock<float> mScaled;
+    juce::HeapBlock<char>  mPcm;
+    juce::uint32           mDitherState = 0x9E3779B9u;
+
+    MemoryAccounting::Tracked mStagingBytes { MemoryAccounting::Category::kStorage };
+
+    juce::int64              mFramesQueued   = 0;
+    std::atomic<juce::int64> mFramesWritten  { 0 };
+    std::atomic<bool>        mFailed         { false };
+    std::atomic<bool>        mClosing        { false };
+    int                      mProducerStalls = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AsyncWavWriter)
+};
@@ -0,0 +1,340 @@
+#include "BinaryBlockLogger.h"
+#include <cstring>
+
+namespace
+{
+    constexpr char         kMagic[8]         = { 'A', 'F', 'T', 'B', 'L', 'O', 'G', '1' };
+    constexpr juce::uint32 kVersion          = 1;
+    constexpr int          kWriteBufferBytes = 256 * 1024;
+
+    // SplitMix64 finaliser: a stateless, well-mixed hash of the block index.
+    juce::uint64 mixBits(juce::uint64 x) noexcept
+    {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+}
+
+//==============================================================================
+class BinaryBlockLogger::DrainThread : public juce::Thread
+{
+public:
+    explicit DrainThread(BinaryBlockLogger& owner)
+        : juce::Thread("BinaryBlockLogger")
+        , mOwner(owner)
+    {
+    }
+
+    void run() override
+    {
+        for (;;)
+        {
+            bool drainedAny = false;
+            while (mOwner.mRing->pop(mRecord))
+            {
+                drainedAny = true;
+
+                // After a failed write keep popping so the producer never backs up.
+                if (mOwner.mFailed.load())
+                    continue;
+
+                if (mOwner.mStream->write(&mRecord, sizeof(Record)))
+                    mOwner.mWritten.fetch_add(1);
+                else
+                    mOwner.mFailed.store(true);
+            }
+
+            // mClosing is set once no producer can push, so empty + closing means done.
+            if (mOwner.mClosing.load() && mOwner.mRing->isEmpty())
+                return;
+
+            // Polled rather than signalled: waking this thread would lock on the producer side.
+            if (! drainedAny)
+                wait(2);
+        }
+    }
+
+private:
+    BinaryBlockLogger& mOwner;
+    Record             mRecord {};
+};
+
+//==============================================================================
+BinaryBlockLogger::BinaryBlockLogger() {}
+
+BinaryBlockLogger::~BinaryBlockLogger()
+{
+    close();
+}
+
+void BinaryBlockLogger::setSampling(const Sampling& sampling)
+{
+    jassert(mThread == nullptr);
+    if (mThread != nullptr)
+        return;
+
+    mSampling             = sampling;
+    mSampling.everyNth    = juce::jmax(1, sampling.everyNth);
+    mSampling.probability = juce::jlimit(0.0, 1.0, sampling.probability);
+    mSampleThreshold      = static_cast<juce::uint64>(mSampling.probability * 9007199254740992.0);   // 2^53
+}
+
+bool BinaryBlockLogger::isBlockSampled(juce::uint32 blockIndex) const noexcept
+{
+    if (blockIndex % static_cast<juce::uint32>(mSampling.everyNth) != 0)
+        return false;
+
+    if (mSampling.probability >= 1.0)
+        return true;
+
+    const auto hash = mixBits(mSampling.seed + (static_cast<juce::uint64>(blockIndex) + 1) * 0x9e3779b97f4a7c15ULL);
+    return (hash >> 11) < mSampleThreshold;
+}
+
+bool BinaryBlockLogger::open(const juce::File& logFile, int ringRecords)
+{
+    jassert(mThread == nullptr);
+    if (mThread != nullptr)
+        return false;
+
+    mFile = logFile;
+    mLastError.clear();
+
+    mFile.deleteFile();
+    mStream = std::make_unique<juce::FileOutputStream>(mFile, kWriteBufferBytes);
+    if (mStream->failedToOpen())
+    {
+        mLastError = "Failed to open block log: " + mFile.getFullPathName();
+        mStream.reset();
+        return false;
+    }
+
+    mRing = std::make_unique<SpscQueue<Record>>(juce::jmax(1, ringRecords));
+    mBlockIndex = 0;
+    mDropped.store(0);
+    mWritten.store(0);
+    mSampledBlocks.store(0);
+    mFailed.store(false);
+    mClosing.store(false);
+
+    if (! _writeHeader())
+    {
+        mLastError = "Failed to write block log header: " + mFile.getFullPathName();
+        mStream.reset();
+        mRing.reset();
+        mFile.deleteFile();
+        return false;
+    }
+
+    mRingBytes.set(static_cast<juce::int64>(juce::jmax(1, ringRecords)) * static_cast<juce::int64>(sizeof(Record))
+                   + kWriteBufferBytes);
+
+    mThread = std::make_unique<DrainThread>(*this);
+    mThread->startThread();
+    mActive.store(true);
+    return true;
+}
+
+bool BinaryBlockLogger::close()
+{
+    if (mThread == nullptr)
+        return false;
+
+    // Seq-cst pairs with logBlock(): either it sees mActive false, or we see it counted.
+    mActive.store(false);
+    while (mProducers.load() > 0)
+        juce::Thread::yield();
+
+    mClosing.store(true);
+    mThread->notify();
+    mThread->waitForThreadToExit(-1);
+    mThread.reset();
+
+    bool ok = ! mFailed.load() && _writeHeader();
+    mStream->flush();
+    ok = ok && mStream->getStatus().wasOk();
+
+    mStream.reset();
+    mRing.reset();
+    mRingBytes.set(0);
+
+    if (! ok)
+        mLastError = "Failed to write block log: " + mFile.getFullPathName();
+
+    return ok;
+}
+
+void BinaryBlockLogger::logBlock(Stage stage, int processor, const juce::AudioBuffer<float>& buffer,
+                                 bool waitIfFull, int numSamples) noexcept
+{
+    // Counted before the mActive check so close() can wait for us.
+    mProducers.fetch_add(1);
+
+    if (mActive.load())
+    {
+        if (isBlockSampled(mBlockIndex))
+        {
+            const int total = numSamples < 0 ? buffer.getNumSamples() : juce::jmin(numSamples, buffer.getNumSamples());
+
+            Record record {};
+            record.blockIndex = mBlockIndex;
+            record.stage      = static_cast<juce::uint8>(stage);
+            record.processor  = static_cast<juce::uint8>(processor);
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            {
+                for (int first = 0; first < total; first += kValuesPerRecord)
+                {
+                    const int n = juce::jmin(kValuesPerRecord, total - first);
+
+                    record.channel     = static_cast<juce::uint16>(ch);
+                    record.firstSample = static_cast<juce::uint32>(first);
+                    record.numValues   = static_cast<juce::uint16>(n);
+                    juce::FloatVectorOperations::copy(record.values, buffer.getReadPointer(ch, first), n);
+
+                    while (! mRing->push(record))
+                    {
+                        if (! waitIfFull || mFailed.load())
+                        {
+                            mDropped.fetch_add(1);
+                            break;
+                        }
+                        juce::Thread::yield();
+                    }
+                }
+            }
+
+            if (stage == Stage::kOutput)
+                mSampledBlocks.fetch_add(1);
+        }
+
+        // Skipped blocks advance too, so kept ones keep their real index.
+        if (stage == Stage::kOutput)
+            ++mBlockIndex;
+    }
+
+    mProducers.fetch_sub(1);
+}
+
+bool BinaryBlockLogger::_writeHeader()
+{
+    FileHeader header {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version           = kVersion;
+    header.recordSize        = static_cast<juce::uint32>(sizeof(Record));
+    header.numRecords        = mWritten.load();
+    header.numDropped        = mDropped.load();
+    header.sampleEveryNth    = static_cast<juce::uint32>(mSampling.everyNth);
+    header.sampleProbability = static_cast<float>(mSampling.probability);
+
+    const auto end = juce::jmax(mStream->getPosition(), static_cast<juce::int64>(sizeof(FileHeader)));
+    return mStream->setPosition(0)
+        && mStream->write(&header, sizeof(header))
+        && mStream->setPosition(end);
+}
+
+//==============================================================================
+bool BinaryBlockLogger::convertToCsv(const juce::File& logFile, const juce::File& outputDir, juce::String& error)
+{
+    juce::FileInputStream in(logFile);
+    if (! in.openedOk())
+    {
+        error = "Failed to open block log: " + logFile.getFullPathName();
+        return false;
+    }
+
+    FileHeader header {};
+    if (in.read(&header, sizeof(header)) != static_cast<int>(sizeof(header))
+        || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0
+        || header.version != kVersion
+        || header.recordSize != sizeof(Record))
+    {
+        error = "Not a block log: " + logFile.getFullPathName();
+        return false;
+    }
+
+    if (outputDir.createDirectory().failed())
+    {
+        error = "Failed to create output directory: " + outputDir.getFullPathName();
+        return false;
+    }
+
+    struct Row
+    {
+        bool         open       = false;
+        juce::uint32 block      = 0;
+        juce::uint32 nextSample = 0;
+        juce::uint16 channel    = 0;
+        juce::uint8  processor  = 0;
+    };
+
+    const char* names[2] = { "input_samples.csv", "output_samples.csv" };
+    std::unique_ptr<juce::FileOutputStream> outs[2];
+    Row rows[2];
+
+    for (int i = 0; i < 2; ++i)
+    {
+        const auto file = outputDir.getChildFile(names[i]);
+        file.deleteFile();
+        outs[i] = std::make_unique<juce::FileOutputStream>(file, kWriteBufferBytes);
+        if (outs[i]->failedToOpen())
+        {
+            error = "Failed to write " + file.getFullPathName();
+            return false;
+        }
+        *outs[i] << "block,processor,channel,samples\n";
+    }
+
+    Record record {};
+    while (in.read(&record, sizeof(Record)) == static_cast<int>(sizeof(Record)))
+    {
+        if (record.stage > 1 || record.numValues > kValuesPerRecord)
+        {
+            error = "Corrupt record in " + logFile.getFullPathName();
+            return false;
+        }
+
+        auto& out = *outs[record.stage];
+        auto& row = rows[record.stage];
+
+        const bool continuesRow = row.open
+                               && row.block      == record.blockIndex
+                               && row.channel    == record.channel
+                               && row.processor  == record.processor
+                               && row.nextSample == record.firstSample;
+        if (! continuesRow)
+        {
+            if (row.open)
+                out << "\n";
+
+            out << juce::String(record.blockIndex) << "," << juce::String(record.processor)
+                << "," << juce::String(record.channel);
+
+            row.open      = true;
+            row.block     = record.blockIndex;
+            row.channel   = record.channel;
+            row.processor = record.processor;
+        }
+
+        for (int i = 0; i < record.numValues; ++i)
+            out << "," << juce::String(record.values[i]);
+
+        row.nextSample = record.firstSample + record.numValues;
+    }
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (rows[i].open)
+            *outs[i] << "\n";
+
+        outs[i]->flush();
+        if (! outs[i]->getStatus().wasOk())
+        {
+            error = "Failed to write " + outputDir.getChildFile(names[i]).getFullPathName();
+            return false;
+        }
+    }
+
+    return true;
+}
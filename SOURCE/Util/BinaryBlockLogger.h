@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Juce_Header.h"
+#include "SpscQueue.h"
+#include "MemoryAccounting.h"
+#include <atomic>
+
+/**
+ * Per-block sample logging without file I/O on the processing thread.
+ *
+ * The alternative to RD_Processor's setIsBlockLogging(true), which appends
+ * CSV synchronously from processBlock. logBlock() splits each channel of a
+ * block into fixed-size Records and pushes them into a ring preallocated by
+ * open(); a drain thread writes them to a compact binary file. The producer
+ * never locks, allocates or touches the filesystem: when the ring is full it
+ * either drops the record (counted, for the audio thread) or yields until the
+ * drain catches up (offline renders, which would rather be slower than lossy).
+ *
+ * One producer thread at a time. convertToCsv() turns a finished log into
+ * input_samples.csv / output_samples.csv offline.
+ *
+ * setSampling() keeps long renders to a manageable size: every Nth block, a
+ * seeded random fraction of blocks, or both. The choice is a pure function of
+ * the block index, so input and output of a block are always kept together
+ * and the same seed picks the same blocks on every run. Skipped blocks still
+ * advance the index, so CSV rows carry the real block numbers.
+ *
+ * File layout (host byte order): a 64-byte FileHeader, then Records back to
+ * back. close() fills in the record and drop counts; a log cut short by a
+ * crash still converts, its header just reads zero.
+ */
+class BinaryBlockLogger
+{
+public:
+    enum class Stage : juce::uint8 { kInput = 0, kOutput = 1 };
+
+    static constexpr int kValuesPerRecord    = 252;
+    static constexpr int kDefaultRingRecords = 4096;  // 4 MB
+
+    struct Record
+    {
+        juce::uint32 blockIndex;
+        juce::uint32 firstSample;   // offset of values[0] within the block
+        juce::uint16 channel;
+        juce::uint16 numValues;
+        juce::uint8  stage;
+        juce::uint8  processor;
+        juce::uint16 reserved;
+        float        values[kValuesPerRecord];
+    };
+    static_assert(sizeof(Record) == 1024, "Records are a fixed 1 KiB on disk");
+
+    struct FileHeader
+    {
+        char         magic[8];      // "AFTBLOG1"
+        juce::uint32 version;
+        juce::uint32 recordSize;
+        juce::int64  numRecords;
+        juce::int64  numDropped;
+        juce::uint32 sampleEveryNth;       // 0 in logs written before sampling
+        float        sampleProbability;
+        juce::uint8  reserved[24];
+    };
+    static_assert(sizeof(FileHeader) == 64, "Header is a fixed 64 bytes on disk");
+
+    struct Sampling
+    {
+        int          everyNth    = 1;     // keep blocks 0, N, 2N, ...
+        double       probability = 1.0;   // then keep this fraction of those
+        juce::uint64 seed        = 0;
+
+        bool logsEveryBlock() const { return everyNth <= 1 && probability >= 1.0; }
+    };
+
+    BinaryBlockLogger();
+    ~BinaryBlockLogger();
+
+    /** Applies from the next open(); ignored while open. */
+    void     setSampling(const Sampling& sampling);
+    Sampling getSampling() const { return mSampling; }
+
+    /** True if the sampling policy keeps blockIndex. */
+    bool isBlockSampled(juce::uint32 blockIndex) const noexcept;
+
+    /** Replaces logFile, allocates the ring and starts the drain thread. Not for the audio thread. */
+    bool open(const juce::File& logFile, int ringRecords = kDefaultRingRecords);
+
+    /** Waits out an in-flight logBlock(), drains the ring and finalises the header. */
+    bool close();
+
+    bool isOpen() const { return mActive.load(std::memory_order_acquire); }
+
+    /**
+     * Logs the first numSamples of every channel of buffer (all of it if
+     * negative). Output blocks advance the block index, so call kInput before
+     * and kOutput after each processBlock. No-op unless open.
+     */
+    void logBlock(Stage stage, int processor, const juce::AudioBuffer<float>& buffer,
+                  bool waitIfFull, int numSamples = -1) noexcept;
+
+    /** Records dropped on a full ring since open(). */
+    juce::int64 getNumDroppedRecords() const { return mDropped.load(); }
+
+    /** Records written to disk since open(). */
+    juce::int64 getNumWrittenRecords() const { return mWritten.load(); }
+
+    /** Blocks the sampling policy kept since open(). */
+    juce::int64 getNumSampledBlocks() const { return mSampledBlocks.load(); }
+
+    juce::File   getFile() const      { return mFile; }
+    juce::String getLastError() const { return mLastError; }
+
+    //==============================================================================
+    /**
+     * Writes input_samples.csv and output_samples.csv into outputDir, one row
+     * per block and channel: block,processor,channel,sample0,sample1,...
+     * A gap left by dropped records starts a new row for the same block and
+     * channel.
+     */
+    static bool convertToCsv(const juce::File& logFile, const juce::File& outputDir, juce::String& error);
+
+private:
+    class DrainThread;
+
+    bool _writeHeader();
+
+    juce::File                              mFile;
+    std::unique_ptr<juce::FileOutputStream> mStream;
+    std::unique_ptr<SpscQueue<Record>>      mRing;
+    std::unique_ptr<DrainThread>            mThread;
+    juce::String                            mLastError;
+    MemoryAccounting::Tracked               mRingBytes { MemoryAccounting::Category::kLogging };
+
+    Sampling     mSampling;
+    juce::uint64 mSampleThreshold = 0;   // probability scaled to 53 bits
+
+    // Producer-only.
+    juce::uint32 mBlockIndex = 0;
+
+    std::atomic<bool>        mActive        { false };
+    std::atomic<int>         mProducers     { 0 };
+    std::atomic<bool>        mClosing       { false };
+    std::atomic<bool>        mFailed        { false };
+    std::atomic<juce::int64> mDropped       { 0 };
+    std::atomic<juce::int64> mWritten       { 0 };
+    std::atomic<juce::int64> mSampledBlocks { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BinaryBlockLogger)
+};
@@ -1,8 +1,209 @@
 #include "FileUtils.h"
+#include "RenderControl.h"
+#include "RenderTrace.h"
+#include <cstring>
+#include <vector>
 
 namespace FileUtils
 {
 
+namespace
+{
+    constexpr int kChunkSize = 4096;
+
+    bool isWavFile(const juce::File& file)
+    {
+        return file.hasFileExtension(".wav");
+    }
+
+    /** Uncompressed RIFF/WAVE file mapped into memory, located at its data chunk. */
+    struct MappedWav
+    {
+        std::unique_ptr<juce::MemoryMappedFile> map;
+        const juce::uint8* data          = nullptr;
+        juce::int64        numFrames     = 0;
+        int                numChannels   = 0;
+        int                bitsPerSample = 0;
+        int                bytesPerFrame = 0;
+        bool               isFloat       = false;
+        double             sampleRate    = 0.0;
+
+        bool open(const juce::File& file)
+        {
+            map = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+            if (map->getData() == nullptr)
+                return false;
+
+            const auto* bytes = static_cast<const juce::uint8*>(map->getData());
+            const auto  size  = static_cast<juce::int64>(map->getSize());
+
+            if (size < 12 || std::memcmp(bytes, "RIFF", 4) != 0 || std::memcmp(bytes + 8, "WAVE", 4) != 0)
+                return false;
+
+            bool        haveFormat = false;
+            juce::int64 position   = 12;
+
+            while (position + 8 <= size)
+            {
+                const auto* chunk     = bytes + position;
+                const auto  chunkSize = static_cast<juce::int64>(juce::ByteOrder::littleEndianInt(chunk + 4));
+                const auto* body      = chunk + 8;
+
+                if (std::memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16)
+                {
+                    int format    = juce::ByteOrder::littleEndianShort(body);
+                    numChannels   = juce::ByteOrder::littleEndianShort(body + 2);
+                    sampleRate    = static_cast<double>(juce::ByteOrder::littleEndianInt(body + 4));
+                    bitsPerSample = juce::ByteOrder::littleEndianShort(body + 14);
+
+                    // WAVE_FORMAT_EXTENSIBLE: the real format code leads the SubFormat GUID.
+                    if (format == 0xFFFE && chunkSize >= 26)
+                        format = juce::ByteOrder::littleEndianShort(body + 24);
+
+                    if (format != 1 && format != 3)
+                        return false;
+
+                    isFloat    = format == 3;
+                    haveFormat = true;
+                }
+                else if (std::memcmp(chunk, "data", 4) == 0)
+                {
+                    bytesPerFrame = numChannels * (bitsPerSample / 8);
+                    if (! haveFormat || bytesPerFrame <= 0)
+                        return false;
+
+                    const juce::int64 available = juce::jmin(chunkSize, size - (position + 8));
+                    data      = body;
+                    numFrames = available / bytesPerFrame;
+
+                    return isFloat ? bitsPerSample == 32
+                                   : (bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32);
+                }
+
+                position += 8 + chunkSize + (chunkSize & 1);
+            }
+
+            return false;
+        }
+    };
+
+    /**
+     * One channel of interleaved little-endian frames -> float. Integer formats are
+     * left-justified into int32 scratch, then scaled by FloatVectorOperations'
+     * SIMD fixed->float conversion; 1 / 2^31 matches JUCE's own WAV reader exactly.
+     */
+    void convertChannel(const juce::uint8* src, int stride, int numSamples,
+                        int bitsPerSample, bool isFloat, float* dest, int* scratch)
+    {
+        if (isFloat)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                std::memcpy(dest + i, src + i * stride, sizeof(float));
+            return;
+        }
+
+        switch (bitsPerSample)
+        {
+            case 16:
+                for (int i = 0; i < numSamples; ++i, src += stride)
+                    scratch[i] = static_cast<int>((juce::uint32) src[0] << 16 | (juce::uint32) src[1] << 24);
+                break;
+
+            case 24:
+                for (int i = 0; i < numSamples; ++i, src += stride)
+                    scratch[i] = static_cast<int>((juce::uint32) src[0] << 8 | (juce::uint32) src[1] << 16
+                                                | (juce::uint32) src[2] << 24);
+                break;
+
+            default:
+                for (int i = 0; i < numSamples; ++i, src += stride)
+                    scratch[i] = static_cast<int>(juce::ByteOrder::littleEndianInt(src));
+                break;
+        }
+
+        juce::FloatVectorOperations::convertFixedToFloat(dest, scratch, 1.0f / 2147483648.0f, numSamples);
+    }
+
+    bool loadMappedWav(const MappedWav& wav,
+                       juce::AudioBuffer<float>& destBuffer,
+                       int maxSamples,
+                       juce::int64 startSample,
+                       int& samplesReadOut,
+                       const std::function<void(float)>& progressCallback,
+                       RenderControl* control)
+    {
+        const int fileSamples = static_cast<int>(juce::jlimit<juce::int64>(
+            0, static_cast<juce::int64>(std::numeric_limits<int>::max()), wav.numFrames - startSample));
+
+        const int totalToRead = juce::jmin(maxSamples, fileSamples, destBuffer.getNumSamples());
+        if (totalToRead <= 0)
+            return true;
+
+        const int destChannels   = destBuffer.getNumChannels();
+        const int channelsToFill = juce::jmin(destChannels, wav.numChannels);
+        const int bytesPerSample = wav.bitsPerSample / 8;
+
+        std::vector<int> scratch (static_cast<size_t>(kChunkSize));
+        int samplesDone = 0;
+
+        while (samplesDone < totalToRead)
+        {
+            if (control != nullptr && ! control->checkpoint())
+                return false;
+
+            AFT_TRACE_SCOPE("readChunk", "io");
+            const int   thisChunk = juce::jmin(kChunkSize, totalToRead - samplesDone);
+            const auto* frames    = wav.data + (startSample + samplesDone) * wav.bytesPerFrame;
+
+            for (int ch = 0; ch < channelsToFill; ++ch)
+                convertChannel(frames + ch * bytesPerSample, wav.bytesPerFrame, thisChunk,
+                               wav.bitsPerSample, wav.isFloat,
+                               destBuffer.getWritePointer(ch, samplesDone), scratch.data());
+
+            samplesDone += thisChunk;
+
+            if (progressCallback)
+                progressCallback(static_cast<float>(samplesDone) / static_cast<float>(totalToRead));
+        }
+
+        if (wav.numChannels == 1)
+            for (int ch = 1; ch < destChannels; ++ch)
+                destBuffer.copyFrom(ch, 0, destBuffer, 0, 0, totalToRead);
+
+        samplesReadOut = totalToRead;
+        return true;
+    }
+} // namespace
+
+juce::AudioFormatManager& getFormatManager()
+{
+    static juce::AudioFormatManager formatManager;
+    static const bool registered = []
+    {
+        formatManager.registerBasicFormats();
+        return true;
+    }();
+
+    juce::ignoreUnused (registered);
+    return formatManager;
+}
+
+std::unique_ptr<juce::AudioFormatReader> createReaderFor(const juce::File& file, ReadStrategy strategy)
+{
+    if (strategy != ReadStrategy::kStreamed && isWavFile(file))
+    {
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped (wavFormat.createMemoryMappedReader(file));
+        if (mapped != nullptr && mapped->mapEntireFile())
+            return mapped;
+    }
+
+    if (strategy == ReadStrategy::kMemoryMapped)
+        return nullptr;
+
+    return std::unique_ptr<juce::AudioFormatReader> (getFormatManager().createReaderFor(file));
+}
+
 bool isSupportedAudioFile(const juce::File& file)
 {
     auto extension = file.getFileExtension().toLowerCase();
@@ -92,34 +293,73 @@ bool validateOutputPath(const juce::File& file, juce::String& errorMsg)
     return true;
 }
 
+bool readAudioFileInfo(const juce::File& file,
+                       double& sampleRateOut,
+                       int& numChannelsOut,
+                       juce::int64& lengthInSamplesOut)
+{
+    sampleRateOut      = 0.0;
+    numChannelsOut     = 0;
+    lengthInSamplesOut = 0;
+
+    if (! file.existsAsFile())
+        return false;
+
+    std::unique_ptr<juce::AudioFormatReader> reader (getFormatManager().createReaderFor (file));
+    if (reader == nullptr)
+        return false;
+
+    sampleRateOut      = reader->sampleRate;
+    numChannelsOut     = static_cast<int> (reader->numChannels);
+    lengthInSamplesOut = reader->lengthInSamples;
+    return true;
+}
+
 bool loadWavIntoBuffer(const juce::File& wavFile,
                        juce::AudioBuffer<float>& destBuffer,
                        int maxSamples,
                        double& sampleRateOut,
                        int& numChannelsOut,
                        int& samplesReadOut,
-                       std::function<void(float)> progressCallback)
+                       std::function<void(float)> progressCallback,
+                       RenderControl* control,
+                       ReadStrategy strategy,
+                       juce::int64 startSample)
 {
+    AFT_TRACE_SCOPE ("loadWav", "io");
+
     sampleRateOut   = 0.0;
     numChannelsOut  = 0;
     samplesReadOut  = 0;
 
-    if (! wavFile.existsAsFile())
+    if (! wavFile.existsAsFile() || startSample < 0)
         return false;
 
-    juce::AudioFormatManager formatManager;
-    formatManager.registerBasicFormats();
+    if (strategy != ReadStrategy::kStreamed && isWavFile (wavFile))
+    {
+        MappedWav mapped;
+        if (mapped.open (wavFile))
+        {
+            sampleRateOut  = mapped.sampleRate;
+            numChannelsOut = mapped.numChannels;
+            return loadMappedWav (mapped, destBuffer, maxSamples, startSample, samplesReadOut, progressCallback, control);
+        }
+    }
+
+    if (strategy == ReadStrategy::kMemoryMapped)
+        return false;
 
-    std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (wavFile));
+    std::unique_ptr<juce::AudioFormatReader> reader (getFormatManager().createReaderFor (wavFile));
     if (reader == nullptr)
         return false;
 
     sampleRateOut  = reader->sampleRate;
     numChannelsOut = static_cast<int> (reader->numChannels);
 
-    const int fileSamples = static_cast<int> (juce::jmin<juce::int64> (
-        reader->lengthInSamples,
-        static_cast<juce::int64> (std::numeric_limits<int>::max())));
+    const int fileSamples = static_cast<int> (juce::jlimit<juce::int64> (
+        0,
+        static_cast<juce::int64> (std::numeric_limits<int>::max()),
+        reader->lengthInSamples - startSample));
 
     const int destSamples   = destBuffer.getNumSamples();
     const int totalToRead   = juce::jmin (maxSamples, fileSamples, destSamples);
@@ -127,13 +367,16 @@ bool loadWavIntoBuffer(const juce::File& wavFile,
         return true;
 
     const int destChannels  = destBuffer.getNumChannels();
-    const int chunkSize     = 4096;
     int       samplesDone   = 0;
 
     while (samplesDone < totalToRead)
     {
-        const int thisChunk = juce::jmin (chunkSize, totalToRead - samplesDone);
-        const bool ok = reader->read (&destBuffer, samplesDone, thisChunk, samplesDone, true, destChannels > 1);
+        if (control != nullptr && ! control->checkpoint())
+            return false;
+
+        AFT_TRACE_SCOPE ("readChunk", "io");
+        const int thisChunk = juce::jmin (kChunkSize, totalToRead - samplesDone);
+        const bool ok = reader->read (&destBuffer, samplesDone, thisChunk, startSample + samplesDone, true, destChannels > 1);
         if (! ok)
             return false;
         samplesDone += thisChunk;
@@ -152,4 +395,64 @@ bool loadWavIntoBuffer(const juce::File& wavFile,
     return true;
 }
 
+bool writeBufferToWav(const juce::AudioBuffer<float>& srcBuffer,
+                      const juce::File& wavFile,
+                      double sampleRate,
+                      int numSamplesToWrite,
+                      int bitDepth,
+                      std::function<void(float)> progressCallback,
+                      RenderControl* control)
+{
+    const int numChannels = srcBuffer.getNumChannels();
+    const int totalToWrite = juce::jmin (numSamplesToWrite, srcBuffer.getNumSamples());
+    if (numChannels == 0 || totalToWrite <= 0 || sampleRate <= 0.0)
+        return false;
+
+    wavFile.deleteFile();
+
+    std::unique_ptr<juce::FileOutputStream> stream (wavFile.createOutputStream());
+    if (stream == nullptr)
+        return false;
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer (wavFormat.createWriterFor (stream.get(),
+                                                                                sampleRate,
+                                                                                static_cast<unsigned int> (numChannels),
+                                                                                bitDepth,
+                                                                                {},
+                                                                                0));
+    if (writer == nullptr)
+        return false;
+
+    stream.release(); // writer owns the stream now
+
+    int samplesDone = 0;
+
+    while (samplesDone < totalToWrite)
+    {
+        if (control != nullptr && ! control->checkpoint())
+        {
+            writer.reset();
+            wavFile.deleteFile();
+            return false;
+        }
+
+        AFT_TRACE_SCOPE ("writeChunk", "io");
+        const int thisChunk = juce::jmin (kChunkSize, totalToWrite - samplesDone);
+        if (! writer->writeFromAudioSampleBuffer (srcBuffer, samplesDone, thisChunk))
+        {
+            writer.reset();
+            wavFile.deleteFile();
+            return false;
+        }
+        samplesDone += thisChunk;
+
+        if (progressCallback)
+            progressCallback (static_cast<float> (samplesDone) / static_cast<float> (totalToWrite));
+    }
+
+    writer.reset(); // flushes + finalises the header
+    return true;
+}
+
 } // namespace FileUtils
@@ -2,9 +2,50 @@
 
 #include "Juce_Header.h"
 #include <functional>
+#include <memory>
+
+class RenderControl;
 
 namespace FileUtils
 {
+    /** How loadWavIntoBuffer / createReaderFor get at the samples. */
+    enum class ReadStrategy
+    {
+        kAuto = 0,      // memory-mapped for uncompressed WAV, buffered stream otherwise
+        kStreamed,      // AudioFormatReader over a buffered FileInputStream
+        kMemoryMapped   // memory-mapped only; fails if the file cannot be mapped
+    };
+
+    /**
+     * Process-wide format manager with the basic formats registered once.
+     *
+     * Built on first use instead of per call. createReaderFor() does not
+     * mutate the manager, so it may be shared across render threads.
+     */
+    juce::AudioFormatManager& getFormatManager();
+
+    /**
+     * Opens a reader for file. With kAuto / kMemoryMapped, WAV files get a
+     * MemoryMappedAudioFormatReader with the whole file mapped.
+     *
+     * @return nullptr if no registered format can open the file (or, for
+     *         kMemoryMapped, if it cannot be mapped).
+     */
+    std::unique_ptr<juce::AudioFormatReader> createReaderFor(const juce::File& file,
+                                                             ReadStrategy strategy = ReadStrategy::kAuto);
+
+    /**
+     * Reads only the header of an audio file.
+     *
+     * Used to size render storage before any samples are loaded.
+     *
+     * @return true if the file could be opened by a registered format.
+     */
+    bool readAudioFileInfo(const juce::File& file,
+                           double& sampleRateOut,
+                           int& numChannelsOut,
+                           juce::int64& lengthInSamplesOut);
+
     /**
      * Reads a WAV file into a pre-sized destination buffer.
      *
@@ -17,7 +58,14 @@ namespace FileUtils
      * @param numChannelsOut   Set to the file's channel count on success.
      * @param samplesReadOut   Set to actual samples read on success (0 on failure).
      * @param progressCallback Optional 0.0 -> 1.0 progress reporter, fired across chunked reads.
-     * @return true on success, false if file missing/unreadable.
+     * @param control          Optional cancel/pause token, checked once per chunk.
+     * @param strategy         kAuto maps 16/24/32-bit PCM and 32-bit float WAVs and
+     *                         converts straight from the mapping into destBuffer's
+     *                         channels; anything else goes through the streamed reader.
+     * @param startSample      First file sample to read; the reader seeks straight
+     *                         there (or offsets into the mapping), so a region costs
+     *                         only its own length. Reads stop at the end of the file.
+     * @return true on success, false if file missing/unreadable or the read was cancelled.
      *
      * Mono source -> stereo dest: ch0 is duplicated into ch1.
      * Tail beyond samplesReadOut is left untouched (caller must clear if desired).
@@ -28,7 +76,28 @@ namespace FileUtils
                            double& sampleRateOut,
                            int& numChannelsOut,
                            int& samplesReadOut,
-                           std::function<void(float)> progressCallback = nullptr);
+                           std::function<void(float)> progressCallback = nullptr,
+                           RenderControl* control = nullptr,
+                           ReadStrategy strategy = ReadStrategy::kAuto,
+                           juce::int64 startSample = 0);
+
+    /**
+     * Writes the first numSamplesToWrite samples of srcBuffer to a WAV file in chunks.
+     *
+     * Cancellable counterpart to RD BufferWriter::writeToWav. An existing file at
+     * wavFile is replaced. If control is cancelled mid-write the partial file is
+     * deleted so no truncated WAV is left behind.
+     *
+     * @param numSamplesToWrite Clamped to srcBuffer's length.
+     * @return true on success, false on open/write failure or cancellation.
+     */
+    bool writeBufferToWav(const juce::AudioBuffer<float>& srcBuffer,
+                          const juce::File& wavFile,
+                          double sampleRate,
+                          int numSamplesToWrite,
+                          int bitDepth = 24,
+                          std::function<void(float)> progressCallback = nullptr,
+                          RenderControl* control = nullptr);
 
     /**
      * Checks if a file has a supported audio file extension.
@@ -0,0 +1,64 @@
+#include "JobPool.h"
+#include "RenderTrace.h"
+
+//==============================================================================
+class JobPool::Worker : public juce::Thread
+{
+public:
+    Worker(JobPool& owner, int workerIndex)
+        : juce::Thread(owner.mThreadName + " " + juce::String(workerIndex))
+        , mOwner(owner)
+        , mWorkerIndex(workerIndex)
+    {
+    }
+
+    void run() override
+    {
+        AFT_TRACE_THREAD();
+
+        for (int job = mOwner.mNextJob.fetch_add(1); job < mOwner.mNumJobs; job = mOwner.mNextJob.fetch_add(1))
+            mOwner.mJob(mWorkerIndex, job);
+
+        if (mOwner.mOnWorkerExit)
+            mOwner.mOnWorkerExit(mWorkerIndex);
+    }
+
+private:
+    JobPool&  mOwner;
+    const int mWorkerIndex;
+};
+
+//==============================================================================
+JobPool::JobPool(const juce::String& threadName)
+    : mThreadName(threadName)
+{
+}
+
+JobPool::~JobPool()
+{
+    join();
+}
+
+void JobPool::start(int numWorkers, int numJobs, JobFunction job, ExitFunction onWorkerExit)
+{
+    join();
+    mWorkers.clear();
+
+    mJob          = std::move(job);
+    mOnWorkerExit = std::move(onWorkerExit);
+    mNumJobs      = juce::jmax(0, numJobs);
+    mNextJob.store(0);
+
+    for (int i = 0; i < numWorkers; ++i)
+        mWorkers.push_back(std::make_unique<Worker>(*this, i));
+
+    // Started only once every worker exists, so none can see a half-built pool.
+    for (auto& worker : mWorkers)
+        worker->startThread();
+}
+
+void JobPool::join()
+{
+    for (auto& worker : mWorkers)
+        worker->waitForThreadToExit(-1);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Juce_Header.h"
+#include <atomic>
+#include <functional>
+
+/**
+ * Fixed set of threads draining the job indices [0, numJobs).
+ *
+ * Each worker takes the next unclaimed index from a shared counter, so
+ * uneven jobs spread across threads and one long job never holds up the
+ * rest. The job function gets the worker index too, for callers that give
+ * each worker its own render context. Used by BatchRenderQueue and the CLI.
+ */
+class JobPool
+{
+public:
+    using JobFunction  = std::function<void(int workerIndex, int jobIndex)>;
+    using ExitFunction = std::function<void(int workerIndex)>;
+
+    explicit JobPool(const juce::String& threadName);
+    ~JobPool();
+
+    /**
+     * Starts numWorkers threads and returns immediately. onWorkerExit, if set,
+     * runs on each worker after it finds no more jobs. Joins any previous run first.
+     */
+    void start(int numWorkers, int numJobs, JobFunction job, ExitFunction onWorkerExit = {});
+
+    /** Blocks until every worker has exited. */
+    void join();
+
+    int getNumWorkers() const { return static_cast<int>(mWorkers.size()); }
+
+private:
+    class Worker;
+
+    const juce::String                   mThreadName;
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::atomic<int>                     mNextJob { 0 };
+    int                                  mNumJobs = 0;
+    JobFunction                          mJob;
+    ExitFunction                         mOnWorkerExit;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(JobPool)
+};
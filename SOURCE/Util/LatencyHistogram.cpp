@@ -0,0 +1,113 @@
+#include "LatencyHistogram.h"
+#include <bit>
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+//==============================================================================
+int LatencyHistogram::getBucketIndex(juce::int64 nanoseconds) noexcept
+{
+    if (nanoseconds <= 0)
+        return 0;
+
+    const auto value = juce::jmin(static_cast<juce::uint64>(nanoseconds), (juce::uint64(1) << kMaxValueBits) - 1);
+    if (value < 2 * kSubBucketCount)
+        return static_cast<int>(value);
+
+    // Keep the top kSubBucketBits + 1 bits: the leading one picks the octave, the rest the sub-bucket.
+    const int shift = static_cast<int>(std::bit_width(value)) - 1 - kSubBucketBits;
+    const int top   = static_cast<int>(value >> shift);
+    return 2 * kSubBucketCount + (shift - 1) * kSubBucketCount + (top - kSubBucketCount);
+}
+
+juce::int64 LatencyHistogram::getBucketUpperBound(int index) noexcept
+{
+    if (index < 2 * kSubBucketCount)
+        return index;
+
+    const int offset = index - 2 * kSubBucketCount;
+    const int shift  = offset / kSubBucketCount + 1;
+    const int top    = offset % kSubBucketCount + kSubBucketCount;
+    return ((static_cast<juce::int64>(top) + 1) << shift) - 1;
+}
+
+//==============================================================================
+void LatencyHistogram::record(juce::int64 nanoseconds) noexcept
+{
+    mCounts[static_cast<size_t>(getBucketIndex(nanoseconds))].fetch_add(1, std::memory_order_relaxed);
+    mSumNs.fetch_add(juce::jmax<juce::int64>(0, nanoseconds), std::memory_order_relaxed);
+
+    const auto blockIndex = mCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Single writer, so load-compare-store is enough. Ties keep the earlier block.
+    if (blockIndex == 0 || nanoseconds > mMaxNs.load(std::memory_order_relaxed))
+    {
+        mMaxNs.store(nanoseconds, std::memory_order_relaxed);
+        mWorstBlock.store(blockIndex, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::reset() noexcept
+{
+    for (auto& count : mCounts)
+        count.store(0, std::memory_order_relaxed);
+
+    mCount.store(0, std::memory_order_relaxed);
+    mSumNs.store(0, std::memory_order_relaxed);
+    mMaxNs.store(0, std::memory_order_relaxed);
+    mWorstBlock.store(-1, std::memory_order_relaxed);
+}
+
+juce::int64 LatencyHistogram::getValueAtPercentile(double percentile) const noexcept
+{
+    const auto total = getCount();
+    if (total <= 0)
+        return 0;
+
+    const auto target = juce::jlimit<juce::int64>(1, total,
+        static_cast<juce::int64>(std::ceil(juce::jlimit(0.0, 100.0, percentile) * 0.01 * static_cast<double>(total))));
+
+    juce::int64 seen = 0;
+    for (int i = 0; i < kNumBuckets; ++i)
+    {
+        seen += mCounts[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+        if (seen >= target)
+            return juce::jmin(getBucketUpperBound(i), getMaxNanoseconds());
+    }
+
+    return getMaxNanoseconds();
+}
+
+LatencyHistogram::Summary LatencyHistogram::getSummary() const
+{
+    Summary summary;
+    summary.count = getCount();
+    if (summary.count <= 0)
+        return summary;
+
+    auto toUs = [](juce::int64 ns) { return static_cast<double>(ns) * 1.0e-3; };
+
+    summary.meanUs     = toUs(mSumNs.load(std::memory_order_relaxed)) / static_cast<double>(summary.count);
+    summary.p50Us      = toUs(getValueAtPercentile(50.0));
+    summary.p99Us      = toUs(getValueAtPercentile(99.0));
+    summary.p999Us     = toUs(getValueAtPercentile(99.9));
+    summary.maxUs      = toUs(getMaxNanoseconds());
+    summary.worstBlock = getWorstBlockIndex();
+    return summary;
+}
+
+//==============================================================================
+juce::String LatencyHistogram::Summary::toString() const
+{
+    if (! isValid())
+        return "no blocks";
+
+    auto us = [](double value) { return juce::String(value, 1) + " us"; };
+
+    return "p50 " + us(p50Us) + ", p99 " + us(p99Us) + ", p99.9 " + us(p999Us)
+         + ", max " + us(maxUs) + " (block " + juce::String(worstBlock)
+         + ", " + juce::String(getSpikeRatio(), 1) + "x p50)";
+}
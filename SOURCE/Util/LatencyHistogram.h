@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Juce_Header.h"
+#include <array>
+#include <atomic>
+
+/**
+ * Fixed-size log-linear histogram of durations, in the style of HdrHistogram.
+ *
+ * Values are nanoseconds. Below 2 * kSubBucketCount each value has its own
+ * bucket; above that every power of two is split into kSubBucketCount
+ * buckets, so a reported value is never more than 1 / kSubBucketCount
+ * (about 3 %) above the true one. Values beyond kMaxValueBits are clamped.
+ *
+ * record() is lock-free and allocation-free, for one writer at a time (the
+ * audio or render thread). Readers on other threads may query concurrently
+ * and see a slightly stale view. reset() must not race with record().
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr int kSubBucketBits  = 5;
+    static constexpr int kSubBucketCount = 1 << kSubBucketBits;
+    static constexpr int kMaxValueBits   = 40;   // ~18 minutes
+    static constexpr int kNumBuckets     = 2 * kSubBucketCount + (kMaxValueBits - kSubBucketBits - 1) * kSubBucketCount;
+
+    /** Distribution snapshot in microseconds. */
+    struct Summary
+    {
+        juce::int64 count      = 0;
+        double      meanUs     = 0.0;
+        double      p50Us      = 0.0;
+        double      p99Us      = 0.0;
+        double      p999Us     = 0.0;
+        double      maxUs      = 0.0;
+        juce::int64 worstBlock = -1;    // index since reset() of the block that took maxUs
+
+        bool   isValid() const { return count > 0; }
+
+        /** max / p50: how far the worst block sits above a typical one. */
+        double getSpikeRatio() const { return p50Us > 0.0 ? maxUs / p50Us : 0.0; }
+
+        /** One line, e.g. "p50 12.1 us, p99 30.2 us, p99.9 41.0 us, max 140.3 us (block 812, 11.6x p50)". */
+        juce::String toString() const;
+    };
+
+    LatencyHistogram();
+
+    /** Adds one duration. The n-th call since reset() is block index n - 1. */
+    void record(juce::int64 nanoseconds) noexcept;
+
+    void reset() noexcept;
+
+    juce::int64 getCount() const noexcept           { return mCount.load(std::memory_order_relaxed); }
+    juce::int64 getMaxNanoseconds() const noexcept  { return mMaxNs.load(std::memory_order_relaxed); }
+    juce::int64 getWorstBlockIndex() const noexcept { return mWorstBlock.load(std::memory_order_relaxed); }
+
+    /** Upper edge of the bucket holding the given percentile (0-100), capped at the max. 0 if empty. */
+    juce::int64 getValueAtPercentile(double percentile) const noexcept;
+
+    Summary getSummary() const;
+
+    static int         getBucketIndex(juce::int64 nanoseconds) noexcept;
+    static juce::int64 getBucketUpperBound(int index) noexcept;
+
+private:
+    std::array<std::atomic<juce::uint32>, kNumBuckets> mCounts;
+    std::atomic<juce::int64> mCount      { 0 };
+    std::atomic<juce::int64> mSumNs      { 0 };
+    std::atomic<juce::int64> mMaxNs      { 0 };
+    std::atomic<juce::int64> mWorstBlock { -1 };
+
+    JUCE_DECLARE_NON_COPYABLE(LatencyHistogram)
+};
@@ -0,0 +1,102 @@
+#include "MemoryAccounting.h"
+#include <atomic>
+
+namespace
+{
+    // [0, kNumCategories) per category, kTotal for the sum.
+    constexpr int kTotal = MemoryAccounting::kNumCategories;
+
+    std::atomic<juce::int64> gCurrent[kTotal + 1] {};
+    std::atomic<juce::int64> gPeak[kTotal + 1]    {};
+    std::atomic<int>         gActiveScopes        { 0 };
+
+    void addTo(int slot, juce::int64 bytes) noexcept
+    {
+        const auto now = gCurrent[slot].fetch_add(bytes) + bytes;
+
+        auto peak = gPeak[slot].load();
+        while (now > peak && ! gPeak[slot].compare_exchange_weak(peak, now)) {}
+    }
+}
+
+//==============================================================================
+const char* MemoryAccounting::getCategoryName(Category category)
+{
+    switch (category)
+    {
+        case Category::kStorage:   return "storage";
+        case Category::kPsola:     return "psola";
+        case Category::kLogging:   return "logging";
+    }
+    return "unknown";
+}
+
+void MemoryAccounting::add(Category category, juce::int64 bytes) noexcept
+{
+    if (bytes == 0)
+        return;
+
+    addTo(static_cast<int>(category), bytes);
+    addTo(kTotal, bytes);
+}
+
+juce::int64 MemoryAccounting::getCurrentBytes() noexcept                  { return gCurrent[kTotal].load(); }
+juce::int64 MemoryAccounting::getCurrentBytes(Category category) noexcept { return gCurrent[static_cast<int>(category)].load(); }
+juce::int64 MemoryAccounting::getPeakBytes() noexcept                     { return gPeak[kTotal].load(); }
+juce::int64 MemoryAccounting::getPeakBytes(Category category) noexcept    { return gPeak[static_cast<int>(category)].load(); }
+
+void MemoryAccounting::resetPeaks() noexcept
+{
+    for (int slot = 0; slot <= kTotal; ++slot)
+        gPeak[slot].store(gCurrent[slot].load());
+}
+
+//==============================================================================
+void MemoryAccounting::Tracked::set(juce::int64 bytes) noexcept
+{
+    bytes = juce::jmax<juce::int64>(0, bytes);
+    MemoryAccounting::add(mCategory, bytes - mBytes);
+    mBytes = bytes;
+}
+
+//==============================================================================
+MemoryAccounting::ScopedPeak::ScopedPeak()
+{
+    if (gActiveScopes.fetch_add(1) == 0)
+        resetPeaks();
+
+    mStartBytes = getCurrentBytes();
+}
+
+MemoryAccounting::ScopedPeak::~ScopedPeak()
+{
+    gActiveScopes.fetch_sub(1);
+}
+
+MemoryAccounting::Snapshot MemoryAccounting::ScopedPeak::getSnapshot() const
+{
+    Snapshot snapshot;
+    snapshot.startBytes = mStartBytes;
+    snapshot.peakBytes  = getPeakBytes();
+
+    for (int i = 0; i < kNumCategories; ++i)
+        snapshot.peakCategoryBytes[i] = getPeakBytes(static_cast<Category>(i));
+
+    return snapshot;
+}
+
+juce::String MemoryAccounting::Snapshot::toString() const
+{
+    auto describe = [](juce::int64 bytes) { return juce::File::descriptionOfSizeInBytes(bytes); };
+
+    juce::StringArray parts;
+    for (int i = 0; i < kNumCategories; ++i)
+        if (peakCategoryBytes[i] > 0)
+            parts.add(juce::String(getCategoryName(static_cast<Category>(i))) + " " + describe(peakCategoryBytes[i]));
+
+    auto text = describe(peakBytes);
+    if (! parts.isEmpty())
+        text << " (" << parts.joinIntoString(", ") << ")";
+
+    return text;
+}
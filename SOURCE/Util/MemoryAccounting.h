@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Juce_Header.h"
+
+/**
+ * Process-wide accounting of the large allocations behind a render.
+ *
+ * Owners of sizeable memory (render storage and the streaming block ring,
+ * writer staging, TD-PSOLA analysis vectors, block-log and trace buffers)
+ * report it through a
+ * Tracked member. Its set() moves the per-category total by the change, and
+ * its destructor hands the bytes back. Totals and high-water marks are
+ * lock-free atomics and nothing is updated per block.
+ *
+ * A ScopedPeak brackets one render and reports the highest total seen while
+ * it was open. The mark is process-wide, so renders that overlap share it:
+ * what a render node needs is the RAM the whole process peaks at.
+ *
+ * These are the bytes owners report, not the heap. Small allocations and
+ * library internals are left out, and so is processor state: RD processors
+ * allocate in prepareToPlay() without reporting it, and a process-wide heap
+ * delta around that call would also charge whatever other threads allocate
+ * meanwhile. Their delay lines and grain buffers are small next to render
+ * storage but are not in the totals.
+ */
+class MemoryAccounting
+{
+public:
+    enum class Category { kStorage = 0, kPsola, kLogging };
+    static constexpr int kNumCategories = 3;
+
+    static const char* getCategoryName(Category category);
+
+    struct Snapshot
+    {
+        juce::int64 startBytes = 0;   // tracked total when the scope opened
+        juce::int64 peakBytes  = 0;   // highest tracked total while it was open
+        juce::int64 peakCategoryBytes[kNumCategories] = {};   // each category's own high water
+
+        bool isValid() const { return peakBytes > 0; }
+
+        /** Bytes the render added on top of what was already held. */
+        juce::int64 getRenderBytes() const { return juce::jmax<juce::int64>(0, peakBytes - startBytes); }
+
+        /** e.g. "93.2 MB (storage 90 MB, psola 1.2 MB, logging 2 MB)" */
+        juce::String toString() const;
+    };
+
+    //==============================================================================
+    static void add(Category category, juce::int64 bytes) noexcept;
+
+    static juce::int64 getCurrentBytes() noexcept;
+    static juce::int64 getCurrentBytes(Category category) noexcept;
+    static juce::int64 getPeakBytes() noexcept;
+    static juce::int64 getPeakBytes(Category category) noexcept;
+
+    /** Restarts every high-water mark from the current totals. */
+    static void resetPeaks() noexcept;
+
+    //==============================================================================
+    /** Bytes held by one owner. Not thread-safe itself; the owner serialises set(). */
+    class Tracked
+    {
+    public:
+        explicit Tracked(Category category) : mCategory(category) {}
+        ~Tracked() { set(0); }
+
+        void set(juce::int64 bytes) noexcept;
+
+        juce::int64 get() const noexcept { return mBytes; }
+
+    private:
+        Category    mCategory;
+        juce::int64 mBytes = 0;
+
+        JUCE_DECLARE_NON_COPYABLE(Tracked)
+    };
+
+    /**
+     * Watches the high-water mark for one render. The first scope to open
+     * resets the marks; scopes opened while others are alive keep them.
+     */
+    class ScopedPeak
+    {
+    public:
+        ScopedPeak();
+        ~ScopedPeak();
+
+        Snapshot getSnapshot() const;
+
+    private:
+        juce::int64 mStartBytes = 0;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedPeak)
+    };
+};
@@ -0,0 +1,44 @@
+#include "RenderControl.h"
+
+RenderControl::RenderControl()
+{
+    mResumeEvent.signal();
+}
+
+RenderControl::~RenderControl()
+{
+    cancel();
+}
+
+void RenderControl::cancel()
+{
+    mCancelled.store(true);
+    // Wake any paused render so it can observe the cancel and unwind.
+    mResumeEvent.signal();
+}
+
+void RenderControl::pause()
+{
+    mResumeEvent.reset();
+    mPaused.store(true);
+}
+
+void RenderControl::resume()
+{
+    mPaused.store(false);
+    mResumeEvent.signal();
+}
+
+void RenderControl::reset()
+{
+    mCancelled.store(false);
+    resume();
+}
+
+bool RenderControl::checkpoint()
+{
+    while (mPaused.load() && ! mCancelled.load())
+        mResumeEvent.wait(50);
+
+    return ! mCancelled.load();
+}
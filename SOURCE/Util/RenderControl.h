@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Juce_Header.h"
+#include <atomic>
+
+/**
+ * Cooperative cancellation + pause/resume token for offline renders.
+ *
+ * The UI thread calls cancel() / pause() / resume(); the render loops (load,
+ * process, write) call checkpoint() once per block. checkpoint() blocks while
+ * paused and returns false once cancelled, so a cancel lands within one block
+ * instead of waiting for stopThread() to time out.
+ */
+class RenderControl
+{
+public:
+    RenderControl();
+    ~RenderControl();
+
+    void cancel();
+    void pause();
+    void resume();
+
+    /** Clears cancel + pause state ahead of a new job. */
+    void reset();
+
+    bool isCancelled() const { return mCancelled.load(); }
+    bool isPaused()    const { return mPaused.load(); }
+
+    /**
+     * Call at block granularity from the render thread.
+     * Waits while paused; returns false if the render should stop.
+     */
+    bool checkpoint();
+
+private:
+    std::atomic<bool>   mCancelled { false };
+    std::atomic<bool>   mPaused    { false };
+    juce::WaitableEvent mResumeEvent { true };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderControl)
+};
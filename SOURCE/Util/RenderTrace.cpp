@@ -0,0 +1,264 @@
+#include "RenderTrace.h"
+#include "MemoryAccounting.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    struct Event
+    {
+        const char* name;
+        const char* category;
+        juce::int64 startNs;
+        juce::int64 endNs;
+    };
+
+    /**
+     * One registered thread's events. Only the owning thread writes; stop()
+     * reads the published prefix [0, count) under the registry lock. The
+     * event array is allocated under the lock — by start(), or at
+     * registration during a session — and published through events. A
+     * buffer whose thread has exited is handed to the next registering
+     * thread once its events belong to an older session.
+     */
+    struct ThreadBuffer
+    {
+        std::unique_ptr<Event[]>  storage;
+        std::atomic<Event*>       events  { nullptr };
+        std::atomic<int>          count   { 0 };
+        std::atomic<int>          dropped { 0 };
+        std::atomic<juce::uint32> session { 0 };
+        std::atomic<bool>         inUse   { false };
+
+        // Written under the registry lock.
+        int          threadId = 0;
+        juce::String threadName;
+    };
+
+    struct Registry
+    {
+        juce::CriticalSection                      lock;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        std::atomic<juce::uint32>                  session { 0 };
+        std::atomic<int>                           unregisteredDropped { 0 };
+        juce::int64                                sessionStartNs = 0;
+        int                                        nextThreadId = 1;
+    };
+
+    Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    // Call with the registry lock held.
+    void allocateEvents(ThreadBuffer& buffer)
+    {
+        if (buffer.storage != nullptr)
+            return;
+
+        buffer.storage.reset(new Event[RenderTrace::kEventsPerThread]);
+        buffer.events.store(buffer.storage.get(), std::memory_order_release);
+
+        // Buffers live as long as the process, so this is never given back.
+        MemoryAccounting::add(MemoryAccounting::Category::kLogging,
+                              static_cast<juce::int64>(sizeof(Event)) * RenderTrace::kEventsPerThread);
+    }
+
+    ThreadBuffer* acquireBuffer()
+    {
+        auto& registry = getRegistry();
+        const juce::ScopedLock sl (registry.lock);
+
+        const auto session = registry.session.load();
+        ThreadBuffer* buffer = nullptr;
+
+        for (auto& candidate : registry.buffers)
+        {
+            // Don't take over a finished thread's events before they are written.
+            const bool holdsThisSession = candidate->session.load() == session && candidate->count.load() > 0;
+            if (! candidate->inUse.load() && ! holdsThisSession)
+            {
+                buffer = candidate.get();
+                break;
+            }
+        }
+
+        if (buffer == nullptr)
+        {
+            registry.buffers.push_back(std::make_unique<ThreadBuffer>());
+            buffer = registry.buffers.back().get();
+        }
+
+        // Otherwise start() allocates it with the rest.
+        if (RenderTrace::isActive())
+            allocateEvents(*buffer);
+
+        buffer->inUse.store(true);
+        buffer->threadId = registry.nextThreadId++;
+
+        auto* thread = juce::Thread::getCurrentThread();
+        buffer->threadName = thread != nullptr ? thread->getThreadName()
+                                               : juce::String(juce::MessageManager::existsAndIsCurrentThread() ? "Message Thread"
+                                                                                                              : "Thread");
+        return buffer;
+    }
+
+    // Trivially destructible, so reading it from a scope never registers a
+    // TLS destructor; ThreadSlot owns the release.
+    thread_local ThreadBuffer* tBuffer = nullptr;
+
+    /** Gives the buffer back when its thread exits. */
+    struct ThreadSlot
+    {
+        ThreadBuffer* buffer = nullptr;
+
+        ~ThreadSlot()
+        {
+            if (buffer != nullptr)
+                buffer->inUse.store(false);
+            tBuffer = nullptr;
+        }
+    };
+
+    juce::String escapeJson(const juce::String& text)
+    {
+        return text.replace("\\", "\\\\").replace("\"", "\\\"");
+    }
+}
+
+//==============================================================================
+juce::int64 RenderTrace::_now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void RenderTrace::_record(const char* name, const char* category, juce::int64 startNs, juce::int64 endNs) noexcept
+{
+    auto& registry = getRegistry();
+
+    // Never lock or allocate here: a thread that never registered drops.
+    auto* events = tBuffer != nullptr ? tBuffer->events.load(std::memory_order_acquire) : nullptr;
+    if (events == nullptr)
+    {
+        registry.unregisteredDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto& buffer = *tBuffer;
+    const auto session = registry.session.load(std::memory_order_acquire);
+
+    // First event of a new session on this thread: start the buffer over.
+    if (buffer.session.load(std::memory_order_relaxed) != session)
+    {
+        buffer.count.store(0, std::memory_order_relaxed);
+        buffer.dropped.store(0, std::memory_order_relaxed);
+        buffer.session.store(session, std::memory_order_release);
+    }
+
+    const int index = buffer.count.load(std::memory_order_relaxed);
+    if (index >= kEventsPerThread)
+    {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    events[index] = { name, category, startNs, endNs };
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+//==============================================================================
+void RenderTrace::registerCurrentThread()
+{
+    thread_local ThreadSlot slot;
+    if (slot.buffer == nullptr)
+    {
+        slot.buffer = acquireBuffer();
+        tBuffer     = slot.buffer;
+    }
+}
+
+bool RenderTrace::start()
+{
+    auto& registry = getRegistry();
+    const juce::ScopedLock sl (registry.lock);
+
+    if (sActive.load())
+        return false;
+
+    registerCurrentThread();
+    for (auto& buffer : registry.buffers)
+        if (buffer->inUse.load())
+            allocateEvents(*buffer);
+
+    registry.unregisteredDropped.store(0);
+    registry.sessionStartNs = _now();
+    registry.session.fetch_add(1, std::memory_order_release);
+    sActive.store(true);
+    return true;
+}
+
+bool RenderTrace::stop(const juce::File& jsonFile)
+{
+    auto& registry = getRegistry();
+    const juce::ScopedLock sl (registry.lock);
+
+    if (! sActive.exchange(false))
+        return false;
+
+    const auto session = registry.session.load();
+    const auto origin  = registry.sessionStartNs;
+
+    jsonFile.deleteFile();
+    juce::FileOutputStream out (jsonFile);
+    if (out.failedToOpen())
+        return false;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    int  written = 0;
+    int  dropped = registry.unregisteredDropped.load();
+    bool first   = true;
+
+    auto separator = [&first, &out]
+    {
+        if (! first)
+            out << ",\n";
+        first = false;
+    };
+
+    for (const auto& buffer : registry.buffers)
+    {
+        if (buffer->session.load(std::memory_order_acquire) != session)
+            continue;
+
+        // Events a late scope publishes after this load simply miss the file.
+        const int count = buffer->count.load(std::memory_order_acquire);
+        dropped += buffer->dropped.load();
+
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+            << ",\"args\":{\"name\":\"" << escapeJson(buffer->threadName) << "\"}}";
+
+        for (int i = 0; i < count; ++i)
+        {
+            const auto& event = buffer->storage[static_cast<size_t>(i)];
+
+            separator();
+            out << "{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+                << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"ts\":" << juce::String(static_cast<double>(event.startNs - origin) * 1.0e-3, 3)
+                << ",\"dur\":" << juce::String(static_cast<double>(event.endNs - event.startNs) * 1.0e-3, 3) << "}";
+            ++written;
+        }
+    }
+
+    out << "\n],\"otherData\":{\"droppedEvents\":" << dropped << "}}\n";
+    out.flush();
+
+    sLastWritten.store(written);
+    sLastDropped.store(dropped);
+    return out.getStatus().wasOk();
+}
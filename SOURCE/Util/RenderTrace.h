@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Juce_Header.h"
+#include <atomic>
+
+/**
+ * Scoped timeline tracing in Chrome trace-event format.
+ *
+ * Place AFT_TRACE_SCOPE("name", "category") at the top of a scope; while a
+ * session is running (start() .. stop()) each scope records one complete
+ * event on its thread. stop() writes the session as JSON that loads in
+ * chrome://tracing or ui.perfetto.dev.
+ *
+ * Each thread appends to its own fixed-size buffer with no locks. A thread
+ * opts in with AFT_TRACE_THREAD() at the top of its run(), off any hot path:
+ * that takes the registry lock and names the thread, and start() allocates
+ * the buffers of every registered thread. Scopes on a thread that never
+ * registered — the audio callback, for one — are dropped and counted, so a
+ * scope never locks or allocates and may sit on the audio thread. The
+ * thread that calls start() is registered by it. Outside a session a scope
+ * costs one relaxed atomic load. Names and categories must be string
+ * literals: only the pointer is stored.
+ *
+ * Built with AFT_TRACE=0 (CMake option AFT_TRACE), both macros expand to
+ * nothing and no trace code is reached.
+ */
+class RenderTrace
+{
+public:
+    static constexpr int kEventsPerThread = 1 << 16;
+
+    /**
+     * Starts a session and registers the calling thread. Returns false if one
+     * is already running.
+     */
+    static bool start();
+
+    /**
+     * Gives the calling thread a trace buffer until it exits. Locks and may
+     * allocate, so call it where the thread starts, never per block.
+     */
+    static void registerCurrentThread();
+
+    /**
+     * Ends the session and writes it to jsonFile. Returns false if no session
+     * was running or the file could not be written.
+     */
+    static bool stop(const juce::File& jsonFile);
+
+    static bool isActive() { return sActive.load(std::memory_order_relaxed); }
+
+    /**
+     * Events dropped in the last stopped session, by full buffers or by
+     * threads that never registered.
+     */
+    static int getNumDroppedEvents() { return sLastDropped.load(); }
+
+    /** Events written by the last stop(). */
+    static int getNumWrittenEvents() { return sLastWritten.load(); }
+
+    class Scope
+    {
+    public:
+        Scope(const char* name, const char* category) noexcept
+            : mName(name)
+            , mCategory(category)
+            , mStartNs(isActive() ? _now() : -1)
+        {
+        }
+
+        ~Scope()
+        {
+            if (mStartNs >= 0)
+                _record(mName, mCategory, mStartNs, _now());
+        }
+
+    private:
+        const char* mName;
+        const char* mCategory;
+        juce::int64 mStartNs;
+
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+private:
+    static juce::int64 _now() noexcept;
+    static void _record(const char* name, const char* category, juce::int64 startNs, juce::int64 endNs) noexcept;
+
+    static inline std::atomic<bool> sActive      { false };
+    static inline std::atomic<int>  sLastDropped { 0 };
+    static inline std::atomic<int>  sLastWritten { 0 };
+};
+
+#if AFT_TRACE
+ #define AFT_TRACE_SCOPE(name, category) const RenderTrace::Scope JUCE_JOIN_MACRO(aftTraceScope_, __LINE__) (name, category)
+ #define AFT_TRACE_THREAD() RenderTrace::registerCurrentThread()
+#else
+ #define AFT_TRACE_SCOPE(name, category)
+ #define AFT_TRACE_THREAD()
+#endif
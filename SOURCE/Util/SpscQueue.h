@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Juce_Header.h"
+#include <atomic>
+#include <vector>
+
+/**
+ * Bounded lock-free single-producer / single-consumer queue.
+ *
+ * Storage is allocated once in the constructor; push() and pop() never
+ * allocate or lock, so either end may sit on a realtime or I/O thread.
+ * Exactly one thread may call push() and exactly one (other) thread may call
+ * pop(). Both return false instead of blocking when the queue is full/empty.
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue (int capacity)
+        : mSlots (static_cast<size_t> (juce::jmax (1, capacity)) + 1)
+    {
+    }
+
+    int getCapacity() const { return static_cast<int> (mSlots.size()) - 1; }
+
+    bool push (const T& item)
+    {
+        const auto write = mWrite.load (std::memory_order_relaxed);
+        const auto next  = _advance (write);
+
+        if (next == mRead.load (std::memory_order_acquire))
+            return false;
+
+        mSlots[write] = item;
+        mWrite.store (next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop (T& item)
+    {
+        const auto read = mRead.load (std::memory_order_relaxed);
+
+        if (read == mWrite.load (std::memory_order_acquire))
+            return false;
+
+        item = mSlots[read];
+        mRead.store (_advance (read), std::memory_order_release);
+        return true;
+    }
+
+    /** Approximate when called concurrently with push()/pop(). */
+    int getNumReady() const
+    {
+        const auto write = mWrite.load (std::memory_order_acquire);
+        const auto read  = mRead.load (std::memory_order_acquire);
+        return static_cast<int> (write >= read ? write - read : mSlots.size() - read + write);
+    }
+
+    bool isEmpty() const { return getNumReady() == 0; }
+
+private:
+    size_t _advance (size_t index) const
+    {
+        return ++index == mSlots.size() ? 0 : index;
+    }
+
+    // One slot is kept empty to tell "full" from "empty" without a shared counter.
+    std::vector<T> mSlots;
+
+    alignas (64) std::atomic<size_t> mWrite { 0 };
+    alignas (64) std::atomic<size_t> mRead  { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (SpscQueue)
+};
@@ -0,0 +1,231 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Processor/AuditionTransport.h"
+#include "Processor/PluginProcessor.h"
+#include "Util/FileUtils.h"
+#include "BufferFiller.h"
+#include <catch2/catch_approx.hpp>
+
+namespace
+{
+    juce::File getOutputDir() { return TestUtils::getModuleOutputDir("AUDITION_TRANSPORT"); }
+
+    /** Plays the transport block by block into one buffer of numSamples. */
+    juce::AudioBuffer<float> playInto(AuditionTransport& transport, int numSamples, int blockSize)
+    {
+        juce::AudioBuffer<float> result(2, numSamples);
+        juce::AudioBuffer<float> block(2, blockSize);
+
+        for (int position = 0; position < numSamples; position += blockSize)
+        {
+            transport.renderNextBlock(block);
+            const int valid = juce::jmin(blockSize, numSamples - position);
+            for (int ch = 0; ch < 2; ++ch)
+                result.copyFrom(ch, position, block, ch, 0, valid);
+        }
+
+        return result;
+    }
+}
+
+TEST_CASE("AuditionTransport plays a buffer source sample-exact at the host rate", "[AuditionTransport]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    constexpr double sampleRate = 48000.0;
+    constexpr int    blockSize  = 256;
+    constexpr int    offset     = 1000;
+    constexpr int    length     = 10000;
+
+    juce::AudioBuffer<float> source(2, offset + length);
+    BufferFiller::generateSineCycles(source, 20);
+
+    AuditionTransport transport;
+    transport.prepare(sampleRate, blockSize);
+
+    // Silent without a source.
+    juce::AudioBuffer<float> block(2, blockSize);
+    BufferFiller::fillWithAllOnes(block);
+    transport.start();
+    REQUIRE_FALSE(transport.renderNextBlock(block));
+    REQUIRE(TestUtils::isSilent(block, 0.0f));
+
+    REQUIRE(transport.loadBuffer(source, offset, length, sampleRate));
+    REQUIRE(transport.hasBufferSource());
+    REQUIRE(transport.getLength() == length);
+    REQUIRE_FALSE(transport.isPlaying());
+
+    SECTION("whole source, then stops at the end")
+    {
+        transport.start();
+        const auto played = playInto(transport, length, blockSize);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < length; ++i)
+                REQUIRE(played.getSample(ch, i) == source.getSample(ch, offset + i));
+
+        REQUIRE_FALSE(transport.isPlaying());
+        REQUIRE(transport.getPosition() == length);
+
+        BufferFiller::fillWithAllOnes(block);
+        REQUIRE_FALSE(transport.renderNextBlock(block));
+        REQUIRE(TestUtils::isSilent(block, 0.0f));
+
+        // start() after the end plays from the top again.
+        transport.start();
+        REQUIRE(transport.renderNextBlock(block));
+        REQUIRE(block.getSample(0, 7) == source.getSample(0, offset + 7));
+    }
+
+    SECTION("seek")
+    {
+        transport.seek(5000);
+        transport.start();
+        REQUIRE(transport.renderNextBlock(block));
+        for (int i = 0; i < blockSize; ++i)
+            REQUIRE(block.getSample(1, i) == source.getSample(1, offset + 5000 + i));
+        REQUIRE(transport.getPosition() == 5000 + blockSize);
+
+        transport.seekToFraction(0.5);
+        REQUIRE(transport.renderNextBlock(block));
+        REQUIRE(block.getSample(0, 0) == source.getSample(0, offset + length / 2));
+    }
+
+    SECTION("unload waits for the audio thread and leaves silence")
+    {
+        transport.start();
+        REQUIRE(transport.renderNextBlock(block));
+
+        transport.unload();
+        REQUIRE_FALSE(transport.hasSource());
+        REQUIRE(transport.getLength() == 0);
+
+        BufferFiller::fillWithAllOnes(block);
+        REQUIRE_FALSE(transport.renderNextBlock(block));
+        REQUIRE(TestUtils::isSilent(block, 0.0f));
+    }
+}
+
+TEST_CASE("AuditionTransport plays a memory-mapped WAV", "[AuditionTransport][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    constexpr double sampleRate = 44100.0;
+    constexpr int    blockSize  = 512;
+    constexpr int    length     = 44100;
+
+    juce::AudioBuffer<float> source(2, length);
+    BufferFiller::generateSineCycles(source, 100);
+
+    const auto file = getOutputDir().getChildFile("audition_source.wav");
+    REQUIRE(FileUtils::writeBufferToWav(source, file, sampleRate, length));
+
+    juce::AudioBuffer<float> expected(2, length);
+    double sr   = 0.0;
+    int    chs  = 0;
+    int    read = 0;
+    REQUIRE(FileUtils::loadWavIntoBuffer(file, expected, length, sr, chs, read));
+    REQUIRE(read == length);
+
+    AuditionTransport transport;
+
+    SECTION("same rate as the host")
+    {
+        transport.prepare(sampleRate, blockSize);
+        REQUIRE(transport.loadFile(file));
+        REQUIRE_FALSE(transport.hasBufferSource());
+        REQUIRE(transport.getSourceSampleRate() == sampleRate);
+
+        transport.start();
+        const auto played = playInto(transport, length, blockSize);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < length; ++i)
+                REQUIRE(played.getSample(ch, i) == expected.getSample(ch, i));
+        REQUIRE_FALSE(transport.isPlaying());
+    }
+
+    SECTION("twice the host rate plays in half the samples")
+    {
+        transport.prepare(sampleRate / 2.0, blockSize);
+        REQUIRE(transport.loadFile(file));
+
+        transport.start();
+        const auto played = playInto(transport, length / 2 + blockSize, blockSize);
+        REQUIRE_FALSE(transport.isPlaying());
+
+        // Integral ratio: every output lands on an even source frame.
+        for (int i = 0; i < length / 2; ++i)
+            REQUIRE(played.getSample(0, i) == Catch::Approx(expected.getSample(0, 2 * i)).margin(1.0e-6));
+        for (int i = length / 2; i < played.getNumSamples(); ++i)
+            REQUIRE(played.getSample(0, i) == 0.0f);
+    }
+
+    SECTION("unmappable file is reported")
+    {
+        transport.prepare(sampleRate, blockSize);
+        REQUIRE_FALSE(transport.loadFile(getOutputDir().getChildFile("missing.wav")));
+        REQUIRE(transport.getLastError().isNotEmpty());
+        REQUIRE_FALSE(transport.hasSource());
+    }
+}
+
+TEST_CASE("Processor auditions its processed buffer through processBlock", "[AuditionTransport][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    constexpr double sampleRate = 44100.0;
+    constexpr int    blockSize  = 512;
+    constexpr int    length     = 22050;
+
+    juce::AudioBuffer<float> source(2, length);
+    BufferFiller::generateSineCycles(source, 50);
+
+    const auto input  = getOutputDir().getChildFile("audition_processor_in.wav");
+    const auto output = getOutputDir().getChildFile("audition_processor_out.wav");
+    REQUIRE(FileUtils::writeBufferToWav(source, input, sampleRate, length));
+
+    AudioFileTransformerProcessor processor;
+    processor.setIsLogging(false);
+    processor.setActiveProcessor(ActiveProcessor::kGain);
+    REQUIRE(processor.transformFile(input, output));
+
+    auto& renderer = processor.getOfflineRenderer();
+    const int numOutput = renderer.getNumOutputSamples();
+    REQUIRE(numOutput >= length);
+
+    juce::AudioBuffer<float> expected(2, numOutput);
+    for (int ch = 0; ch < 2; ++ch)
+        expected.copyFrom(ch, 0, renderer.getOutputBuffer(), ch, 0, numOutput);
+
+    processor.prepareToPlay(sampleRate, blockSize);
+    REQUIRE(processor.auditionProcessedBuffer());
+
+    auto& audition = processor.getAuditionTransport();
+    REQUIRE(audition.isPlaying());
+    REQUIRE(audition.getLength() == numOutput);
+
+    juce::AudioBuffer<float> block(2, blockSize);
+    juce::MidiBuffer         midi;
+
+    for (int position = 0; position < numOutput; position += blockSize)
+    {
+        processor.processBlock(block, midi);
+
+        const int valid = juce::jmin(blockSize, numOutput - position);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < valid; ++i)
+                REQUIRE(block.getSample(ch, i) == expected.getSample(ch, position + i));
+    }
+
+    REQUIRE_FALSE(audition.isPlaying());
+    processor.processBlock(block, midi);
+    REQUIRE(TestUtils::isSilent(block, 0.0f));
+
+    // A new render lets go of the buffer before reusing it.
+    audition.start();
+    REQUIRE(processor.transformFile(input, output));
+    REQUIRE_FALSE(audition.hasSource());
+
+    processor.releaseResources();
+}
@@ -0,0 +1,218 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Processor/BatchRenderQueue.h"
+#include "Processor/OfflineRenderer.h"
+#include "Processor/BufferProcessingManager.h"
+#include "PROCESSORS/GAIN/GainProcessor.h"
+
+namespace
+{
+    juce::File getOutputDir() { return TestUtils::getModuleOutputDir("BATCH_RENDER_QUEUE"); }
+
+    void requireIdentical(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        REQUIRE(a.getNumChannels() == b.getNumChannels());
+        REQUIRE(a.getNumSamples()  == b.getNumSamples());
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                REQUIRE(a.getSample(ch, i) == b.getSample(ch, i));
+    }
+}
+
+TEST_CASE("BatchRenderQueue renders every file with the captured configuration", "[BatchRenderQueue][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    const auto inputDir  = getOutputDir().getChildFile("inputs");
+    const auto outputDir = getOutputDir().getChildFile("outputs");
+    inputDir.deleteRecursively();
+    outputDir.deleteRecursively();
+    inputDir.createDirectory();
+
+    const int numFiles = 6;
+    for (int i = 0; i < numFiles; ++i)
+        TestUtils::writeSineWav(inputDir.getChildFile("batch_" + juce::String(i) + ".wav"), 1 + i % 2, 44100.0, 0.5 + 0.25 * i);
+
+    // Reference setup: gain at a non-default value, rendered one file at a time.
+    BufferProcessingManager bpm;
+    bpm.setActiveProcessor(ActiveProcessor::kGain);
+    bpm.setBlockSize(256);
+
+    auto* gain = dynamic_cast<GainProcessor*>(bpm.getSwapper().getProcessorByIndex(ActiveProcessor::kGain));
+    REQUIRE(gain != nullptr);
+    gain->getAPVTS().getParameter("gain")->setValueNotifyingHost(0.25f);
+
+    const auto config = BatchRenderQueue::Config::fromManager(bpm);
+    REQUIRE(config.processor == ActiveProcessor::kGain);
+    REQUIRE(config.blockSize == 256);
+    REQUIRE(config.parameterXml.isNotEmpty());
+
+    BatchRenderQueue queue(3);
+    REQUIRE(queue.addFolder(inputDir) == numFiles);
+
+    std::atomic<int> callbacks { 0 };
+    queue.setJobFinishedCallback([&] (int) { callbacks.fetch_add(1); });
+
+    REQUIRE(queue.start(outputDir, config));
+    REQUIRE(queue.waitForCompletion(60000));
+    REQUIRE_FALSE(queue.isRunning());
+
+    REQUIRE(queue.getNumFinished()  == numFiles);
+    REQUIRE(queue.getNumSucceeded() == numFiles);
+    REQUIRE(queue.getNumFailed()    == 0);
+    REQUIRE(callbacks.load()        == numFiles);
+    REQUIRE(queue.getOverallProgress() == 1.0f);
+    REQUIRE(queue.getElapsedSeconds() > 0.0);
+
+    StoragePool     pool;
+    OfflineRenderer reference(bpm, pool);
+
+    for (int i = 0; i < numFiles; ++i)
+    {
+        const auto result = queue.getJobResult(i);
+        INFO(result.inputFile.getFileName() << ": " << result.error);
+
+        REQUIRE(result.state == BatchRenderQueue::JobState::kSucceeded);
+        REQUIRE(juce::isPositiveAndBelow(result.workerIndex, queue.getNumWorkers()));
+        REQUIRE(result.outputFile.getParentDirectory() == outputDir);
+        REQUIRE(result.outputFile.getFileNameWithoutExtension() == result.inputFile.getFileNameWithoutExtension());
+
+        const auto referenceFile = getOutputDir().getChildFile("reference.wav");
+        REQUIRE(reference.render(result.inputFile, referenceFile));
+        requireIdentical(TestUtils::readWav(result.outputFile), TestUtils::readWav(referenceFile));
+    }
+}
+
+TEST_CASE("BatchRenderQueue output names are unique per batch", "[BatchRenderQueue]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    // Only names are resolved; nothing is read or written.
+    const auto root = getOutputDir();
+    const auto out  = root.getChildFile("names");
+    const juce::Array<juce::File> inputs { root.getChildFile("a/take.wav"),   root.getChildFile("b/Take.wav"),
+                                           root.getChildFile("c/other.aiff"), root.getChildFile("d/take.wav") };
+
+    const auto outputs = BatchRenderQueue::resolveOutputFiles(inputs, out);
+    REQUIRE(outputs.size() == inputs.size());
+    REQUIRE(outputs[0] == out.getChildFile("take.wav"));
+    REQUIRE(outputs[1] == out.getChildFile("Take_2.wav"));
+    REQUIRE(outputs[2] == out.getChildFile("other.wav"));
+    REQUIRE(outputs[3] == out.getChildFile("take_3.wav"));
+}
+
+TEST_CASE("BatchRenderQueue job bookkeeping", "[BatchRenderQueue][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    const auto dir    = getOutputDir().getChildFile("bookkeeping");
+    const auto outDir = dir.getChildFile("out");
+    dir.deleteRecursively();
+    dir.getChildFile("a").createDirectory();
+    dir.getChildFile("b").createDirectory();
+
+    const auto first  = TestUtils::writeSineWav(dir.getChildFile("a").getChildFile("same_name.wav"), 1, 44100.0, 0.25);
+    const auto second = TestUtils::writeSineWav(dir.getChildFile("b").getChildFile("same_name.wav"), 1, 44100.0, 0.25);
+
+    BatchRenderQueue::Config config;
+
+    SECTION("Duplicate names get distinct outputs; a bad input fails alone")
+    {
+        BatchRenderQueue queue(2);
+        queue.addFile(first);
+        queue.addFile(dir.getChildFile("missing.wav"));
+        queue.addFile(second);
+
+        REQUIRE(queue.start(outDir, config));
+        REQUIRE(queue.waitForCompletion(60000));
+
+        REQUIRE(queue.getNumSucceeded() == 2);
+        REQUIRE(queue.getNumFailed()    == 1);
+        REQUIRE(queue.getJobResult(1).state == BatchRenderQueue::JobState::kFailed);
+        REQUIRE(queue.getJobResult(1).error.isNotEmpty());
+
+        REQUIRE(queue.getJobResult(0).outputFile.getFileName() == "same_name.wav");
+        REQUIRE(queue.getJobResult(2).outputFile.getFileName() == "same_name_2.wav");
+        REQUIRE(queue.getJobResult(2).outputFile.existsAsFile());
+    }
+
+    SECTION("An empty queue refuses to start")
+    {
+        BatchRenderQueue queue(1);
+        REQUIRE_FALSE(queue.start(outDir, config));
+        REQUIRE(queue.getLastError().isNotEmpty());
+    }
+
+    SECTION("Cancel leaves every job in a final state and no partial outputs")
+    {
+        BatchRenderQueue queue(1);
+        for (int i = 0; i < 8; ++i)
+            queue.addFile(TestUtils::writeSineWav(dir.getChildFile("long_" + juce::String(i) + ".wav"), 2, 44100.0, 5.0));
+
+        REQUIRE(queue.start(outDir, config));
+        queue.cancel();
+        REQUIRE(queue.waitForCompletion(60000));
+
+        int cancelled = 0;
+        for (int i = 0; i < queue.getNumJobs(); ++i)
+        {
+            const auto result = queue.getJobResult(i);
+            REQUIRE(result.state != BatchRenderQueue::JobState::kPending);
+            REQUIRE(result.state != BatchRenderQueue::JobState::kRunning);
+
+            if (result.state == BatchRenderQueue::JobState::kCancelled)
+            {
+                ++cancelled;
+                REQUIRE_FALSE(result.outputFile.existsAsFile());
+            }
+        }
+        REQUIRE(cancelled > 0);
+
+        // The queue is reusable after a cancelled batch.
+        queue.clearJobs();
+        queue.addFile(first);
+        REQUIRE(queue.start(outDir, config));
+        REQUIRE(queue.waitForCompletion(60000));
+        REQUIRE(queue.getNumSucceeded() == 1);
+    }
+}
+
+TEST_CASE("BatchRenderQueue throughput scales with workers", "[BatchRenderQueue][file][benchmark]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    const int numCores = juce::SystemStats::getNumCpus();
+    if (numCores < 2)
+    {
+        WARN("Needs at least two cores");
+        return;
+    }
+
+    const auto inputDir = getOutputDir().getChildFile("throughput");
+    inputDir.deleteRecursively();
+    inputDir.createDirectory();
+
+    const int numFiles = juce::jmin(numCores, 8) * 2;
+    for (int i = 0; i < numFiles; ++i)
+        TestUtils::writeSineWav(inputDir.getChildFile("tp_" + juce::String(i) + ".wav"), 2, 44100.0, 4.0);
+
+    BatchRenderQueue::Config config;
+    config.processor = ActiveProcessor::kGrainShifter;
+
+    auto timeBatch = [&] (int numWorkers)
+    {
+        BatchRenderQueue queue(numWorkers);
+        queue.addFolder(inputDir);
+        REQUIRE(queue.start(inputDir.getChildFile("out_" + juce::String(numWorkers)), config));
+        REQUIRE(queue.waitForCompletion(600000));
+        REQUIRE(queue.getNumSucceeded() == numFiles);
+        return queue.getElapsedSeconds();
+    };
+
+    const double serial   = timeBatch(1);
+    const double parallel = timeBatch(0);
+
+    // Wall-clock timings vary with machine load, so the speedup is reported rather than asserted.
+    WARN("Batch of " << numFiles << " files: 1 worker " << serial << " s, "
+         << numCores << " workers " << parallel << " s (x" << serial / parallel << ")");
+}
@@ -0,0 +1,81 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "TEST_UTILS/TestUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Processor/BufferProcessingManager.h"
+
+#include "BufferFiller.h"
+
+TEST_CASE("BlockSizeAutoTuner picks, caches and persists a block size per processor",
+          "[BufferProcessingManager][BlockSizeAutoTuner]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    auto cacheFile = juce::File(__FILE__).getParentDirectory()
+                                          .getChildFile("OUTPUT")
+                                          .getChildFile("BlockSizeCache.xml");
+    cacheFile.deleteFile();
+
+    const double sampleRate  = 44100.0;
+    const int    numChannels = 2;
+    const int    numSamples  = 44100;
+
+    juce::AudioBuffer<float> inputBuffer(numChannels, numSamples);
+    BufferFiller::generateSineCycles(inputBuffer, 100);
+
+    BufferProcessingManager bpm;
+    bpm.setActiveProcessor(ActiveProcessor::kGain);
+    bpm.getAutoTuner().setCacheFile(cacheFile);
+
+    SECTION("Autotune off returns the configured block size without probing")
+    {
+        bpm.setBlockSize(1024);
+        REQUIRE(bpm.resolveBlockSize(inputBuffer, numSamples, sampleRate) == 1024);
+        REQUIRE_FALSE(cacheFile.existsAsFile());
+    }
+
+    SECTION("Autotune result is a power of two in range and survives a reload")
+    {
+        // Pointed at the file before it exists: the cache is only read on first lookup.
+        BlockSizeAutoTuner reloaded;
+        reloaded.setCacheFile(cacheFile);
+
+        bpm.setAutoTuneBlockSize(true);
+        const int tuned = bpm.resolveBlockSize(inputBuffer, numSamples, sampleRate);
+
+        REQUIRE(tuned >= BlockSizeAutoTuner::kMinBlockSize);
+        REQUIRE(tuned <= BlockSizeAutoTuner::kMaxBlockSize);
+        REQUIRE(juce::isPowerOfTwo(tuned));
+        REQUIRE(cacheFile.existsAsFile());
+
+        auto* gain = bpm.getSwapper().getActiveProcessor();
+        REQUIRE(gain != nullptr);
+
+        REQUIRE(reloaded.getCachedBlockSize(gain->getName(), sampleRate, numChannels) == tuned);
+        REQUIRE(reloaded.getCachedBlockSize(gain->getName(), 96000.0, numChannels) == 0);
+    }
+
+    SECTION("Autotuned render of a block-size invariant processor matches a fixed-size render")
+    {
+        auto* gainProcessor = dynamic_cast<GainProcessor*>(bpm.getSwapper().getProcessorByIndex(ActiveProcessor::kGain));
+        REQUIRE(gainProcessor != nullptr);
+        gainProcessor->setGain(0.5f);
+
+        juce::AudioBuffer<float> fixedOutput(numChannels, numSamples);
+        fixedOutput.clear();
+        REQUIRE(bpm.processBuffers(inputBuffer, fixedOutput, numSamples, numSamples, sampleRate, 512));
+
+        bpm.setAutoTuneBlockSize(true);
+        const int tuned = bpm.resolveBlockSize(inputBuffer, numSamples, sampleRate);
+
+        juce::AudioBuffer<float> tunedOutput(numChannels, numSamples);
+        tunedOutput.clear();
+        REQUIRE(bpm.processBuffers(inputBuffer, tunedOutput, numSamples, numSamples, sampleRate, tuned));
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                REQUIRE(tunedOutput.getSample(ch, i) == fixedOutput.getSample(ch, i));
+    }
+
+    cacheFile.deleteFile();
+}
@@ -2,6 +2,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "TEST_UTILS/TestUtils.h"
+#include "TEST_UTILS/AudioThreadAudit.h"
 #include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
 #include "Processor/BufferProcessingManager.h"
 
@@ -70,4 +71,113 @@ TEST_CASE("BufferProcessingManager initialization", "[BufferProcessingManager][b
             CHECK(outputSample == 0.314f);
         }
     outputBuffer.clear();
-}
\ No newline at end of file
+}
+
+TEST_CASE("BufferProcessingManager times every block per processor and path", "[BufferProcessingManager][buffer]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    using BlockPath = BufferProcessingManager::BlockPath;
+
+    const int numChannels = 2;
+    const int numSamples  = 10 * 512 + 100;
+    juce::AudioBuffer<float> inputBuffer (numChannels, numSamples);
+    juce::AudioBuffer<float> outputBuffer (numChannels, numSamples);
+    BufferFiller::fillWithAllOnes(inputBuffer);
+
+    BufferProcessingManager bpManager;
+    bpManager.setActiveProcessor(ActiveProcessor::kGain);
+
+    //================ Offline: one sample per block, reset per render =========
+    REQUIRE(bpManager.processBuffers(inputBuffer, outputBuffer, numSamples, numSamples, 44100.0, 512));
+    REQUIRE(bpManager.processBuffers(inputBuffer, outputBuffer, numSamples, numSamples, 44100.0, 512));
+
+    const auto offline = bpManager.getBlockLatency(ActiveProcessor::kGain).getSummary();
+    CHECK(offline.count == 11);
+    CHECK(offline.worstBlock >= 0);
+    CHECK(offline.worstBlock < 11);
+    CHECK(offline.maxUs > 0.0);
+    CHECK(offline.p50Us <= offline.p99Us);
+    CHECK(offline.p99Us <= offline.p999Us);
+    CHECK(offline.p999Us <= offline.maxUs);
+
+    CHECK(bpManager.getBlockLatency(ActiveProcessor::kGrainShifter).getCount() == 0);
+    CHECK(bpManager.getBlockLatency(ActiveProcessor::kGain, BlockPath::kRealtime).getCount() == 0);
+
+    //================ Realtime: accumulates since prepareRealtime() ===========
+    bpManager.prepareRealtime(44100.0, 256);
+
+    juce::AudioBuffer<float> hostBlock(numChannels, 256);
+    juce::MidiBuffer midi;
+    for (int i = 0; i < 8; ++i)
+        REQUIRE(bpManager.processRealtimeBlock(hostBlock, midi));
+
+    CHECK(bpManager.getBlockLatency(ActiveProcessor::kGain, BlockPath::kRealtime).getCount() == 8);
+    CHECK(bpManager.getBlockLatency(ActiveProcessor::kGain).getCount() == 11);
+
+    bpManager.prepareRealtime(44100.0, 256);
+    CHECK(bpManager.getBlockLatency(ActiveProcessor::kGain, BlockPath::kRealtime).getCount() == 0);
+
+    bpManager.releaseRealtime();
+}
+
+TEST_CASE("BufferProcessingManager processes steady-state blocks without allocating or locking", "[BufferProcessingManager][buffer][realtime]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    constexpr double sampleRate  = 44100.0;
+    constexpr int    numChannels = 2;
+    constexpr int    blockSize   = 512;
+    constexpr int    numBlocks   = 200;
+    constexpr int    warmUp      = 8;
+
+    juce::AudioBuffer<float> source(numChannels, blockSize * numBlocks);
+    BufferFiller::generateSineCycles(source, numBlocks * 4);
+
+    BufferProcessingManager bpManager;
+    bpManager.getSwapper().setIsLogging(false);
+
+    // Every processor the swapper offers, so a new one is audited as soon as it is added.
+    for (int index = 0; index < bpManager.getSwapper().getNumProcessors(); ++index)
+    {
+        const auto processor = static_cast<ActiveProcessor>(index);
+        INFO("Processor " << index);
+
+        bpManager.setActiveProcessor(processor);
+        bpManager.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> block(numChannels, blockSize);
+        juce::MidiBuffer midi;
+
+        auto runBlocks = [&](int first, int count)
+        {
+            for (int i = first; i < first + count; ++i)
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                    block.copyFrom(ch, 0, source, ch, i * blockSize, blockSize);
+                bpManager.processSingleBlock(block, midi);
+            }
+        };
+
+        // First blocks after prepare may settle lazily-sized state.
+        runBlocks(0, warmUp);
+
+        int allocations = 0;
+        int locks       = 0;
+        {
+            TestUtils::ScopedAudioThreadAudit audit;
+            runBlocks(warmUp, numBlocks - warmUp);
+            allocations = audit.getNumAllocations();
+            locks       = audit.getNumLocks();
+        }
+
+        CHECK(bpManager.getBlockLatency(processor).getCount() >= numBlocks - warmUp);
+        REQUIRE(allocations == 0);
+        if (TestUtils::ScopedAudioThreadAudit::locksAreTracked())
+            REQUIRE(locks == 0);
+        else
+            WARN("Mutex interposition unavailable on this platform; locks not audited");
+
+        bpManager.releaseResources();
+    }
+}
@@ -0,0 +1,243 @@
+#include "TEST_UTILS/TestUtils.h"
+#include <catch2/catch_approx.hpp>
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "CLI/CommandLine.h"
+#include "Util/BinaryBlockLogger.h"
+#include <cstring>
+
+namespace
+{
+    juce::File getOutputDir() { return TestUtils::getModuleOutputDir("CLI"); }
+
+    juce::StringArray split(const juce::String& commandLine)
+    {
+        return juce::StringArray::fromTokens(commandLine, " ", "\"");
+    }
+}
+
+TEST_CASE("CommandLine parses render options", "[CommandLine]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    CommandLine::Options options;
+    juce::String         error;
+
+    SECTION("Full option set")
+    {
+        REQUIRE(CommandLine::parse(split("-i a.wav --input dir -o out -p GrainShifter --param shift_ratio=1.5 "
+                                         "--param pitch_threshold=0.2 -b 256 -j 4 --streaming --bit-depth 16 --dither --timing t.jsonl"),
+                                   options, error));
+
+        REQUIRE(options.inputs == juce::StringArray("a.wav", "dir"));
+        REQUIRE(options.outputDirectory == juce::File::getCurrentWorkingDirectory().getChildFile("out"));
+        REQUIRE(options.processor == CommandLine::Processor::kGrainShifter);
+        REQUIRE(options.parameters["shift_ratio"] == "1.5");
+        REQUIRE(options.parameters["pitch_threshold"] == "0.2");
+        REQUIRE(options.blockSize == 256);
+        REQUIRE(options.numThreads == 4);
+        REQUIRE(options.streaming);
+        REQUIRE(options.bitDepth == 16);
+        REQUIRE(options.dither);
+        REQUIRE(options.timingFile.getFileName() == "t.jsonl");
+        REQUIRE(options.range.isWholeFile());
+    }
+
+    SECTION("Render range in seconds")
+    {
+        REQUIRE(CommandLine::parse(split("-i a.wav -o out --start 1.5 --end 4 --pre-roll 0.25"), options, error));
+        REQUIRE(options.range.units == RenderRange::Units::kSeconds);
+        REQUIRE(options.range.start == 1.5);
+        REQUIRE(options.range.end == 4.0);
+        REQUIRE(options.range.preRoll == 0.25);
+    }
+
+    SECTION("Defaults")
+    {
+        REQUIRE(CommandLine::parse(split("-i a.wav -o out"), options, error));
+        REQUIRE(options.processor == CommandLine::Processor::kGain);
+        REQUIRE(options.blockSize == 512);
+        REQUIRE(options.numThreads == 0);
+        REQUIRE_FALSE(options.streaming);
+        REQUIRE(options.bitDepth == 24);
+    }
+
+    SECTION("Block log conversion needs no input")
+    {
+        REQUIRE(CommandLine::parse(split("--convert-block-log log.aftlog -o csv"), options, error));
+        REQUIRE(options.blockLogToConvert.getFileName() == "log.aftlog");
+        REQUIRE(options.inputs.isEmpty());
+    }
+
+    SECTION("Block log recording")
+    {
+       #if AFT_BLOCK_LOGGING
+        REQUIRE(CommandLine::parse(split("-i a.wav -o out --block-log --block-log-every 8 "
+                                         "--block-log-fraction 0.25 --block-log-seed 42"),
+                                   options, error));
+        REQUIRE(options.blockLog);
+        REQUIRE(options.blockLogEveryNth == 8);
+        REQUIRE(options.blockLogFraction == 0.25);
+        REQUIRE(options.blockLogSeed == 42);
+       #else
+        REQUIRE_FALSE(CommandLine::parse(split("-i a.wav -o out --block-log"), options, error));
+       #endif
+    }
+
+    SECTION("Help short-circuits validation")
+    {
+        REQUIRE(CommandLine::parse(split("--help"), options, error));
+        REQUIRE(options.showHelp);
+        REQUIRE(CommandLine::getUsage().contains("--threads"));
+    }
+
+    SECTION("Rejects bad input")
+    {
+        for (auto bad : { "-o out",                         // no input
+                          "-i a.wav",                       // no output
+                          "-i a.wav -o out -p reverb",      // unknown processor
+                          "-i a.wav -o out -b 0",           // block size
+                          "-i a.wav -o out -j x",           // threads
+                          "-i a.wav -o out --bit-depth 20",
+                          "-i a.wav -o out --param gain",   // no value
+                          "-i a.wav -o out --start -1",     // negative time
+                          "-i a.wav -o out --start 2 --end 1",
+                          "-i a.wav -o out --frobnicate",
+                          "-i a.wav -o out -p tdpsola --block-log",
+                          "-i a.wav -o out --block-log-every 0",
+                          "-i a.wav -o out --block-log-fraction 1.5",
+                          "-i a.wav -o out --block-log-seed -3",
+                          "-i a.wav -o" })                  // missing value
+        {
+            INFO(bad);
+            error.clear();
+            REQUIRE_FALSE(CommandLine::parse(split(bad), options, error));
+            REQUIRE(error.isNotEmpty());
+        }
+    }
+}
+
+TEST_CASE("CommandLine expands files, folders and patterns", "[CommandLine][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    const auto dir = getOutputDir().getChildFile("expand");
+    dir.deleteRecursively();
+    dir.createDirectory();
+
+    const auto b = TestUtils::writeSineWav(dir.getChildFile("b.wav"), 1, 44100.0, 0.1, 220.0);
+    const auto a = TestUtils::writeSineWav(dir.getChildFile("a.wav"), 1, 44100.0, 0.1, 220.0);
+    dir.getChildFile("notes.txt").replaceWithText("not audio");
+
+    const auto fromFolder  = CommandLine::expandInputs({ dir.getFullPathName() });
+    const auto fromPattern = CommandLine::expandInputs({ dir.getChildFile("*.wav").getFullPathName() });
+
+    REQUIRE(fromFolder.size() == 2);
+    REQUIRE(fromFolder[0] == a);
+    REQUIRE(fromFolder[1] == b);
+    REQUIRE(fromPattern == fromFolder);
+
+    // Overlapping inputs are de-duplicated; a missing file is kept so its job can report it.
+    const auto mixed = CommandLine::expandInputs({ b.getFullPathName(), dir.getFullPathName(), dir.getChildFile("gone.wav").getFullPathName() });
+    REQUIRE(mixed.size() == 3);
+    REQUIRE(mixed[0] == b);
+    REQUIRE(mixed[2].getFileName() == "gone.wav");
+}
+
+TEST_CASE("CommandLine renders jobs and emits JSON timing", "[CommandLine][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    const auto inputDir  = getOutputDir().getChildFile("run_inputs");
+    const auto outputDir = getOutputDir().getChildFile("run_outputs");
+    inputDir.deleteRecursively();
+    outputDir.deleteRecursively();
+    inputDir.createDirectory();
+
+    for (int i = 0; i < 4; ++i)
+        TestUtils::writeSineWav(inputDir.getChildFile("job_" + juce::String(i) + ".wav"), 1, 44100.0, 0.25, 220.0);
+
+    juce::StringArray lines;
+    auto collect = [&] (const juce::String& line) { lines.add(line); };
+
+    auto runWith = [&] (const juce::String& extraArgs)
+    {
+        lines.clear();
+        CommandLine::Options options;
+        juce::String         error;
+        REQUIRE(CommandLine::parse(split("-i " + inputDir.getChildFile("*.wav").getFullPathName()
+                                         + " -o " + outputDir.getFullPathName() + " " + extraArgs),
+                                   options, error));
+        const int exitCode = CommandLine::run(options, collect, error);
+        INFO(error);
+        return exitCode;
+    };
+
+    SECTION("gain via transformFile on two threads")
+    {
+        REQUIRE(runWith("-p gain --param gain=0.5 -j 2 -b 128") == 0);
+        REQUIRE(lines.size() == 5);
+
+        juce::Array<int> threadsSeen;
+        for (int i = 0; i < 4; ++i)
+        {
+            const auto record = juce::JSON::parse(lines[i]);
+            REQUIRE(record.isObject());
+            REQUIRE(record["status"].toString() == "ok");
+            REQUIRE(record["processor"].toString() == "gain");
+            REQUIRE(static_cast<double>(record["wallSeconds"]) > 0.0);
+            REQUIRE(static_cast<double>(record["audioSeconds"]) == Catch::Approx(0.25).margin(1e-3));
+            REQUIRE(juce::File(record["output"].toString()).existsAsFile());
+            threadsSeen.addIfNotAlreadyThere(static_cast<int>(record["thread"]));
+        }
+        REQUIRE(threadsSeen.size() <= 2);
+
+        const auto summary = juce::JSON::parse(lines[4]);
+        REQUIRE(static_cast<bool>(summary["summary"]));
+        REQUIRE(static_cast<int>(summary["jobs"]) == 4);
+        REQUIRE(static_cast<int>(summary["succeeded"]) == 4);
+        REQUIRE(static_cast<int>(summary["threads"]) == 2);
+    }
+
+    SECTION("--block-log records a sampled log beside each output")
+    {
+       #if ! AFT_BLOCK_LOGGING
+        WARN("Built with AFT_BLOCK_LOGGING=0; --block-log is rejected");
+        return;
+       #endif
+
+        REQUIRE(runWith("-p gain --param gain=0.5 -j 2 -b 128 --block-log --block-log-every 4") == 0);
+        REQUIRE(lines.size() == 5);
+
+        const auto record  = juce::JSON::parse(lines[0]);
+        const auto logFile = juce::File(record["blockLog"].toString());
+        REQUIRE(logFile == juce::File(record["output"].toString()).withFileExtension("aftlog"));
+        REQUIRE(logFile.existsAsFile());
+
+        juce::MemoryBlock data;
+        REQUIRE(logFile.loadFileAsData(data));
+        BinaryBlockLogger::FileHeader header {};
+        std::memcpy(&header, data.getData(), sizeof(header));
+        REQUIRE(header.sampleEveryNth == 4);
+        REQUIRE(header.numRecords > 0);
+
+        const auto csvDir = outputDir.getChildFile("block_log_csv");
+        juce::String error;
+        REQUIRE(BinaryBlockLogger::convertToCsv(logFile, csvDir, error));
+        REQUIRE(csvDir.getChildFile("input_samples.csv").existsAsFile());
+        REQUIRE(csvDir.getChildFile("output_samples.csv").existsAsFile());
+    }
+
+    SECTION("tdpsola")
+    {
+        REQUIRE(runWith("-p tdpsola --param ratio=1.25 -j 2") == 0);
+        REQUIRE(lines.size() == 5);
+        REQUIRE(juce::JSON::parse(lines[0])["processor"].toString() == "tdpsola");
+        REQUIRE(outputDir.getChildFile("job_0.wav").existsAsFile());
+    }
+
+    SECTION("Unknown parameter stops the run before any job")
+    {
+        REQUIRE(runWith("-p gain --param shift_ratio=2") == 2);
+        REQUIRE(lines.isEmpty());
+    }
+}
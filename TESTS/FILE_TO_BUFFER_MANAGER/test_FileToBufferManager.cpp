@@ -3,6 +3,8 @@
 #include "Processor/PluginProcessor.h"
 #include "Processor/FileToBufferManager.h"
 #include "Processor/BufferProcessingManager.h"
+#include "Util/FileUtils.h"
+#include "BufferFiller.h"
 #include <catch2/catch_test_macros.hpp>
 
 #include <atomic>
@@ -23,18 +25,6 @@ namespace
                 return f;
         return {};
     }
-
-    void waitForCompletion(FileToBufferManager& fbm, int timeoutMs = 300000)
-    {
-        const auto start = std::chrono::steady_clock::now();
-        while (fbm.isProcessing())
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
-            if (std::chrono::duration_cast<std::chrono::milliseconds>(
-                    std::chrono::steady_clock::now() - start).count() > timeoutMs)
-                break;
-        }
-    }
 }
 
 TEST_CASE("FileToBufferManager threaded load->process->write end-to-end",
@@ -71,24 +61,22 @@ TEST_CASE("FileToBufferManager threaded load->process->write end-to-end",
 
     SECTION("startProcessing succeeds and produces an output WAV")
     {
-        REQUIRE(fbm.startProcessing(processor.getInputBuffer(),
-                                    processor.getProcessedBuffer(),
-                                    processor.getBufferProcessingManager()));
-        waitForCompletion(fbm);
+        outputDir.getChildFile("Transformation_Data.md").deleteFile();
+        REQUIRE(fbm.startProcessing(processor.getOfflineRenderer()));
+        TestUtils::waitForCompletion(fbm);
 
         REQUIRE_FALSE(fbm.isProcessing());
         INFO("FBM error: " << fbm.getError().toStdString());
         REQUIRE(fbm.wasSuccessful());
         REQUIRE(callbackCount.load() > 0);
         REQUIRE(lastProgress.load() == 1.0f);
+        REQUIRE(outputDir.getChildFile("Transformation_Data.md").existsAsFile());
     }
 
     SECTION("Missing input file fails validation, no thread spawned")
     {
         fbm.setInputFile(juce::File("C:\\does\\not\\exist.wav"));
-        REQUIRE_FALSE(fbm.startProcessing(processor.getInputBuffer(),
-                                          processor.getProcessedBuffer(),
-                                          processor.getBufferProcessingManager()));
+        REQUIRE_FALSE(fbm.startProcessing(processor.getOfflineRenderer()));
         REQUIRE_FALSE(fbm.isProcessing());
         REQUIRE(fbm.getError().isNotEmpty());
     }
@@ -105,15 +93,22 @@ TEST_CASE("FileToBufferManager synchronous load + write helpers",
     FileToBufferManager fbm;
     fbm.setInputFile(inputFile);
 
-    juce::AudioBuffer<float> dest(2, AudioFileTransformerProcessor::kStorageSamples);
+    double      headerRate     = 0.0;
+    int         headerChannels = 0;
+    juce::int64 headerLength   = 0;
+    REQUIRE(FileUtils::readAudioFileInfo(inputFile, headerRate, headerChannels, headerLength));
+
+    const int storageSamples = static_cast<int>(headerLength);
+    juce::AudioBuffer<float> dest(2, storageSamples);
     dest.clear();
 
     double sampleRate    = 0.0;
     int    samplesRead   = 0;
     REQUIRE(fbm.loadInputToBuffer(dest,
-                                   AudioFileTransformerProcessor::kStorageSamples,
+                                   storageSamples,
                                    sampleRate,
                                    samplesRead));
+    REQUIRE(samplesRead == storageSamples);
     REQUIRE(samplesRead > 0);
     REQUIRE(sampleRate > 0.0);
 
@@ -127,3 +122,76 @@ TEST_CASE("FileToBufferManager synchronous load + write helpers",
     REQUIRE(outFile.existsAsFile());
     REQUIRE(outFile.getSize() > 0);
 }
+
+TEST_CASE("FileToBufferManager cancel unwinds the worker within a few blocks",
+          "[FileToBufferManager][file][cancel]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    auto outputDir = juce::File::getCurrentWorkingDirectory()
+                       .getChildFile("TESTS/FILE_TO_BUFFER_MANAGER/OUTPUT");
+    if (! outputDir.exists())
+        outputDir.createDirectory();
+
+    // Long enough that the GrainShifter render cannot finish before the cancel lands.
+    constexpr double sampleRate = 44100.0;
+    constexpr int    numSamples = static_cast<int>(sampleRate * 30.0);
+    juce::AudioBuffer<float> source(2, numSamples);
+    BufferFiller::generateSineCycles(source, 100);
+    auto inputFile = outputDir.getChildFile("cancel_input.wav");
+    REQUIRE(FileUtils::writeBufferToWav(source, inputFile, sampleRate, numSamples));
+
+    auto runDir = outputDir.getChildFile("cancel_run");
+    runDir.deleteRecursively();
+
+    AudioFileTransformerProcessor processor;
+    processor.setIsLogging(false);
+    processor.setActiveProcessor(ActiveProcessor::kGrainShifter);
+
+    auto& fbm = processor.getFileToBufferManager();
+    fbm.setInputFile(inputFile);
+    fbm.setOutputDirectory(runDir);
+
+    REQUIRE(fbm.startProcessing(processor.getOfflineRenderer()));
+
+    SECTION("Pause holds the worker, cancel releases it")
+    {
+        fbm.pauseProcessing();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        REQUIRE(fbm.isProcessing());
+        REQUIRE(fbm.isPaused());
+
+        const auto start = std::chrono::steady_clock::now();
+        fbm.cancelProcessing();
+        TestUtils::waitForCompletion(fbm, 2000);
+        const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::steady_clock::now() - start).count();
+
+        REQUIRE_FALSE(fbm.isProcessing());
+        REQUIRE(elapsedMs < 1000);
+    }
+
+    SECTION("stopProcessing joins quickly instead of timing out")
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        const auto start = std::chrono::steady_clock::now();
+        fbm.stopProcessing();
+        const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::steady_clock::now() - start).count();
+
+        REQUIRE_FALSE(fbm.isProcessing());
+        REQUIRE(elapsedMs < 1000);
+    }
+
+    REQUIRE(fbm.wasCancelled());
+    REQUIRE_FALSE(fbm.wasSuccessful());
+    REQUIRE(fbm.getError() == "Cancelled");
+
+    juce::Array<juce::File> wavs;
+    runDir.findChildFiles(wavs, juce::File::findFiles, false, "*.wav");
+    REQUIRE(wavs.isEmpty());
+
+    // No sidecar describing a render that never happened.
+    REQUIRE_FALSE(runDir.getChildFile("Transformation_Data.md").exists());
+}
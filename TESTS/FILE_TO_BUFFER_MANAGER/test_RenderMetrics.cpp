@@ -0,0 +1,178 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "TEST_UTILS/SignalGenerator.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Processor/PluginProcessor.h"
+#include "Processor/FileToBufferManager.h"
+#include "Processor/OfflineRenderer.h"
+#include "Processor/RenderMetrics.h"
+#include "Processor/StoragePool.h"
+#include <catch2/catch_approx.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <thread>
+
+namespace
+{
+    juce::File getOutputDir() { return TestUtils::getModuleOutputDir("FILE_TO_BUFFER_MANAGER"); }
+
+    juce::File writeSpeechInput(double seconds)
+    {
+        TestUtils::SignalSpec spec;
+        spec.type        = TestUtils::SignalType::kSpeechMix;
+        spec.numChannels = 2;
+        spec.seconds     = seconds;
+
+        auto file = getOutputDir().getChildFile("metrics_input.wav");
+        REQUIRE(TestUtils::writeSignalToWav(spec, file));
+        return file;
+    }
+
+    void requireConsistent(const RenderMetrics& metrics)
+    {
+        REQUIRE(metrics.isValid());
+        REQUIRE(metrics.load.wallSeconds >= 0.0);
+        REQUIRE(metrics.process.wallSeconds > 0.0);
+        REQUIRE(metrics.write.wallSeconds >= 0.0);
+        REQUIRE(metrics.total.cpuSeconds >= 0.0);
+        REQUIRE(metrics.getRealtimeFactor() > 0.0);
+        REQUIRE(metrics.peakStorageBytes > 0);
+
+        // Sequential phases tile the total; overlapped stages can't each outlast it.
+        const double phaseSum = metrics.load.wallSeconds + metrics.process.wallSeconds + metrics.write.wallSeconds;
+        if (metrics.isOverlapped())
+            REQUIRE(juce::jmax(metrics.load.wallSeconds, metrics.process.wallSeconds, metrics.write.wallSeconds)
+                    <= metrics.total.wallSeconds + 1.0e-3);
+        else
+            REQUIRE(phaseSum == Catch::Approx(metrics.total.wallSeconds).margin(1.0e-3));
+    }
+}
+
+TEST_CASE("RenderPhaseWeights follow measured buffered renders", "[RenderMetrics]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    RenderPhaseWeights weights;
+    REQUIRE(weights.load + weights.process + weights.write == Catch::Approx(1.0f));
+
+    RenderMetrics metrics;
+    metrics.load.wallSeconds    = 1.0;
+    metrics.process.wallSeconds = 2.0;
+    metrics.write.wallSeconds   = 1.0;
+    metrics.total.wallSeconds   = 4.0;
+
+    weights.update(metrics, 0.0f);
+    REQUIRE(weights.load    == Catch::Approx(0.25f));
+    REQUIRE(weights.process == Catch::Approx(0.5f));
+    REQUIRE(weights.write   == Catch::Approx(0.25f));
+
+    // Half-way blend towards an all-process render
+    metrics.load.wallSeconds  = 0.0;
+    metrics.write.wallSeconds = 0.0;
+    weights.update(metrics, 0.5f);
+    REQUIRE(weights.load    == Catch::Approx(0.125f));
+    REQUIRE(weights.process == Catch::Approx(0.75f));
+    REQUIRE(weights.write   == Catch::Approx(0.125f));
+
+    // Streaming stages overlap; their busy times say nothing about sequential shares.
+    metrics.overlapped = true;
+    weights.update(metrics, 0.0f);
+    REQUIRE(weights.process == Catch::Approx(0.75f));
+}
+
+TEST_CASE("FileToBufferManager records per-phase metrics and appends them to the sidecar",
+          "[RenderMetrics][FileToBufferManager][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    constexpr double seconds = 10.0;
+    const auto inputFile = writeSpeechInput(seconds);
+
+    auto runDir = getOutputDir().getChildFile("metrics_run");
+    runDir.deleteRecursively();
+
+    AudioFileTransformerProcessor processor;
+    processor.setIsLogging(false);
+    processor.setActiveProcessor(ActiveProcessor::kGain);
+
+    auto& fbm = processor.getFileToBufferManager();
+    fbm.setInputFile(inputFile);
+    fbm.setOutputDirectory(runDir);
+    REQUIRE(fbm.getEstimatedSecondsRemaining() < 0.0);
+
+    std::mutex         progressLock;
+    std::vector<float> progressValues;
+    fbm.setProgressCallback([&](float p)
+    {
+        const std::lock_guard<std::mutex> lock(progressLock);
+        progressValues.push_back(p);
+    });
+
+    const auto defaults = processor.getOfflineRenderer().getPhaseWeights();
+
+    REQUIRE(fbm.startProcessing(processor.getOfflineRenderer()));
+    while (fbm.isProcessing())
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    INFO("FBM error: " << fbm.getError().toStdString());
+    REQUIRE(fbm.wasSuccessful());
+    REQUIRE(fbm.getProgress() == 1.0f);
+
+    const auto& metrics = fbm.getLastMetrics();
+    requireConsistent(metrics);
+    REQUIRE_FALSE(metrics.isOverlapped());
+
+    // Written audio is at least the input; storage at least the two stereo leases.
+    const int numSamples = static_cast<int>(seconds * 44100.0);
+    REQUIRE(metrics.audioSeconds >= seconds - 1.0e-6);
+    REQUIRE(metrics.peakStorageBytes >= 2 * StoragePool::bytesFor(2, numSamples));
+    REQUIRE(metrics.memory.peakBytes >= static_cast<juce::int64>(2 * StoragePool::bytesFor(2, numSamples)));
+
+    // Weighted progress never steps backwards.
+    for (size_t i = 1; i < progressValues.size(); ++i)
+        REQUIRE(progressValues[i] >= progressValues[i - 1]);
+
+    // The next render's progress spans reflect this one.
+    const auto& weights = processor.getOfflineRenderer().getPhaseWeights();
+    REQUIRE(weights.load + weights.process + weights.write == Catch::Approx(1.0f).margin(1.0e-4));
+    REQUIRE(weights.process != defaults.process);
+
+    const auto sidecar = runDir.getChildFile("Transformation_Data.md").loadFileAsString();
+    REQUIRE(sidecar.contains("## Parameter State"));
+    REQUIRE(sidecar.contains("## Render Metrics"));
+    REQUIRE(sidecar.contains("Realtime Factor"));
+    REQUIRE(sidecar.contains("Peak Memory"));
+
+    WARN(metrics.toMarkdown().toStdString());
+}
+
+TEST_CASE("Streaming renders report overlapped stage metrics", "[RenderMetrics][StreamingRenderPipeline][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    constexpr double seconds = 10.0;
+    const auto inputFile  = writeSpeechInput(seconds);
+    const auto outputFile = getOutputDir().getChildFile("metrics_streamed.wav");
+
+    AudioFileTransformerProcessor processor;
+    processor.setIsLogging(false);
+    processor.setActiveProcessor(ActiveProcessor::kGain);
+
+    auto& renderer = processor.getOfflineRenderer();
+    renderer.setRenderMode(OfflineRenderer::RenderMode::kStreaming);
+    const auto weightsBefore = renderer.getPhaseWeights();
+
+    REQUIRE(processor.transformFile(inputFile, outputFile));
+
+    const auto& metrics = renderer.getLastMetrics();
+    requireConsistent(metrics);
+    REQUIRE(metrics.isOverlapped());
+    REQUIRE(metrics.audioSeconds >= seconds - 1.0e-6);
+    REQUIRE(metrics.peakStorageBytes == renderer.getStreamingPipeline().getStorageBytes());
+
+    // Streaming progress follows the writer; buffered weights are untouched.
+    REQUIRE(renderer.getPhaseWeights().process == weightsBefore.process);
+
+    WARN(metrics.toMarkdown().toStdString());
+}
@@ -267,7 +267,8 @@ TEST_CASE("AudioFileTransformerProcessor processes Somewhere_Stereo with logging
 
     auto processorOutputDir = processor.getDataLogOutputDirectory();
 
-    // Load full file into processor's input storage.
+    // Size pooled storage from the file header, then load the full file into it.
+    REQUIRE(processor.prepareStorageForFile(inputFile));
     auto& inputBuffer  = processor.getInputBuffer();
     auto& outputBuffer = processor.getProcessedBuffer();
 
@@ -0,0 +1,147 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "TEST_UTILS/AudioThreadAudit.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Processor/PluginProcessor.h"
+#include "BufferFiller.h"
+#include <catch2/catch_approx.hpp>
+
+namespace
+{
+    /** Feeds source through the processor in host blocks; returns the output. */
+    juce::AudioBuffer<float> runHostBlocks(AudioFileTransformerProcessor& processor,
+                                           const juce::AudioBuffer<float>& source,
+                                           int hostBlockSize)
+    {
+        juce::AudioBuffer<float> output(source.getNumChannels(), source.getNumSamples());
+        juce::AudioBuffer<float> block(source.getNumChannels(), hostBlockSize);
+        juce::MidiBuffer         midi;
+
+        for (int position = 0; position < source.getNumSamples(); position += hostBlockSize)
+        {
+            const int n = juce::jmin(hostBlockSize, source.getNumSamples() - position);
+            block.setSize(block.getNumChannels(), n, false, false, true);
+
+            for (int ch = 0; ch < source.getNumChannels(); ++ch)
+                block.copyFrom(ch, 0, source, ch, position, n);
+
+            processor.processBlock(block, midi);
+
+            for (int ch = 0; ch < source.getNumChannels(); ++ch)
+                output.copyFrom(ch, position, block, ch, 0, n);
+        }
+
+        return output;
+    }
+}
+
+TEST_CASE("Non-realtime live mode accumulates host blocks and reports the added latency", "[AudioFileTransformer][processor][live][bounce]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    constexpr double sampleRate = 44100.0;
+    constexpr int    hostBlock  = 64;
+    constexpr int    numSamples = 16384;
+
+    AudioFileTransformerProcessor processor;
+    processor.setIsLogging(false);
+    processor.setActiveProcessor(ActiveProcessor::kGain);
+    TestUtils::setGain(processor, 0.5f);
+    processor.setLiveMode(true);
+
+    SECTION("realtime host: no accumulation")
+    {
+        processor.setNonRealtime(false);
+        processor.prepareToPlay(sampleRate, hostBlock);
+        REQUIRE_FALSE(processor.isAccumulatingBounce());
+        REQUIRE(processor.getLatencySamples() == processor.getGainNode()->getLatencySamples());
+    }
+
+    SECTION("host block already at the accumulator size: no accumulation")
+    {
+        processor.setNonRealtime(true);
+        processor.prepareToPlay(sampleRate, BlockAccumulator::kDefaultBlockSize);
+        REQUIRE_FALSE(processor.isAccumulatingBounce());
+    }
+
+    SECTION("bounce: delayed by the reported latency, no audio-thread allocation")
+    {
+        processor.setNonRealtime(true);
+        processor.prepareToPlay(sampleRate, hostBlock);
+        REQUIRE(processor.isAccumulatingBounce());
+
+        const int latency = processor.getLatencySamples();
+        REQUIRE(latency == BlockAccumulator::kDefaultBlockSize + processor.getGainNode()->getLatencySamples());
+
+        juce::AudioBuffer<float> source(2, numSamples);
+        BufferFiller::generateSineCycles(source, 64);
+
+        juce::AudioBuffer<float> output(2, numSamples);
+        juce::AudioBuffer<float> block(2, hostBlock);
+        juce::MidiBuffer         midi;
+
+        int allocations = 0;
+        {
+            TestUtils::ScopedAudioThreadAudit audit;
+            for (int position = 0; position < numSamples; position += hostBlock)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                    block.copyFrom(ch, 0, source, ch, position, hostBlock);
+                processor.processBlock(block, midi);
+                for (int ch = 0; ch < 2; ++ch)
+                    output.copyFrom(ch, position, block, ch, 0, hostBlock);
+            }
+            allocations = audit.getNumAllocations();
+        }
+
+        REQUIRE(allocations == 0);
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (int i = 0; i < latency; ++i)
+                REQUIRE(output.getSample(ch, i) == 0.0f);
+            for (int i = latency; i < numSamples; ++i)
+                REQUIRE(output.getSample(ch, i) == Catch::Approx(0.5f * source.getSample(ch, i - latency)).margin(1.0e-6));
+        }
+    }
+
+    processor.releaseResources();
+}
+
+TEST_CASE("Bounce accumulation realtime factor vs native host blocks", "[AudioFileTransformer][processor][live][bounce][benchmark]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    constexpr double sampleRate = 44100.0;
+    constexpr int    hostBlock  = 64;
+    constexpr double seconds    = 20.0;
+
+    juce::AudioBuffer<float> source(2, static_cast<int>(sampleRate * seconds));
+    BufferFiller::generateSineCycles(source, static_cast<int>(seconds * 220.0));
+
+    auto measureRtf = [&] (bool nonRealtime)
+    {
+        AudioFileTransformerProcessor processor;
+        processor.setIsLogging(false);
+        processor.setActiveProcessor(ActiveProcessor::kGrainShifter);
+        processor.setLiveMode(true);
+        processor.setNonRealtime(nonRealtime);
+        processor.prepareToPlay(sampleRate, hostBlock);
+        REQUIRE(processor.isAccumulatingBounce() == nonRealtime);
+
+        const double startMs = juce::Time::getMillisecondCounterHiRes();
+        const auto   output  = runHostBlocks(processor, source, hostBlock);
+        const double wallMs  = juce::Time::getMillisecondCounterHiRes() - startMs;
+
+        REQUIRE_FALSE(TestUtils::isSilent(output));
+        processor.releaseResources();
+        return seconds / (wallMs / 1000.0);
+    };
+
+    const double nativeRtf      = measureRtf(false);
+    const double accumulatedRtf = measureRtf(true);
+
+    WARN("GrainShifter offline bounce, " << hostBlock << "-sample host blocks: native "
+         << juce::String(nativeRtf, 1) << "x realtime, accumulated to "
+         << BlockAccumulator::kDefaultBlockSize << ": " << juce::String(accumulatedRtf, 1)
+         << "x realtime (" << juce::String(accumulatedRtf / nativeRtf, 2) << "x)");
+}
@@ -0,0 +1,167 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "TEST_UTILS/AudioThreadAudit.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Processor/PluginProcessor.h"
+#include "BufferFiller.h"
+#include <catch2/catch_approx.hpp>
+
+namespace
+{
+    /** Runs live blocks under the audit after a warm-up and requires a clean audio thread. */
+    void auditLiveBlocks(ActiveProcessor active)
+    {
+        constexpr double sampleRate = 44100.0;
+        constexpr int    blockSize  = 512;
+        constexpr int    numBlocks  = 200;
+        constexpr int    warmUp     = 8;
+
+        AudioFileTransformerProcessor processor;
+        processor.setIsLogging(false);
+        processor.setActiveProcessor(active);
+        processor.setLiveMode(true);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> source(2, blockSize * numBlocks);
+        BufferFiller::generateSineCycles(source, numBlocks * 4);
+
+        juce::AudioBuffer<float> block(2, blockSize);
+        juce::MidiBuffer         midi;
+
+        auto runBlocks = [&] (int first, int count)
+        {
+            for (int i = first; i < first + count; ++i)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                    block.copyFrom(ch, 0, source, ch, i * blockSize, blockSize);
+                processor.processBlock(block, midi);
+            }
+        };
+
+        // First blocks after prepare may settle lazily-sized state.
+        runBlocks(0, warmUp);
+
+        int allocations = 0;
+        int locks       = 0;
+        {
+            TestUtils::ScopedAudioThreadAudit audit;
+            runBlocks(warmUp, numBlocks - warmUp);
+            allocations = audit.getNumAllocations();
+            locks       = audit.getNumLocks();
+        }
+
+        REQUIRE(allocations == 0);
+        if (TestUtils::ScopedAudioThreadAudit::locksAreTracked())
+            REQUIRE(locks == 0);
+        else
+            WARN("Mutex interposition unavailable on this platform; locks not audited");
+
+        processor.releaseResources();
+    }
+}
+
+TEST_CASE("Live mode transforms the host input through the active processor", "[AudioFileTransformer][processor][live]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    constexpr double sampleRate = 48000.0;
+    constexpr int    blockSize  = 256;
+
+    AudioFileTransformerProcessor processor;
+    processor.setIsLogging(false);
+    processor.setActiveProcessor(ActiveProcessor::kGain);
+    TestUtils::setGain(processor, 0.5f);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    juce::AudioBuffer<float> block(2, blockSize);
+    juce::MidiBuffer         midi;
+
+    SECTION("off by default: offline-only silence")
+    {
+        REQUIRE_FALSE(processor.isLiveMode());
+        BufferFiller::fillWithAllOnes(block);
+        processor.processBlock(block, midi);
+        REQUIRE(TestUtils::isSilent(block, 0.0f));
+    }
+
+    SECTION("gain applied in place")
+    {
+        processor.setLiveMode(true);
+        REQUIRE(processor.getLatencySamples() == 0);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            BufferFiller::fillWithAllOnes(block);
+            processor.processBlock(block, midi);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int s = 0; s < blockSize; ++s)
+                    REQUIRE(block.getSample(ch, s) == Catch::Approx(0.5f).margin(1.0e-6));
+        }
+    }
+
+    SECTION("silent while an offline render holds the processors")
+    {
+        processor.setLiveMode(true);
+
+        {
+            BufferProcessingManager::ScopedOfflineUse offlineUse(processor.getBufferProcessingManager());
+            BufferFiller::fillWithAllOnes(block);
+            processor.processBlock(block, midi);
+            REQUIRE(TestUtils::isSilent(block, 0.0f));
+        }
+
+        // Released: re-prepared for the host and live again.
+        BufferFiller::fillWithAllOnes(block);
+        processor.processBlock(block, midi);
+        REQUIRE(block.getSample(0, blockSize - 1) == Catch::Approx(0.5f).margin(1.0e-6));
+    }
+
+    SECTION("an offline render hands the processors back prepared for the host")
+    {
+        processor.setLiveMode(true);
+
+        juce::AudioBuffer<float> input(2, 4096);
+        juce::AudioBuffer<float> output(2, 4096);
+        BufferFiller::fillWithAllOnes(input);
+        REQUIRE(processor.getBufferProcessingManager().processBuffers(input, output, 4096, 4096, 44100.0, 1024));
+
+        BufferFiller::fillWithAllOnes(block);
+        processor.processBlock(block, midi);
+        REQUIRE(block.getSample(1, 0) == Catch::Approx(0.5f).margin(1.0e-6));
+    }
+
+    processor.releaseResources();
+}
+
+TEST_CASE("Live mode reports the active processor's latency", "[AudioFileTransformer][processor][live]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    AudioFileTransformerProcessor processor;
+    processor.setIsLogging(false);
+    processor.setActiveProcessor(ActiveProcessor::kGrainShifter);
+    processor.prepareToPlay(44100.0, 512);
+
+    const int shifterLatency = processor.getGrainShifterNode()->getLatencySamples();
+
+    REQUIRE(processor.getLatencySamples() == 0);
+
+    processor.setLiveMode(true);
+    REQUIRE(processor.getLatencySamples() == shifterLatency);
+
+    processor.setActiveProcessor(ActiveProcessor::kGain);
+    REQUIRE(processor.getLatencySamples() == processor.getGainNode()->getLatencySamples());
+
+    processor.setLiveMode(false);
+    REQUIRE(processor.getLatencySamples() == 0);
+
+    processor.releaseResources();
+}
+
+TEST_CASE("Live audio-thread path neither allocates nor locks", "[AudioFileTransformer][processor][live][realtime]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    SECTION("Gain")         { auditLiveBlocks(ActiveProcessor::kGain); }
+    SECTION("GrainShifter") { auditLiveBlocks(ActiveProcessor::kGrainShifter); }
+}
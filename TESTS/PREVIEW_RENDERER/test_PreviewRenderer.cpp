@@ -0,0 +1,146 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Processor/PluginProcessor.h"
+#include "Processor/PreviewRenderer.h"
+#include "Util/FileUtils.h"
+#include "BufferFiller.h"
+
+namespace
+{
+    juce::File getOutputDir() { return TestUtils::getModuleOutputDir("PREVIEW_RENDERER"); }
+}
+
+TEST_CASE("PreviewRenderer renders a region and plays it through doProcessBlock", "[PreviewRenderer][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    constexpr double sampleRate = 44100.0;
+    constexpr int    blockSize  = 512;
+
+    const auto input = TestUtils::writeSineWav(getOutputDir().getChildFile("preview_source.wav"), 2, sampleRate, 5.0);
+
+    AudioFileTransformerProcessor processor;
+    processor.setIsLogging(false);
+    processor.setActiveProcessor(ActiveProcessor::kGain);
+    TestUtils::setGain(processor, 0.5f);
+    processor.getFileToBufferManager().setInputFile(input);
+
+    // Silent until a preview is playing.
+    processor.prepareToPlay(sampleRate, blockSize);
+    {
+        juce::AudioBuffer<float> block(2, blockSize);
+        juce::MidiBuffer         midi;
+        BufferFiller::fillWithAllOnes(block);
+        processor.processBlock(block, midi);
+        REQUIRE(TestUtils::isSilent(block, 0.0f));
+    }
+
+    const auto range = RenderRange::inSeconds(1.0, 2.0);
+    REQUIRE(processor.startPreviewRender(range));
+
+    auto& preview = processor.getPreviewRenderer();
+    REQUIRE(preview.waitUntilReady(30000));
+    REQUIRE(preview.isPlaying());
+    REQUIRE(preview.getSampleRate() == sampleRate);
+    REQUIRE(preview.getNumSamples() >= static_cast<int>(sampleRate));
+
+    // Reference: the same region through the plugin's own manager.
+    juce::AudioBuffer<float> regionIn(2, static_cast<int>(sampleRate));
+    double sr   = 0.0;
+    int    chs  = 0;
+    int    read = 0;
+    REQUIRE(FileUtils::loadWavIntoBuffer(input, regionIn, regionIn.getNumSamples(), sr, chs, read,
+                                         nullptr, nullptr, FileUtils::ReadStrategy::kAuto,
+                                         static_cast<juce::int64>(sampleRate)));
+
+    juce::AudioBuffer<float> reference(2, preview.getNumSamples());
+    REQUIRE(processor.getBufferProcessingManager().processBuffers(regionIn, reference, read, reference.getNumSamples(),
+                                                                  sampleRate, processor.getBufferProcessingManager().getBlockSize()));
+
+    // The realtime path plays the preview block by block, then falls silent.
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    juce::AudioBuffer<float> block(2, blockSize);
+    juce::MidiBuffer         midi;
+    int                      position = 0;
+
+    while (position < reference.getNumSamples())
+    {
+        processor.processBlock(block, midi);
+
+        const int valid = juce::jmin(blockSize, reference.getNumSamples() - position);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < valid; ++i)
+                REQUIRE(block.getSample(ch, i) == reference.getSample(ch, position + i));
+
+        position += blockSize;
+    }
+
+    REQUIRE_FALSE(preview.isPlaying());
+    processor.processBlock(block, midi);
+    REQUIRE(TestUtils::isSilent(block, 0.0f));
+
+    // play() restarts from the top.
+    preview.play();
+    processor.processBlock(block, midi);
+    REQUIRE(block.getSample(0, 10) == reference.getSample(0, 10));
+
+    processor.releaseResources();
+}
+
+TEST_CASE("PreviewRenderer is playable before the full render finishes", "[PreviewRenderer][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    constexpr double sampleRate = 44100.0;
+    const auto input     = TestUtils::writeSineWav(getOutputDir().getChildFile("preview_long_source.wav"), 2, sampleRate, 60.0);
+    const auto outputDir = getOutputDir().getChildFile("full");
+
+    AudioFileTransformerProcessor processor;
+    processor.setIsLogging(false);
+    processor.setActiveProcessor(ActiveProcessor::kGrainShifter);
+
+    auto& fbm = processor.getFileToBufferManager();
+    fbm.setInputFile(input);
+    fbm.setOutputDirectory(outputDir);
+
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+    REQUIRE(processor.startFileRender(true));
+    REQUIRE(fbm.getThreadPriority() == juce::Thread::Priority::low);
+
+    auto& preview = processor.getPreviewRenderer();
+    REQUIRE(preview.waitUntilReady(60000));
+    const bool fullStillRunning = fbm.isProcessing();
+
+    while (fbm.isProcessing())
+        juce::Thread::sleep(5);
+    const double fullMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+
+    REQUIRE(fbm.wasSuccessful());
+    REQUIRE(preview.getNumSamples() >= static_cast<int>(sampleRate * PreviewRenderer::kDefaultPreviewSeconds));
+
+    // Whether the full render was still running when the preview became ready
+    // depends on the scheduler, so it is reported rather than asserted.
+    WARN("Preview latency (first " << PreviewRenderer::kDefaultPreviewSeconds << " s of 60 s, GrainShifter): "
+         << juce::String(preview.getLatencyMs(), 1) << " ms; full render " << juce::String(fullMs, 1) << " ms"
+         << (fullStillRunning ? "" : " (full render finished first)"));
+
+    REQUIRE(preview.getLatencyMs() < fullMs);
+}
+
+TEST_CASE("PreviewRenderer reports bad input without starting", "[PreviewRenderer]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    PreviewRenderer preview;
+    REQUIRE_FALSE(preview.start(getOutputDir().getChildFile("missing.wav"), BatchRenderQueue::Config()));
+    REQUIRE(preview.getLastError().isNotEmpty());
+    REQUIRE_FALSE(preview.isRendering());
+    REQUIRE_FALSE(preview.isReady());
+
+    juce::AudioBuffer<float> block(2, 64);
+    BufferFiller::fillWithAllOnes(block);
+    preview.play();
+    REQUIRE_FALSE(preview.readNextBlock(block));
+    REQUIRE(TestUtils::isSilent(block, 0.0f));
+}
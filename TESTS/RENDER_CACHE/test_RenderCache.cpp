@@ -0,0 +1,265 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Processor/RenderCache.h"
+#include "Processor/PluginProcessor.h"
+#include "Processor/FileToBufferManager.h"
+#include "Util/FileUtils.h"
+#include "Util/RenderControl.h"
+#include "BufferFiller.h"
+
+namespace
+{
+    juce::File getOutputDir() { return TestUtils::getModuleOutputDir("RENDER_CACHE"); }
+
+    juce::File writeBytes(const juce::File& file, int numBytes, char fill)
+    {
+        juce::MemoryBlock block(static_cast<size_t>(numBytes));
+        block.fillWith(static_cast<juce::uint8>(fill));
+        REQUIRE(file.replaceWithData(block.getData(), block.getSize()));
+        return file;
+    }
+
+    bool sameBytes(const juce::File& a, const juce::File& b)
+    {
+        juce::MemoryBlock x, y;
+        return a.loadFileAsData(x) && b.loadFileAsData(y) && x == y;
+    }
+
+    // Entry recency is millisecond-resolution; keep operations strictly ordered.
+    void tick() { juce::Thread::sleep(5); }
+}
+
+TEST_CASE("RenderCache keys cover input and settings", "[RenderCache]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    const auto dir = getOutputDir().getChildFile("keys");
+    dir.createDirectory();
+
+    const auto a = writeBytes(dir.getChildFile("a.bin"), 1000, 'a');
+    const auto b = writeBytes(dir.getChildFile("b.bin"), 1000, 'b');
+
+    REQUIRE(RenderCache::hashFile(a) == RenderCache::hashFile(a));
+    REQUIRE(RenderCache::hashFile(a) != RenderCache::hashFile(b));
+    REQUIRE(RenderCache::hashFile(dir.getChildFile("missing.bin")).isEmpty());
+
+    // Multi-chunk inputs hash the same with or without a control token.
+    const auto large = writeBytes(dir.getChildFile("large.bin"), 3 * 1024 * 1024 + 17, 'l');
+    RenderControl control;
+    REQUIRE(RenderCache::hashFile(large, &control) == RenderCache::hashFile(large));
+
+    control.cancel();
+    REQUIRE(RenderCache::hashFile(large, &control).isEmpty());
+
+    RenderCache::RenderSettings base;
+    base.processorName = "Gain";
+    base.parameterXml  = "<Params gain=\"0.5\"/>";
+
+    const auto hash = RenderCache::hashFile(a);
+    const auto key  = RenderCache::makeKey(hash, base);
+    REQUIRE(key == RenderCache::makeKey(hash, base));
+    REQUIRE(key.length() == 64);
+
+    auto changed = [&] (auto mutate)
+    {
+        auto settings = base;
+        mutate(settings);
+        return RenderCache::makeKey(hash, settings) != key;
+    };
+
+    REQUIRE(RenderCache::makeKey(RenderCache::hashFile(b), base) != key);
+    REQUIRE(changed([] (auto& s) { s.processorName = "GrainShifter"; }));
+    REQUIRE(changed([] (auto& s) { s.parameterXml  = "<Params gain=\"0.6\"/>"; }));
+    REQUIRE(changed([] (auto& s) { s.blockSize     = 256; }));
+    REQUIRE(changed([] (auto& s) { s.autoTuneBlockSize = true; }));
+    REQUIRE(changed([] (auto& s) { s.bitDepth      = 16; }));
+    REQUIRE(changed([] (auto& s) { s.dither        = true; }));
+}
+
+TEST_CASE("RenderCache stores, fetches and evicts least recently used", "[RenderCache][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    const auto root     = getOutputDir().getChildFile("lru");
+    const auto cacheDir = root.getChildFile("cache");
+    root.deleteRecursively();
+    root.createDirectory();
+
+    RenderCache cache(cacheDir);
+    REQUIRE_FALSE(cacheDir.exists()); // nothing touched until first store
+
+    const auto one   = writeBytes(root.getChildFile("one.wav"),   1000, '1');
+    const auto two   = writeBytes(root.getChildFile("two.wav"),   1000, '2');
+    const auto three = writeBytes(root.getChildFile("three.wav"), 1000, '3');
+
+    SECTION("Round trip, hits and misses")
+    {
+        const auto out = root.getChildFile("fetched.wav");
+        REQUIRE_FALSE(cache.fetch("k1", out));
+        REQUIRE_FALSE(out.exists());
+
+        REQUIRE(cache.store("k1", one));
+        REQUIRE(cache.contains("k1"));
+        REQUIRE(cache.fetch("k1", out));
+        REQUIRE(sameBytes(out, one));
+
+        REQUIRE(cache.getNumHits()   == 1);
+        REQUIRE(cache.getNumMisses() == 1);
+        REQUIRE(cache.getTotalBytes() == 1000);
+    }
+
+    SECTION("Entry limit evicts the least recently used")
+    {
+        cache.setLimits({ 1 << 20, 2 });
+
+        REQUIRE(cache.store("k1", one));   tick();
+        REQUIRE(cache.store("k2", two));   tick();
+        REQUIRE(cache.fetch("k1", root.getChildFile("bump.wav"))); tick();
+        REQUIRE(cache.store("k3", three));
+
+        REQUIRE(cache.getNumEntries() == 2);
+        REQUIRE(cache.contains("k1"));
+        REQUIRE_FALSE(cache.contains("k2"));
+        REQUIRE(cache.contains("k3"));
+        REQUIRE_FALSE(cacheDir.getChildFile("k2.wav").exists());
+    }
+
+    SECTION("Byte limit evicts, and oversize renders are refused")
+    {
+        cache.setLimits({ 2500, 100 });
+
+        REQUIRE(cache.store("k1", one));   tick();
+        REQUIRE(cache.store("k2", two));   tick();
+        REQUIRE(cache.store("k3", three));
+
+        REQUIRE(cache.getTotalBytes() <= 2500);
+        REQUIRE_FALSE(cache.contains("k1"));
+
+        const auto big = writeBytes(root.getChildFile("big.wav"), 4000, 'x');
+        REQUIRE_FALSE(cache.store("big", big));
+        REQUIRE_FALSE(cache.contains("big"));
+
+        // Tightening the limits applies immediately.
+        cache.setLimits({ 2500, 1 });
+        REQUIRE(cache.getNumEntries() == 1);
+        REQUIRE(cache.contains("k3"));
+    }
+
+    SECTION("Entries and their recency persist across instances")
+    {
+        REQUIRE(cache.store("k1", one)); tick();
+        REQUIRE(cache.store("k2", two));
+
+        RenderCache reopened(cacheDir);
+        REQUIRE(reopened.getNumEntries() == 2);
+        REQUIRE(reopened.fetch("k2", root.getChildFile("again.wav")));
+
+        reopened.clear();
+        REQUIRE(reopened.getNumEntries() == 0);
+        REQUIRE(cacheDir.findChildFiles(juce::File::findFiles, false).isEmpty());
+    }
+
+    SECTION("The cache owns its bytes and never touches the user's files")
+    {
+        const auto before = one.getLastModificationTime();
+        REQUIRE(cache.store("k1", one)); tick();
+
+        const auto out = root.getChildFile("delivered.wav");
+        REQUIRE(cache.fetch("k1", out)); tick();
+        REQUIRE(one.getLastModificationTime() == before);
+
+        // Overwrite the rendered file in place, keeping its inode.
+        {
+            juce::FileOutputStream stream(one);
+            REQUIRE(stream.openedOk());
+            REQUIRE(stream.setPosition(0));
+            const juce::MemoryBlock edit(100, true);
+            REQUIRE(stream.write(edit.getData(), edit.getSize()));
+        }
+
+        // Same for the fetched output: an in-place edit must not reach the entry.
+        {
+            juce::FileOutputStream stream(out);
+            REQUIRE(stream.openedOk());
+            REQUIRE(stream.setPosition(0));
+            const juce::MemoryBlock edit(100, true);
+            REQUIRE(stream.write(edit.getData(), edit.getSize()));
+        }
+
+        const auto again = root.getChildFile("again.wav");
+        REQUIRE(cache.fetch("k1", again));
+        REQUIRE(again.getSize() == 1000);
+
+        juce::MemoryBlock data;
+        REQUIRE(again.loadFileAsData(data));
+        REQUIRE(static_cast<const char*>(data.getData())[0] == '1');
+    }
+
+    SECTION("Cached entry survives deletion of the original render")
+    {
+        REQUIRE(cache.store("k1", one));
+        REQUIRE(one.deleteFile());
+
+        const auto out = root.getChildFile("restored.wav");
+        REQUIRE(cache.fetch("k1", out));
+        REQUIRE(out.getSize() == 1000);
+    }
+}
+
+TEST_CASE("FileToBufferManager serves repeated jobs from the render cache", "[RenderCache][FileToBufferManager][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    const auto root = getOutputDir().getChildFile("fbm");
+    root.deleteRecursively();
+    root.createDirectory();
+
+    const double sampleRate = 44100.0;
+    juce::AudioBuffer<float> source(1, 44100);
+    BufferFiller::generateSineCycles(source, 220);
+    const auto input = root.getChildFile("input.wav");
+    REQUIRE(FileUtils::writeBufferToWav(source, input, sampleRate, source.getNumSamples()));
+
+    AudioFileTransformerProcessor processor;
+    processor.setIsLogging(false);
+    processor.setActiveProcessor(ActiveProcessor::kGain);
+    processor.getGainNode()->setGain(0.5f);
+
+    processor.getRenderCache().setDirectory(root.getChildFile("cache"));
+    processor.setRenderCacheEnabled(true);
+    REQUIRE(processor.isRenderCacheEnabled());
+
+    auto& fbm = processor.getFileToBufferManager();
+    fbm.setInputFile(input);
+
+    auto runInto = [&] (const juce::String& dirName)
+    {
+        fbm.setOutputDirectory(root.getChildFile(dirName));
+        REQUIRE(fbm.startProcessing(processor.getOfflineRenderer()));
+        TestUtils::waitForCompletion(fbm);
+        INFO(fbm.getError());
+        REQUIRE(fbm.wasSuccessful());
+
+        auto outputs = root.getChildFile(dirName).findChildFiles(juce::File::findFiles, false, "*.wav");
+        REQUIRE(outputs.size() == 1);
+        return outputs[0];
+    };
+
+    const auto first = runInto("run1");
+    REQUIRE_FALSE(fbm.wasCacheHit());
+    REQUIRE(processor.getRenderCache().getNumEntries() == 1);
+
+    const auto second = runInto("run2");
+    REQUIRE(fbm.wasCacheHit());
+    REQUIRE(sameBytes(first, second));
+
+    // Different parameters: a fresh render and a second entry.
+    processor.getGainNode()->getAPVTS().getParameter("gain")->setValueNotifyingHost(0.25f);
+    runInto("run3");
+    REQUIRE_FALSE(fbm.wasCacheHit());
+    REQUIRE(processor.getRenderCache().getNumEntries() == 2);
+
+    processor.setRenderCacheEnabled(false);
+    runInto("run4");
+    REQUIRE_FALSE(fbm.wasCacheHit());
+}
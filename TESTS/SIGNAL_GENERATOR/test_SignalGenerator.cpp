@@ -0,0 +1,314 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "TEST_UTILS/SignalGenerator.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Util/FileUtils.h"
+#include <catch2/catch_approx.hpp>
+#include <vector>
+
+namespace
+{
+    juce::File getOutputDir() { return TestUtils::getModuleOutputDir("SIGNAL_GENERATOR"); }
+
+    /** Renders the whole spec in blocks of blockSize into one buffer. */
+    juce::AudioBuffer<float> renderInBlocks(const TestUtils::SignalSpec& spec, int blockSize)
+    {
+        TestUtils::SignalGenerator generator(spec);
+        juce::AudioBuffer<float> result(spec.numChannels, static_cast<int>(generator.getLengthInSamples()));
+        juce::AudioBuffer<float> block(spec.numChannels, blockSize);
+
+        int position = 0;
+        while (const int rendered = generator.renderNextBlock(block, blockSize))
+        {
+            for (int ch = 0; ch < spec.numChannels; ++ch)
+                result.copyFrom(ch, position, block, ch, 0, rendered);
+            position += rendered;
+        }
+
+        REQUIRE(position == result.getNumSamples());
+        return result;
+    }
+
+    bool buffersEqual(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        if (a.getNumChannels() != b.getNumChannels() || a.getNumSamples() != b.getNumSamples())
+            return false;
+
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                if (a.getSample(ch, i) != b.getSample(ch, i))
+                    return false;
+
+        return true;
+    }
+
+    /**
+     * Pitch from autocorrelation over numSamples from start, searching 60-500 Hz.
+     * Takes the shortest lag within 10% of the best, so a strictly periodic
+     * signal doesn't resolve to twice its period.
+     */
+    double estimatePitch(const juce::AudioBuffer<float>& buffer, int start, int numSamples, double sampleRate)
+    {
+        const float* data = buffer.getReadPointer(0, start);
+        const int minLag = static_cast<int>(sampleRate / 500.0);
+        const int maxLag = static_cast<int>(sampleRate / 60.0);
+
+        std::vector<double> correlation(static_cast<size_t>(maxLag + 2), 0.0);
+        double best = 0.0;
+        for (int lag = minLag; lag <= maxLag + 1; ++lag)
+        {
+            double sum = 0.0;
+            for (int i = 0; i + lag < numSamples; ++i)
+                sum += data[i] * data[i + lag];
+
+            correlation[static_cast<size_t>(lag)] = sum / (numSamples - lag);
+            best = juce::jmax(best, correlation[static_cast<size_t>(lag)]);
+        }
+
+        int lag = minLag;
+        while (lag < maxLag && correlation[static_cast<size_t>(lag)] < 0.9 * best)
+            ++lag;
+        while (lag < maxLag && correlation[static_cast<size_t>(lag + 1)] > correlation[static_cast<size_t>(lag)])
+            ++lag;
+
+        return sampleRate / lag;
+    }
+
+    /** Frequency from rising zero crossings over numSamples from start. */
+    double estimateZeroCrossingHz(const juce::AudioBuffer<float>& buffer, int start, int numSamples, double sampleRate)
+    {
+        const float* data = buffer.getReadPointer(0, start);
+        int crossings = 0;
+        for (int i = 1; i < numSamples; ++i)
+            if (data[i - 1] < 0.0f && data[i] >= 0.0f)
+                ++crossings;
+
+        return crossings * sampleRate / numSamples;
+    }
+}
+
+TEST_CASE("SignalGenerator output is deterministic and independent of block size", "[SignalGenerator]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    using TestUtils::SignalType;
+
+    const std::pair<SignalType, const char*> types[] = {
+        { SignalType::kGlottalPulses, "glottal" },
+        { SignalType::kSineSweep,     "sweep" },
+        { SignalType::kWhiteNoise,    "white" },
+        { SignalType::kPinkNoise,     "pink" },
+        { SignalType::kSpeechMix,     "speech mix" },
+    };
+
+    for (const auto& entry : types)
+    {
+        INFO(entry.second);
+
+        TestUtils::SignalSpec spec;
+        spec.type        = entry.first;
+        spec.numChannels = 2;
+        spec.seconds     = 2.0;
+        spec.seed        = 42;
+
+        const auto whole = TestUtils::createSignalBuffer(spec);
+        REQUIRE(whole.getNumSamples() == 88200);
+        REQUIRE_FALSE(TestUtils::isSilent(whole));
+        REQUIRE(whole.getMagnitude(0, whole.getNumSamples()) <= spec.gain);
+
+        // Odd block size so blocks straddle every internal boundary
+        REQUIRE(buffersEqual(whole, renderInBlocks(spec, 333)));
+        REQUIRE(buffersEqual(whole, TestUtils::createSignalBuffer(spec)));
+
+        // reset() replays from the first sample
+        TestUtils::SignalGenerator generator(spec);
+        juce::AudioBuffer<float> first(2, 1000), again(2, 1000);
+        generator.renderNextBlock(first, 1000);
+        generator.reset();
+        REQUIRE(generator.getPosition() == 0);
+        generator.renderNextBlock(again, 1000);
+        REQUIRE(buffersEqual(first, again));
+    }
+}
+
+TEST_CASE("SignalGenerator seeds and channels", "[SignalGenerator]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    TestUtils::SignalSpec spec;
+    spec.type        = TestUtils::SignalType::kWhiteNoise;
+    spec.numChannels = 2;
+    spec.seed        = 1;
+
+    const auto seedOne = TestUtils::createSignalBuffer(spec);
+    spec.seed = 2;
+    const auto seedTwo = TestUtils::createSignalBuffer(spec);
+    REQUIRE_FALSE(buffersEqual(seedOne, seedTwo));
+
+    // Noise is independent per channel rather than a scaled copy
+    const float ratio = seedOne.getSample(1, 0) / seedOne.getSample(0, 0);
+    bool allSameRatio = true;
+    for (int i = 1; i < 100 && allSameRatio; ++i)
+        allSameRatio = std::abs(seedOne.getSample(1, i) - ratio * seedOne.getSample(0, i)) < 1.0e-6f;
+    REQUIRE_FALSE(allSameRatio);
+
+    SECTION("Multichannel high-rate glottal: exact length, each channel 0.9x the previous")
+    {
+        spec.type        = TestUtils::SignalType::kGlottalPulses;
+        spec.numChannels = 8;
+        spec.sampleRate  = 192000.0;
+        spec.seconds     = 1.0;
+
+        const auto buffer = TestUtils::createSignalBuffer(spec);
+        REQUIRE(buffer.getNumChannels() == 8);
+        REQUIRE(buffer.getNumSamples() == 192000);
+
+        for (int ch = 1; ch < 8; ++ch)
+            REQUIRE(TestUtils::calculateRMS(buffer, ch) == Catch::Approx(0.9f * TestUtils::calculateRMS(buffer, ch - 1)).epsilon(1.0e-3));
+    }
+
+    SECTION("Two hours at 192 kHz is addressable without rendering it")
+    {
+        spec.sampleRate = 192000.0;
+        spec.seconds    = 2.0 * 60.0 * 60.0;
+
+        TestUtils::SignalGenerator generator(spec);
+        REQUIRE(generator.getLengthInSamples() == 1382400000LL);
+
+        juce::AudioBuffer<float> block(2, 4096);
+        REQUIRE(generator.renderNextBlock(block, 4096) == 4096);
+        REQUIRE(generator.getPosition() == 4096);
+    }
+}
+
+TEST_CASE("SignalGenerator glottal pulses sit at f0 and sweeps cover their range", "[SignalGenerator]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    for (double sampleRate : { 44100.0, 96000.0 })
+    {
+        for (float f0 : { 110.0f, 220.0f })
+        {
+            INFO(sampleRate << " Hz, f0 " << f0);
+
+            TestUtils::SignalSpec spec;
+            spec.sampleRate   = sampleRate;
+            spec.f0Hz         = f0;
+            spec.vibratoCents = 0.0f;
+            spec.seconds      = 0.5;
+
+            const auto buffer = TestUtils::createSignalBuffer(spec);
+            const int window  = static_cast<int>(0.1 * sampleRate);
+            REQUIRE(estimatePitch(buffer, window, window, sampleRate) == Catch::Approx(f0).epsilon(0.02));
+        }
+    }
+
+    SECTION("Vibrato moves the pitch by about the requested depth")
+    {
+        TestUtils::SignalSpec spec;
+        spec.vibratoHz    = 1.0f;       // slow, so a short window sees a near-steady pitch
+        spec.vibratoCents = 100.0f;
+        spec.seconds      = 1.0;
+
+        const auto buffer = TestUtils::createSignalBuffer(spec);
+        const int window  = 2048;
+
+        // Vibrato peaks a quarter cycle in: one semitone up.
+        const double atPeak = estimatePitch(buffer, static_cast<int>(0.25 * spec.sampleRate) - window / 2, window, spec.sampleRate);
+        REQUIRE(atPeak == Catch::Approx(spec.f0Hz * std::pow(2.0, 1.0 / 12.0)).epsilon(0.03));
+    }
+
+    SECTION("Exponential sweep")
+    {
+        TestUtils::SignalSpec spec;
+        spec.type         = TestUtils::SignalType::kSineSweep;
+        spec.sampleRate   = 48000.0;
+        spec.seconds      = 2.0;
+        spec.sweepStartHz = 200.0f;
+        spec.sweepEndHz   = 2000.0f;
+
+        const auto buffer = TestUtils::createSignalBuffer(spec);
+        const int window  = 4800;
+
+        // Halfway through an exponential sweep is the geometric mean.
+        REQUIRE(estimateZeroCrossingHz(buffer, 0, window, spec.sampleRate) == Catch::Approx(212.0).epsilon(0.08));
+        REQUIRE(estimateZeroCrossingHz(buffer, 48000 - window / 2, window, spec.sampleRate) == Catch::Approx(632.5).epsilon(0.05));
+        REQUIRE(estimateZeroCrossingHz(buffer, 96000 - window, window, spec.sampleRate) == Catch::Approx(1890.0).epsilon(0.08));
+    }
+}
+
+TEST_CASE("SignalGenerator speech mix alternates phrases and silences", "[SignalGenerator]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    TestUtils::SignalSpec spec;
+    spec.type    = TestUtils::SignalType::kSpeechMix;
+    spec.seconds = 20.0;
+    spec.seed    = 7;
+
+    const auto buffer = TestUtils::createSignalBuffer(spec);
+    const float* data = buffer.getReadPointer(0);
+
+    const int minGap = static_cast<int>(0.05 * spec.sampleRate);
+    int gaps = 0;
+    int run = 0;
+    int voicedSamples = 0;
+
+    for (int i = 0; i < buffer.getNumSamples(); ++i)
+    {
+        if (data[i] == 0.0f)
+        {
+            if (++run == minGap)
+                ++gaps;
+        }
+        else
+        {
+            run = 0;
+            ++voicedSamples;
+        }
+    }
+
+    // Phrases average 0.7 s and gaps 0.325 s, so 20 s holds roughly 20 of each.
+    REQUIRE(gaps >= 8);
+    REQUIRE(voicedSamples > buffer.getNumSamples() * 2 / 5);
+    REQUIRE(voicedSamples < buffer.getNumSamples() * 9 / 10);
+}
+
+TEST_CASE("writeSignalToWav streams the same samples to disk", "[SignalGenerator][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    TestUtils::SignalSpec spec;
+    spec.type        = TestUtils::SignalType::kSpeechMix;
+    spec.sampleRate  = 96000.0;
+    spec.numChannels = 6;
+    spec.seconds     = 10.0;
+
+    const auto file = getOutputDir().getChildFile("speech_mix_96k_6ch.wav");
+
+    const auto start = juce::Time::getMillisecondCounterHiRes();
+    REQUIRE(TestUtils::writeSignalToWav(spec, file, 24));
+    WARN("Streamed " << spec.seconds << " s of " << spec.numChannels << " ch at " << spec.sampleRate
+         << " Hz in " << (juce::Time::getMillisecondCounterHiRes() - start) << " ms");
+
+    auto reader = FileUtils::createReaderFor(file, FileUtils::ReadStrategy::kStreamed);
+    REQUIRE(reader != nullptr);
+    REQUIRE(reader->sampleRate == spec.sampleRate);
+    REQUIRE(reader->numChannels == 6u);
+    REQUIRE(reader->bitsPerSample == 24u);
+    REQUIRE(reader->lengthInSamples == spec.getLengthInSamples());
+
+    // Compare a stretch past the first write chunk against the in-memory render
+    const auto expected = TestUtils::createSignalBuffer(spec);
+    constexpr int offset = 100000;
+    constexpr int length = 8192;
+
+    juce::AudioBuffer<float> readBack(6, length);
+    REQUIRE(reader->read(&readBack, 0, length, offset, true, true));
+
+    for (int ch = 0; ch < 6; ++ch)
+        for (int i = 0; i < length; ++i)
+            REQUIRE(readBack.getSample(ch, i) == Catch::Approx(expected.getSample(ch, offset + i)).margin(1.0e-6));
+
+    reader.reset();
+    file.deleteFile();
+}
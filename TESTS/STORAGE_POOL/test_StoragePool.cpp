@@ -0,0 +1,107 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Processor/StoragePool.h"
+#include "Processor/PluginProcessor.h"
+#include "Util/FileUtils.h"
+#include "BufferFiller.h"
+
+TEST_CASE("StoragePool leases keep capacity across jobs", "[StoragePool]")
+{
+    StoragePool pool;
+    REQUIRE(pool.getNumBuffers() == 0);
+    REQUIRE(pool.getAllocatedBytes() == 0);
+
+    SECTION("Lease is sized exactly and returned on destruction")
+    {
+        {
+            auto lease = pool.acquire(2, 48000);
+            REQUIRE(lease.isValid());
+            REQUIRE(lease.getBuffer().getNumChannels() == 2);
+            REQUIRE(lease.getBuffer().getNumSamples()  == 48000);
+            REQUIRE(pool.getNumLeased() == 1);
+        }
+        REQUIRE(pool.getNumLeased() == 0);
+        REQUIRE(pool.getAllocatedBytes() == StoragePool::bytesFor(2, 48000));
+    }
+
+    SECTION("Smaller follow-up job reuses the idle buffer without growing the pool")
+    {
+        auto first = pool.acquire(2, 96000);
+        first.release();
+
+        auto second = pool.acquire(1, 1000);
+        REQUIRE(pool.getNumBuffers() == 1);
+        REQUIRE(second.getBuffer().getNumSamples() == 1000);
+        REQUIRE(pool.getAllocatedBytes() == StoragePool::bytesFor(2, 96000));
+    }
+
+    SECTION("Concurrent leases get distinct buffers")
+    {
+        auto a = pool.acquire(2, 1024);
+        auto b = pool.acquire(2, 1024);
+        REQUIRE(&a.getBuffer() != &b.getBuffer());
+        REQUIRE(pool.getNumBuffers() == 2);
+    }
+
+    SECTION("Moved lease transfers ownership")
+    {
+        auto a = pool.acquire(1, 16);
+        StoragePool::Lease b = std::move(a);
+        REQUIRE_FALSE(a.isValid());
+        REQUIRE(b.isValid());
+        REQUIRE(pool.getNumLeased() == 1);
+    }
+
+    SECTION("releaseIdleStorage frees idle capacity only")
+    {
+        auto held = pool.acquire(2, 100);
+        pool.acquire(2, 5000).release();
+        pool.releaseIdleStorage();
+        REQUIRE(pool.getAllocatedBytes() == StoragePool::bytesFor(2, 100));
+    }
+}
+
+TEST_CASE("AudioFileTransformerProcessor storage tracks the input file", "[StoragePool][processor][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    AudioFileTransformerProcessor processor;
+    processor.setIsLogging(false);
+
+    SECTION("No storage is allocated at instantiation")
+    {
+        REQUIRE(processor.getStoragePool().getAllocatedBytes() == 0);
+        REQUIRE(processor.getInputBuffer().getNumSamples() == 0);
+        REQUIRE(processor.getProcessedBuffer().getNumSamples() == 0);
+    }
+
+    SECTION("Files longer than the old 60 s cap render in full")
+    {
+        auto outDir = juce::File::getCurrentWorkingDirectory().getChildFile("TESTS/STORAGE_POOL/OUTPUT");
+        outDir.createDirectory();
+
+        constexpr double sampleRate = 8000.0;
+        constexpr int    numSamples = static_cast<int>(sampleRate * 75.0);
+        juce::AudioBuffer<float> source(1, numSamples);
+        BufferFiller::generateSineCycles(source, 80);
+
+        auto inputFile  = outDir.getChildFile("long_input.wav");
+        auto outputFile = outDir.getChildFile("long_output.wav");
+        REQUIRE(FileUtils::writeBufferToWav(source, inputFile, sampleRate, numSamples));
+
+        processor.setActiveProcessor(ActiveProcessor::kGain);
+        REQUIRE(processor.transformFile(inputFile, outputFile));
+
+        double      sr  = 0.0;
+        int         chs = 0;
+        juce::int64 len = 0;
+        REQUIRE(FileUtils::readAudioFileInfo(outputFile, sr, chs, len));
+        REQUIRE(len >= numSamples);
+
+        // Mono input -> stereo storage, sized to the file rather than 60 s @ 192 kHz.
+        REQUIRE(processor.getInputBuffer().getNumChannels() == OfflineRenderer::kMinStorageChannels);
+        REQUIRE(processor.getInputBuffer().getNumSamples()  == numSamples);
+        REQUIRE(processor.getStoragePool().getAllocatedBytes()
+                <= 2 * StoragePool::bytesFor(OfflineRenderer::kMinStorageChannels, static_cast<int>(len)));
+    }
+}
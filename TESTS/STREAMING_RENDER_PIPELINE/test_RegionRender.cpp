@@ -0,0 +1,149 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include <catch2/catch_approx.hpp>
+#include "Processor/OfflineRenderer.h"
+#include "Processor/BufferProcessingManager.h"
+#include "Processor/RenderRange.h"
+#include "Util/FileUtils.h"
+
+namespace
+{
+    juce::File getOutputDir() { return TestUtils::getModuleOutputDir("STREAMING_RENDER_PIPELINE"); }
+}
+
+TEST_CASE("RenderRange resolves units and clamps to the file", "[RenderRange]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    SECTION("Whole file by default")
+    {
+        const auto region = RenderRange().resolve(48000.0, 1000);
+        REQUIRE(region.start == 0);
+        REQUIRE(region.end == 1000);
+        REQUIRE(region.preRoll == 0);
+        REQUIRE(RenderRange().isWholeFile());
+    }
+
+    SECTION("Seconds convert at the file's sample rate")
+    {
+        const auto region = RenderRange::inSeconds(0.5, 1.0, 0.25).resolve(48000.0, 96000);
+        REQUIRE(region.start == 24000);
+        REQUIRE(region.end == 48000);
+        REQUIRE(region.preRoll == 12000);
+        REQUIRE(region.getReadStart() == 12000);
+        REQUIRE(region.getReadLength() == 36000);
+    }
+
+    SECTION("Pre-roll stops at the start of the file, end at its length")
+    {
+        const auto region = RenderRange::inSamples(100, 5000, 400).resolve(44100.0, 2000);
+        REQUIRE(region.start == 100);
+        REQUIRE(region.end == 2000);
+        REQUIRE(region.preRoll == 100);
+        REQUIRE(region.getReadStart() == 0);
+    }
+}
+
+TEST_CASE("FileUtils::loadWavIntoBuffer seeks to startSample", "[RenderRange][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    const auto input = TestUtils::writeSineWav(getOutputDir().getChildFile("region_seek_source.wav"), 2, 44100.0, 1.0);
+    const auto whole = TestUtils::readWav(input);
+
+    for (auto strategy : { FileUtils::ReadStrategy::kMemoryMapped, FileUtils::ReadStrategy::kStreamed })
+    {
+        juce::AudioBuffer<float> region(2, 1000);
+        double sr  = 0.0;
+        int    chs = 0;
+        int    read = 0;
+        REQUIRE(FileUtils::loadWavIntoBuffer(input, region, region.getNumSamples(), sr, chs, read,
+                                             nullptr, nullptr, strategy, 12345));
+        REQUIRE(read == 1000);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < read; ++i)
+                REQUIRE(region.getSample(ch, i) == whole.getSample(ch, 12345 + i));
+
+        // Reads stop at the end of the file.
+        REQUIRE(FileUtils::loadWavIntoBuffer(input, region, region.getNumSamples(), sr, chs, read,
+                                             nullptr, nullptr, strategy, whole.getNumSamples() - 10));
+        REQUIRE(read == 10);
+    }
+}
+
+TEST_CASE("Region render matches the same slice of a full render", "[RenderRange][OfflineRenderer][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    BufferProcessingManager bpm;
+    bpm.setActiveProcessor(ActiveProcessor::kGain);
+    bpm.setBlockSize(512);
+
+    StoragePool     pool;
+    OfflineRenderer renderer(bpm, pool);
+
+    const auto input   = TestUtils::writeSineWav(getOutputDir().getChildFile("region_source.wav"), 2, 44100.0, 3.0);
+    const auto fullOut = getOutputDir().getChildFile("region_full.wav");
+    REQUIRE(renderer.render(input, fullOut));
+    const auto full = TestUtils::readWav(fullOut);
+
+    // Whatever the processor adds past the input (latency + tail).
+    const int extra = full.getNumSamples() - 3 * 44100;
+
+    // Not block aligned, so the seek, the pre-roll split and the last block are all partial.
+    constexpr juce::int64 start   = 30001;
+    constexpr juce::int64 end     = 95003;
+    constexpr juce::int64 preRoll = 777;
+    const auto range = RenderRange::inSamples(start, end, preRoll);
+
+    for (auto mode : { OfflineRenderer::RenderMode::kBuffered, OfflineRenderer::RenderMode::kStreaming })
+    {
+        const bool streaming = mode == OfflineRenderer::RenderMode::kStreaming;
+        INFO((streaming ? "streaming" : "buffered"));
+
+        renderer.setRenderMode(mode);
+        const auto regionOut = getOutputDir().getChildFile(streaming ? "region_streaming.wav" : "region_buffered.wav");
+        REQUIRE(renderer.render(input, regionOut, nullptr, nullptr, range));
+
+        const auto region    = TestUtils::readWav(regionOut);
+        const int  regionLen = static_cast<int>(end - start);
+
+        // Only the region (+ latency and tail) is written; the pre-roll is not.
+        REQUIRE(region.getNumSamples() == regionLen + extra);
+        REQUIRE(region.getNumChannels() == full.getNumChannels());
+
+        for (int ch = 0; ch < full.getNumChannels(); ++ch)
+            for (int i = 0; i < regionLen; ++i)
+                REQUIRE(region.getSample(ch, i) == Catch::Approx(full.getSample(ch, static_cast<int>(start) + i)).margin(1.0e-6));
+
+        if (! streaming)
+            REQUIRE(renderer.getNumPreRollSamples() == static_cast<int>(preRoll));
+    }
+}
+
+TEST_CASE("Region render accepts seconds and rejects empty ranges", "[RenderRange][OfflineRenderer][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    BufferProcessingManager bpm;
+    bpm.setActiveProcessor(ActiveProcessor::kGain);
+
+    StoragePool     pool;
+    OfflineRenderer renderer(bpm, pool);
+
+    const auto input  = TestUtils::writeSineWav(getOutputDir().getChildFile("region_seconds_source.wav"), 1, 48000.0, 2.0);
+    const auto output = getOutputDir().getChildFile("region_seconds.wav");
+
+    REQUIRE(renderer.render(input, output, nullptr, nullptr, RenderRange::inSeconds(0.5, 1.0, 0.1)));
+
+    double      sr  = 0.0;
+    int         chs = 0;
+    juce::int64 len = 0;
+    REQUIRE(FileUtils::readAudioFileInfo(output, sr, chs, len));
+    REQUIRE(len >= 24000);
+    REQUIRE(len < 48000);
+
+    REQUIRE_FALSE(renderer.render(input, output, nullptr, nullptr, RenderRange::inSeconds(3.0, 4.0)));
+    REQUIRE(renderer.getLastError() == "Render range is empty");
+}
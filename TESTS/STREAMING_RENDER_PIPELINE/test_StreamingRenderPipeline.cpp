@@ -0,0 +1,240 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Processor/StreamingRenderPipeline.h"
+#include "Processor/OfflineRenderer.h"
+#include "Processor/BufferProcessingManager.h"
+#include "Util/RenderControl.h"
+#include "Util/FileUtils.h"
+
+namespace
+{
+    juce::File getOutputDir() { return TestUtils::getModuleOutputDir("STREAMING_RENDER_PIPELINE"); }
+}
+
+TEST_CASE("StreamingRenderPipeline matches the buffered render", "[StreamingRenderPipeline][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    BufferProcessingManager bpm;
+    bpm.setActiveProcessor(ActiveProcessor::kGain);
+    bpm.setBlockSize(512);
+
+    StoragePool     pool;
+    OfflineRenderer renderer(bpm, pool);
+
+    const auto input = TestUtils::writeSineWav(getOutputDir().getChildFile("stream_source_mono.wav"), 1, 44100.0, 3.0);
+    const auto bufferedOut  = getOutputDir().getChildFile("stream_buffered.wav");
+    const auto streamingOut = getOutputDir().getChildFile("stream_streaming.wav");
+
+    renderer.setRenderMode(OfflineRenderer::RenderMode::kBuffered);
+    REQUIRE(renderer.render(input, bufferedOut));
+
+    renderer.setRenderMode(OfflineRenderer::RenderMode::kStreaming);
+    float lastProgress = 0.0f;
+    REQUIRE(renderer.render(input, streamingOut, [&] (float p) { lastProgress = p; }));
+    REQUIRE(lastProgress == 1.0f);
+
+    // Streaming holds no render storage.
+    REQUIRE(renderer.getInputBuffer().getNumSamples() == 0);
+
+    const auto buffered  = TestUtils::readWav(bufferedOut);
+    const auto streaming = TestUtils::readWav(streamingOut);
+
+    REQUIRE(streaming.getNumChannels() == buffered.getNumChannels());
+    REQUIRE(streaming.getNumSamples()  == buffered.getNumSamples());
+
+    for (int ch = 0; ch < buffered.getNumChannels(); ++ch)
+        for (int i = 0; i < buffered.getNumSamples(); ++i)
+            REQUIRE(streaming.getSample(ch, i) == buffered.getSample(ch, i));
+}
+
+TEST_CASE("StreamingRenderPipeline storage does not grow with file length", "[StreamingRenderPipeline][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    BufferProcessingManager bpm;
+    bpm.setActiveProcessor(ActiveProcessor::kGain);
+    bpm.setBlockSize(1024);
+
+    StreamingRenderPipeline pipeline(bpm);
+
+    const auto shortIn = TestUtils::writeSineWav(getOutputDir().getChildFile("stream_short.wav"), 2, 44100.0, 1.0);
+    const auto longIn  = TestUtils::writeSineWav(getOutputDir().getChildFile("stream_long.wav"),  2, 44100.0, 20.0);
+
+    REQUIRE(pipeline.render(shortIn, getOutputDir().getChildFile("stream_short_out.wav")));
+    const auto shortBytes = pipeline.getStorageBytes();
+
+    REQUIRE(pipeline.render(longIn, getOutputDir().getChildFile("stream_long_out.wav")));
+    REQUIRE(pipeline.getStorageBytes() == shortBytes);
+    REQUIRE(shortBytes == static_cast<size_t>(StreamingRenderPipeline::kNumBlocks) * 2 * 1024 * sizeof(float));
+    REQUIRE(pipeline.getNumOutputSamples() >= static_cast<juce::int64>(44100.0 * 20.0));
+}
+
+TEST_CASE("Streaming renders stay within a tracked-memory bound per second of audio", "[StreamingRenderPipeline][memory][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    // Buffered storage alone is 2 x 2 ch x 44100 x 4 B = ~690 KiB per second;
+    // streaming holds a fixed ring and writer staging however long the file.
+    constexpr double      seconds           = 30.0;
+    constexpr juce::int64 maxBytesPerSecond = 256 * 1024;
+
+    BufferProcessingManager bpm;
+    bpm.setActiveProcessor(ActiveProcessor::kGain);
+    bpm.setBlockSize(1024);
+
+    StoragePool     pool;
+    OfflineRenderer renderer(bpm, pool);
+
+    const auto input = TestUtils::writeSineWav(getOutputDir().getChildFile("stream_memory.wav"), 2, 44100.0, seconds);
+
+    auto requireWithinBound = [&] (const RenderMetrics& metrics)
+    {
+        INFO("Peak memory: " << metrics.memory.toString());
+        REQUIRE(metrics.memory.isValid());
+        REQUIRE(metrics.memory.peakCategoryBytes[static_cast<int>(MemoryAccounting::Category::kStorage)] > 0);
+        REQUIRE(metrics.audioSeconds >= seconds - 1.0e-6);
+        REQUIRE(static_cast<double>(metrics.memory.getRenderBytes()) / metrics.audioSeconds
+                < static_cast<double>(maxBytesPerSecond));
+    };
+
+    SECTION("Full file")
+    {
+        renderer.setRenderMode(OfflineRenderer::RenderMode::kStreaming);
+        REQUIRE(renderer.render(input, getOutputDir().getChildFile("stream_memory_out.wav")));
+        requireWithinBound(renderer.getLastMetrics());
+    }
+
+    SECTION("Pipeline used directly")
+    {
+        StreamingRenderPipeline pipeline(bpm);
+        REQUIRE(pipeline.render(input, getOutputDir().getChildFile("stream_memory_pipeline_out.wav")));
+        requireWithinBound(pipeline.getLastMetrics());
+        REQUIRE(pipeline.getLastMetrics().memory.getRenderBytes() >= static_cast<juce::int64>(pipeline.getStorageBytes()));
+    }
+
+    SECTION("The buffered render of the same file is over the bound")
+    {
+        renderer.setRenderMode(OfflineRenderer::RenderMode::kBuffered);
+        REQUIRE(renderer.render(input, getOutputDir().getChildFile("stream_memory_buffered_out.wav")));
+
+        const auto& metrics = renderer.getLastMetrics();
+        REQUIRE(metrics.memory.getRenderBytes() >= static_cast<juce::int64>(metrics.peakStorageBytes));
+        REQUIRE(static_cast<double>(metrics.memory.getRenderBytes()) / metrics.audioSeconds
+                >= static_cast<double>(maxBytesPerSecond));
+    }
+}
+
+TEST_CASE("StreamingRenderPipeline cancellation removes partial output", "[StreamingRenderPipeline][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    BufferProcessingManager bpm;
+    bpm.setActiveProcessor(ActiveProcessor::kGain);
+
+    StreamingRenderPipeline pipeline(bpm);
+    const auto input  = TestUtils::writeSineWav(getOutputDir().getChildFile("stream_cancel_source.wav"), 2, 44100.0, 2.0);
+    const auto output = getOutputDir().getChildFile("stream_cancelled.wav");
+
+    RenderControl control;
+    control.cancel();
+
+    REQUIRE_FALSE(pipeline.render(input, output, nullptr, &control));
+    REQUIRE(pipeline.getLastError() == "Cancelled");
+    REQUIRE_FALSE(output.existsAsFile());
+
+    // The pipeline is reusable after an aborted job.
+    control.reset();
+    REQUIRE(pipeline.render(input, output, nullptr, &control));
+    REQUIRE(output.existsAsFile());
+}
+
+// Hidden: writes a ~4.3 GB input and ~13 GB RF64 output. Run with
+//   Tests "[large]"
+TEST_CASE("StreamingRenderPipeline renders more than 2^31 samples to RF64", "[.][large][StreamingRenderPipeline][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    constexpr double      sampleRate = 48000.0;
+    constexpr juce::int64 numSamples = (juce::int64(1) << 31) + 48000;
+    constexpr int         period     = 1000; // 2^31 % 1000 != 0, so a 32-bit wrap would shift the ramp
+
+    auto rampAt = [] (juce::int64 position)
+    {
+        return static_cast<float>(position % period) / static_cast<float>(period) - 0.5f;
+    };
+
+    const auto input  = getOutputDir().getChildFile("large_input.wav");
+    const auto output = getOutputDir().getChildFile("large_output.wav");
+
+    // Synthetic 16-bit mono source, streamed to disk a chunk at a time.
+    {
+        input.deleteFile();
+        std::unique_ptr<juce::FileOutputStream> stream(input.createOutputStream());
+        REQUIRE(stream != nullptr);
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, 1, 16, {}, 0));
+        REQUIRE(writer != nullptr);
+        stream.release();
+
+        juce::AudioBuffer<float> chunk(1, 1 << 16);
+        for (juce::int64 position = 0; position < numSamples; position += chunk.getNumSamples())
+        {
+            const int n = static_cast<int>(juce::jmin<juce::int64>(chunk.getNumSamples(), numSamples - position));
+            auto* data = chunk.getWritePointer(0);
+            for (int i = 0; i < n; ++i)
+                data[i] = rampAt(position + i);
+            REQUIRE(writer->writeFromAudioSampleBuffer(chunk, 0, n));
+        }
+    }
+
+    BufferProcessingManager bpm;
+    bpm.setActiveProcessor(ActiveProcessor::kGain);
+    bpm.setBlockSize(4096);
+
+    StoragePool     pool;
+    OfflineRenderer renderer(bpm, pool);
+
+    // Buffered mode is requested, but the input cannot fit an AudioBuffer.
+    renderer.setRenderMode(OfflineRenderer::RenderMode::kBuffered);
+    REQUIRE(renderer.exceedsBufferedLimit(input));
+    REQUIRE(renderer.render(input, output));
+
+    // > 4 GB of 24-bit stereo: JUCE's WAV writer promotes the header to RF64.
+    {
+        juce::FileInputStream header(output);
+        REQUIRE(header.openedOk());
+        char magic[5] = {};
+        header.read(magic, 4);
+        REQUIRE(juce::String(magic) == "RF64");
+    }
+
+    auto reader = FileUtils::createReaderFor(output);
+    REQUIRE(reader != nullptr);
+    REQUIRE(reader->lengthInSamples >= numSamples);
+
+    // Estimate the gain near the start, then check the same relationship past 2^31.
+    auto readWindow = [&] (juce::int64 start, int length)
+    {
+        juce::AudioBuffer<float> window(2, length);
+        REQUIRE(reader->read(&window, 0, length, start, true, true));
+        return window;
+    };
+
+    const int  windowLength = 4 * period;
+    const auto head         = readWindow(0, windowLength);
+    float gain = 0.0f;
+    for (int i = 0; i < windowLength; ++i)
+        if (std::abs(rampAt(i)) > 0.25f)
+            { gain = head.getSample(0, i) / rampAt(i); break; }
+
+    const juce::int64 tailStart = (juce::int64(1) << 31) + 1234;
+    const auto        tail      = readWindow(tailStart, windowLength);
+    for (int i = 0; i < windowLength; ++i)
+        REQUIRE(std::abs(tail.getSample(0, i) - gain * rampAt(tailStart + i)) < 1.0e-3f);
+
+    reader.reset();
+    input.deleteFile();
+    output.deleteFile();
+}
@@ -5,6 +5,7 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "TEST_UTILS/AudioThreadAudit.h"
 #include "TD_PSOLA/TD_PSOLA.h"
 #include "TD_PSOLA/GrainExport.h"
 #include "BufferFiller.h"
@@ -120,6 +121,41 @@ TEST_CASE("TD_PSOLA - Stereo Processing", "[TD_PSOLA]")
     }
 }
 
+TEST_CASE("TD_PSOLA - Steady-state render does not allocate or lock", "[TD_PSOLA][realtime]")
+{
+    TD_PSOLA::TDPSOLA psola;
+
+    float sampleRate = 44100.0f;
+    int numSamples = 44100;
+
+    juce::AudioBuffer<float> inputBuffer(2, numSamples);
+    BufferFiller::generateSineCycles(inputBuffer, 100); // 441 Hz
+    juce::AudioBuffer<float> outputBuffer;
+
+    for (float ratio : { 0.5f, 1.0f, 1.5f })
+    {
+        INFO("Ratio " << ratio);
+
+        // The first render sizes the FFT, window and pitch-mark storage.
+        REQUIRE(psola.process(inputBuffer, outputBuffer, ratio, sampleRate));
+
+        bool success = false;
+        int allocations = 0;
+        int locks = 0;
+        {
+            TestUtils::ScopedAudioThreadAudit audit;
+            success = psola.process(inputBuffer, outputBuffer, ratio, sampleRate);
+            allocations = audit.getNumAllocations();
+            locks = audit.getNumLocks();
+        }
+
+        REQUIRE(success);
+        REQUIRE(allocations == 0);
+        if (TestUtils::ScopedAudioThreadAudit::locksAreTracked())
+            REQUIRE(locks == 0);
+    }
+}
+
 TEST_CASE("TD_PSOLA - Invalid Inputs", "[TD_PSOLA]")
 {
     TD_PSOLA::TDPSOLA psola;
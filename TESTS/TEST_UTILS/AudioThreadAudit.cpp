@@ -0,0 +1,205 @@
+#include "AudioThreadAudit.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__) && defined(__GLIBC__)
+ #define AFT_AUDIT_LOCKS 1
+ #include <dlfcn.h>
+ #include <pthread.h>
+#else
+ #define AFT_AUDIT_LOCKS 0
+#endif
+
+// The default aligned forms on Windows pair _aligned_malloc with _aligned_free,
+// so they are only replaced where plain free() releases an aligned block.
+#if defined(_WIN32)
+ #define AFT_AUDIT_ALIGNED_NEW 0
+#else
+ #define AFT_AUDIT_ALIGNED_NEW 1
+#endif
+
+namespace
+{
+    // Plain thread_local PODs: touching them never allocates or locks.
+    struct AuditCounters
+    {
+        bool active;
+        int  allocations;
+        int  deallocations;
+        int  locks;
+    };
+
+    thread_local AuditCounters tCounters { false, 0, 0, 0 };
+
+    void* auditedAlloc(std::size_t size)
+    {
+        if (tCounters.active)
+            ++tCounters.allocations;
+
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+   #if AFT_AUDIT_ALIGNED_NEW
+    void* auditedAlignedAlloc(std::size_t size, std::align_val_t alignment)
+    {
+        if (tCounters.active)
+            ++tCounters.allocations;
+
+        void* ptr = nullptr;
+        const auto align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+        return posix_memalign(&ptr, align, size == 0 ? 1 : size) == 0 ? ptr : nullptr;
+    }
+   #endif
+
+    void auditedFree(void* ptr) noexcept
+    {
+        if (ptr == nullptr)
+            return;
+
+        if (tCounters.active)
+            ++tCounters.deallocations;
+
+        std::free(ptr);
+    }
+}
+
+//==============================================================================
+// Replacement global allocation functions.
+void* operator new(std::size_t size)
+{
+    if (void* ptr = auditedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (void* ptr = auditedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept   { return auditedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return auditedAlloc(size); }
+
+void operator delete(void* ptr) noexcept                               { auditedFree(ptr); }
+void operator delete[](void* ptr) noexcept                             { auditedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept                  { auditedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept                { auditedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept        { auditedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept      { auditedFree(ptr); }
+
+#if AFT_AUDIT_ALIGNED_NEW
+// Over-aligned types (alignas > 16, e.g. SIMD blocks) take these instead.
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (void* ptr = auditedAlignedAlloc(size, alignment))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    if (void* ptr = auditedAlignedAlloc(size, alignment))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return auditedAlignedAlloc(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return auditedAlignedAlloc(size, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept                           { auditedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept                         { auditedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept              { auditedFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept            { auditedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept    { auditedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept  { auditedFree(ptr); }
+#endif
+
+//==============================================================================
+#if AFT_AUDIT_LOCKS
+namespace
+{
+    // Counts the lock and returns the real function, resolved without a
+    // function-local static: its guard may itself lock.
+    template <typename Fn>
+    Fn auditLock(std::atomic<Fn>& cache, const char* name) noexcept
+    {
+        auto fn = cache.load(std::memory_order_acquire);
+        if (fn == nullptr)
+        {
+            fn = reinterpret_cast<Fn>(dlsym(RTLD_NEXT, name));
+            cache.store(fn, std::memory_order_release);
+        }
+
+        if (tCounters.active)
+            ++tCounters.locks;
+
+        return fn;
+    }
+
+    using MutexFn  = int(*)(pthread_mutex_t*);
+    using RwLockFn = int(*)(pthread_rwlock_t*);
+
+    std::atomic<MutexFn>  gRealMutexLock    { nullptr };
+    std::atomic<MutexFn>  gRealMutexTryLock { nullptr };
+    std::atomic<RwLockFn> gRealRdLock       { nullptr };
+    std::atomic<RwLockFn> gRealWrLock       { nullptr };
+}
+
+// std::mutex, juce::CriticalSection, condition variables and most stdio take
+// the first; std::shared_mutex and juce::ReadWriteLock-style code the last two.
+// A try-lock counts even when it fails: the caller was prepared to block.
+extern "C" int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+{
+    return auditLock(gRealMutexLock, "pthread_mutex_lock")(mutex);
+}
+
+extern "C" int pthread_mutex_trylock(pthread_mutex_t* mutex) noexcept
+{
+    return auditLock(gRealMutexTryLock, "pthread_mutex_trylock")(mutex);
+}
+
+extern "C" int pthread_rwlock_rdlock(pthread_rwlock_t* lock) noexcept
+{
+    return auditLock(gRealRdLock, "pthread_rwlock_rdlock")(lock);
+}
+
+extern "C" int pthread_rwlock_wrlock(pthread_rwlock_t* lock) noexcept
+{
+    return auditLock(gRealWrLock, "pthread_rwlock_wrlock")(lock);
+}
+#endif
+
+//==============================================================================
+namespace TestUtils {
+
+ScopedAudioThreadAudit::ScopedAudioThreadAudit()
+{
+    tCounters = { true, 0, 0, 0 };
+}
+
+ScopedAudioThreadAudit::~ScopedAudioThreadAudit()
+{
+    tCounters.active = false;
+}
+
+int ScopedAudioThreadAudit::getNumAllocations() const   { return tCounters.allocations; }
+int ScopedAudioThreadAudit::getNumDeallocations() const { return tCounters.deallocations; }
+int ScopedAudioThreadAudit::getNumLocks() const         { return tCounters.locks; }
+
+bool ScopedAudioThreadAudit::locksAreTracked()
+{
+    return AFT_AUDIT_LOCKS != 0;
+}
+
+} // namespace TestUtils
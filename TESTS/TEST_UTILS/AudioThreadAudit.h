@@ -0,0 +1,39 @@
+#pragma once
+
+/**
+ * Audio-thread audit for tests.
+ */
+
+namespace TestUtils {
+
+/**
+ * Counts heap allocations, frees and mutex locks made by the constructing
+ * thread while the audit is in scope. Other threads are not counted.
+ *
+ * Global operator new / delete are replaced for the whole test binary in
+ * AudioThreadAudit.cpp, including the nothrow and (outside Windows) aligned
+ * forms. Locks are counted by interposing pthread_mutex_lock / trylock and
+ * pthread_rwlock_rdlock / wrlock, which is only possible on Linux with glibc;
+ * check locksAreTracked() before asserting on getNumLocks().
+ *
+ * Wrap only the steady-state part of a hot path: prepare and warm up first,
+ * then assert zero allocations and locks for the blocks inside the scope.
+ */
+class ScopedAudioThreadAudit
+{
+public:
+    ScopedAudioThreadAudit();
+    ~ScopedAudioThreadAudit();
+
+    int getNumAllocations() const;
+    int getNumDeallocations() const;
+    int getNumLocks() const;
+
+    static bool locksAreTracked();
+
+private:
+    ScopedAudioThreadAudit(const ScopedAudioThreadAudit&) = delete;
+    ScopedAudioThreadAudit& operator=(const ScopedAudioThreadAudit&) = delete;
+};
+
+} // namespace TestUtils
@@ -0,0 +1,256 @@
+#include "SignalGenerator.h"
+#include <cmath>
+#include <limits>
+
+namespace TestUtils {
+
+namespace {
+
+// Rosenberg pulse shape as fractions of one period: opening, then closing, then closed.
+constexpr double kOpenPhase  = 0.4;
+constexpr double kClosePhase = 0.16;
+constexpr float  kPulseMean  = 0.3f;    // approx. DC of the pulse above, removed before the formants
+
+constexpr float  kFormant1Hz = 700.0f;
+constexpr float  kFormant2Hz = 1220.0f;
+
+constexpr double kFadeSeconds = 0.01;   // speech-mix phrase edges
+constexpr int    kWriteChunk  = 65536;
+
+} // namespace
+
+struct SignalGenerator::State
+{
+    explicit State(const SignalSpec& spec)
+        : random(spec.seed)
+    {
+        formant1.setCoefficients(juce::IIRCoefficients::makeBandPass(spec.sampleRate, kFormant1Hz, 4.0));
+        formant2.setCoefficients(juce::IIRCoefficients::makeBandPass(spec.sampleRate, kFormant2Hz, 6.0));
+
+        for (int ch = 0; ch < spec.numChannels; ++ch)
+        {
+            // Each channel a little quieter, so channel mix-ups show in tests
+            channelGain.push_back(spec.gain * std::pow(0.9f, static_cast<float>(ch)));
+
+            // Independent, still reproducible, noise per channel
+            noise.emplace_back(spec.seed * 7919 + ch + 1);
+        }
+
+        pink.resize(static_cast<size_t>(spec.numChannels));
+    }
+
+    struct Pink { float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f; };
+
+    juce::Random random;                    // speech-mix segmentation
+    std::vector<juce::Random> noise;
+    std::vector<Pink> pink;
+    std::vector<float> channelGain;
+
+    juce::IIRFilter formant1, formant2;
+    double glottalPhase = 0.0;
+    double vibratoPhase = 0.0;
+    double sweepPhase   = 0.0;
+
+    // kSpeechMix
+    bool voiced = false;
+    juce::int64 segmentLength = 0;
+    juce::int64 segmentPosition = 0;
+    float phraseF0 = 0.0f;
+};
+
+SignalGenerator::SignalGenerator(const SignalSpec& spec)
+    : mSpec(spec)
+{
+    jassert(spec.sampleRate > 0.0 && spec.numChannels > 0 && spec.seconds >= 0.0);
+    mLength = spec.getLengthInSamples();
+    reset();
+}
+
+SignalGenerator::~SignalGenerator() = default;
+
+void SignalGenerator::reset()
+{
+    mState = std::make_unique<State>(mSpec);
+    mPosition = 0;
+}
+
+int SignalGenerator::renderNextBlock(juce::AudioBuffer<float>& dest, int numSamples)
+{
+    jassert(dest.getNumChannels() >= mSpec.numChannels && dest.getNumSamples() >= numSamples);
+
+    const int toRender = static_cast<int>(juce::jmin<juce::int64>(numSamples, mLength - mPosition));
+    if (toRender <= 0)
+        return 0;
+
+    const bool isNoise = mSpec.type == SignalType::kWhiteNoise || mSpec.type == SignalType::kPinkNoise;
+    const int numChannels = mSpec.numChannels;
+    const auto& channelGain = mState->channelGain;
+
+    for (int i = 0; i < toRender; ++i)
+    {
+        if (isNoise)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float white = mState->noise[static_cast<size_t>(ch)].nextFloat() * 2.0f - 1.0f;
+
+                if (mSpec.type == SignalType::kPinkNoise)
+                {
+                    // Paul Kellet's economy pink filter, scaled back to roughly +-1
+                    auto& p = mState->pink[static_cast<size_t>(ch)];
+                    p.b0 = 0.99765f * p.b0 + white * 0.0990460f;
+                    p.b1 = 0.96300f * p.b1 + white * 0.2965164f;
+                    p.b2 = 0.57000f * p.b2 + white * 1.0526913f;
+                    white = juce::jlimit(-1.0f, 1.0f, 0.25f * (p.b0 + p.b1 + p.b2 + white * 0.1848f));
+                }
+
+                dest.setSample(ch, i, white * channelGain[static_cast<size_t>(ch)]);
+            }
+        }
+        else
+        {
+            const float sample = _nextSourceSample();
+            for (int ch = 0; ch < numChannels; ++ch)
+                dest.setSample(ch, i, sample * channelGain[static_cast<size_t>(ch)]);
+        }
+
+        ++mPosition;
+    }
+
+    return toRender;
+}
+
+float SignalGenerator::_nextSourceSample()
+{
+    switch (mSpec.type)
+    {
+        case SignalType::kGlottalPulses:
+            return _nextGlottal(mSpec.f0Hz);
+
+        case SignalType::kSineSweep:
+        {
+            const double nyquistLimit = 0.45 * mSpec.sampleRate;
+            const double startHz = juce::jlimit(1.0, nyquistLimit, static_cast<double>(mSpec.sweepStartHz));
+            const double endHz   = juce::jlimit(1.0, nyquistLimit, static_cast<double>(mSpec.sweepEndHz));
+            const double t = mLength > 1 ? static_cast<double>(mPosition) / static_cast<double>(mLength - 1) : 0.0;
+            const double hz = startHz * std::pow(endHz / startHz, t);
+
+            const float sample = static_cast<float>(std::sin(mState->sweepPhase));
+            mState->sweepPhase += juce::MathConstants<double>::twoPi * hz / mSpec.sampleRate;
+            if (mState->sweepPhase >= juce::MathConstants<double>::twoPi)
+                mState->sweepPhase -= juce::MathConstants<double>::twoPi;
+            return sample;
+        }
+
+        case SignalType::kSpeechMix:
+            return _nextSpeechMix();
+
+        case SignalType::kWhiteNoise:
+        case SignalType::kPinkNoise:
+            break;
+    }
+
+    return 0.0f;
+}
+
+float SignalGenerator::_nextGlottal(float f0)
+{
+    auto& s = *mState;
+
+    float pulse = 0.0f;
+    if (s.glottalPhase < kOpenPhase)
+        pulse = 0.5f * (1.0f - static_cast<float>(std::cos(juce::MathConstants<double>::pi * s.glottalPhase / kOpenPhase)));
+    else if (s.glottalPhase < kOpenPhase + kClosePhase)
+        pulse = static_cast<float>(std::cos(0.5 * juce::MathConstants<double>::pi * (s.glottalPhase - kOpenPhase) / kClosePhase));
+
+    const double vibrato = std::sin(juce::MathConstants<double>::twoPi * s.vibratoPhase);
+    const double hz = f0 * std::pow(2.0, mSpec.vibratoCents / 1200.0 * vibrato);
+
+    s.vibratoPhase += mSpec.vibratoHz / mSpec.sampleRate;
+    s.vibratoPhase -= std::floor(s.vibratoPhase);
+    s.glottalPhase += hz / mSpec.sampleRate;
+    s.glottalPhase -= std::floor(s.glottalPhase);
+
+    // Source plus two formants; peaks near 0.75 at typical f0, clamped for high f0.
+    const float source = pulse - kPulseMean;
+    const float tract = s.formant1.processSingleSampleRaw(source) + 0.6f * s.formant2.processSingleSampleRaw(source);
+    return juce::jlimit(-1.0f, 1.0f, 0.8f * (source + 3.0f * tract));
+}
+
+float SignalGenerator::_nextSpeechMix()
+{
+    auto& s = *mState;
+
+    if (s.segmentPosition >= s.segmentLength)
+    {
+        // Phrases of 0.2-1.2 s at 90-260 Hz, gaps of 0.05-0.6 s; starts voiced.
+        s.voiced = ! s.voiced;
+        const double seconds = s.voiced ? 0.2 + s.random.nextDouble() * 1.0
+                                        : 0.05 + s.random.nextDouble() * 0.55;
+        s.segmentLength = juce::jmax<juce::int64>(1, static_cast<juce::int64>(seconds * mSpec.sampleRate));
+        s.segmentPosition = 0;
+        s.phraseF0 = 90.0f + s.random.nextFloat() * 170.0f;
+    }
+
+    const juce::int64 pos = s.segmentPosition++;
+    if (! s.voiced)
+        return 0.0f;
+
+    const double fade = kFadeSeconds * mSpec.sampleRate;
+    const double envelope = juce::jmin(1.0, static_cast<double>(pos) / fade,
+                                       static_cast<double>(s.segmentLength - 1 - pos) / fade);
+
+    return _nextGlottal(s.phraseF0) * static_cast<float>(envelope);
+}
+
+juce::AudioBuffer<float> createSignalBuffer(const SignalSpec& spec)
+{
+    SignalGenerator generator(spec);
+    jassert(generator.getLengthInSamples() <= std::numeric_limits<int>::max());
+
+    juce::AudioBuffer<float> buffer(spec.numChannels, static_cast<int>(generator.getLengthInSamples()));
+    generator.renderNextBlock(buffer, buffer.getNumSamples());
+    return buffer;
+}
+
+bool writeSignalToWav(const SignalSpec& spec, const juce::File& wavFile, int bitDepth)
+{
+    wavFile.deleteFile();
+
+    std::unique_ptr<juce::FileOutputStream> stream(wavFile.createOutputStream());
+    if (stream == nullptr)
+        return false;
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer(wavFormat.createWriterFor(stream.get(),
+                                                                              spec.sampleRate,
+                                                                              static_cast<unsigned int>(spec.numChannels),
+                                                                              bitDepth,
+                                                                              {},
+                                                                              0));
+    if (writer == nullptr)
+        return false;
+
+    stream.release(); // writer owns the stream now
+
+    SignalGenerator generator(spec);
+    juce::AudioBuffer<float> chunk(spec.numChannels, kWriteChunk);
+
+    for (;;)
+    {
+        const int rendered = generator.renderNextBlock(chunk, kWriteChunk);
+        if (rendered == 0)
+            break;
+
+        if (! writer->writeFromAudioSampleBuffer(chunk, 0, rendered))
+        {
+            writer.reset();
+            wavFile.deleteFile();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace TestUtils
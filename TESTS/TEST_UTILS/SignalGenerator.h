@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../../SOURCE/Util/Juce_Header.h"
+#include <memory>
+
+/**
+ * Deterministic synthetic signals for tests and benchmarks.
+ */
+
+namespace TestUtils {
+
+enum class SignalType
+{
+    kGlottalPulses,     // Rosenberg pulse train through two formants, with vibrato
+    kSineSweep,         // Exponential sweep from sweepStartHz to sweepEndHz over the whole length
+    kWhiteNoise,
+    kPinkNoise,
+    kSpeechMix          // Voiced phrases at random pitch separated by silences
+};
+
+/** Everything that determines the output; the same spec always renders the same samples. */
+struct SignalSpec
+{
+    SignalType  type        = SignalType::kGlottalPulses;
+    double      sampleRate  = 44100.0;
+    int         numChannels = 1;
+    double      seconds     = 1.0;
+    juce::int64 seed        = 1;
+    float       gain        = 0.5f;
+
+    // kGlottalPulses (kSpeechMix picks its own f0 per phrase)
+    float f0Hz          = 220.0f;
+    float vibratoHz     = 5.5f;
+    float vibratoCents  = 50.0f;
+
+    // kSineSweep; the end is clamped below Nyquist
+    float sweepStartHz  = 20.0f;
+    float sweepEndHz    = 20000.0f;
+
+    juce::int64 getLengthInSamples() const { return static_cast<juce::int64>(seconds * sampleRate); }
+};
+
+/**
+ * Renders a SignalSpec block by block, so hours of audio can be produced
+ * without holding more than one block in memory. Output does not depend on
+ * the block sizes used.
+ *
+ * Multichannel output is the same source on every channel at a slightly
+ * lower level per channel, except noise, which is independent per channel.
+ */
+class SignalGenerator
+{
+public:
+    explicit SignalGenerator(const SignalSpec& spec);
+    ~SignalGenerator();
+
+    /**
+     * Writes the next numSamples (or fewer at the end) into dest from sample 0.
+     * dest must have at least spec.numChannels channels and numSamples samples.
+     * @return samples written; 0 once the whole length has been rendered.
+     */
+    int renderNextBlock(juce::AudioBuffer<float>& dest, int numSamples);
+
+    /** Back to the first sample; renders the same signal again. */
+    void reset();
+
+    juce::int64 getPosition() const { return mPosition; }
+    juce::int64 getLengthInSamples() const { return mLength; }
+    const SignalSpec& getSpec() const { return mSpec; }
+
+private:
+    struct State;
+
+    float _nextSourceSample();
+    float _nextGlottal(float f0);
+    float _nextSpeechMix();
+
+    SignalSpec mSpec;
+    juce::int64 mLength = 0;
+    juce::int64 mPosition = 0;
+    std::unique_ptr<State> mState;
+
+    SignalGenerator(const SignalGenerator&) = delete;
+    SignalGenerator& operator=(const SignalGenerator&) = delete;
+};
+
+/** Renders the whole spec into memory; for short signals only. */
+juce::AudioBuffer<float> createSignalBuffer(const SignalSpec& spec);
+
+/**
+ * Streams the spec to a WAV file in fixed-size chunks. Long multichannel
+ * files that pass 4 GB are written as RF64 by JUCE's WAV writer.
+ *
+ * @return false if the file could not be created or a write failed.
+ */
+bool writeSignalToWav(const SignalSpec& spec, const juce::File& wavFile, int bitDepth = 24);
+
+} // namespace TestUtils
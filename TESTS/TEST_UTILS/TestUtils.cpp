@@ -1,5 +1,32 @@
 #include "TestUtils.h"
+#include "Processor/BlockSizeAutoTuner.h"
+#include "Processor/FileToBufferManager.h"
+#include "Processor/PluginProcessor.h"
+#include "Util/FileUtils.h"
+#include "BufferFiller.h"
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <chrono>
 #include <cmath>
+#include <thread>
+
+namespace
+{
+    /** Points every BufferProcessingManager's autotuner cache at TESTS/TEST_UTILS/OUTPUT, never the user's app data. */
+    class AutoTunerCacheRedirect : public Catch::EventListenerBase
+    {
+    public:
+        using Catch::EventListenerBase::EventListenerBase;
+
+        void testRunStarting(Catch::TestRunInfo const&) override
+        {
+            BlockSizeAutoTuner::setDefaultCacheFile(juce::File(__FILE__).getSiblingFile("OUTPUT")
+                                                                        .getChildFile("BlockSizeCache.xml"));
+        }
+    };
+}
+
+CATCH_REGISTER_LISTENER(AutoTunerCacheRedirect)
 
 namespace TestUtils {
 
@@ -62,4 +89,55 @@ float calculateRMS(const juce::AudioBuffer<float>& buffer, int channel)
     return std::sqrt(sum / static_cast<float>(numSamples));
 }
 
+juce::File getModuleOutputDir(const juce::String& module)
+{
+    auto dir = juce::File::getCurrentWorkingDirectory().getChildFile("TESTS").getChildFile(module).getChildFile("OUTPUT");
+    dir.createDirectory();
+    return dir;
+}
+
+juce::File writeSineWav(const juce::File& file, int numChannels, double sampleRate, double seconds, double cyclesPerSecond)
+{
+    const int numSamples = static_cast<int>(sampleRate * seconds);
+    juce::AudioBuffer<float> source(numChannels, numSamples);
+    BufferFiller::generateSineCycles(source, static_cast<int>(seconds * cyclesPerSecond));
+
+    file.getParentDirectory().createDirectory();
+    REQUIRE(FileUtils::writeBufferToWav(source, file, sampleRate, numSamples));
+    return file;
+}
+
+juce::AudioBuffer<float> readWav(const juce::File& file)
+{
+    double      sampleRate  = 0.0;
+    int         numChannels = 0;
+    juce::int64 length      = 0;
+    REQUIRE(FileUtils::readAudioFileInfo(file, sampleRate, numChannels, length));
+
+    juce::AudioBuffer<float> buffer(numChannels, static_cast<int>(length));
+    int read = 0;
+    REQUIRE(FileUtils::loadWavIntoBuffer(file, buffer, buffer.getNumSamples(), sampleRate, numChannels, read));
+    REQUIRE(read == buffer.getNumSamples());
+    return buffer;
+}
+
+void setGain(AudioFileTransformerProcessor& processor, float gain)
+{
+    auto* parameter = processor.getGainNode()->getAPVTS().getParameter("gain");
+    REQUIRE(parameter != nullptr);
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(gain));
+}
+
+void waitForCompletion(FileToBufferManager& fbm, int timeoutMs)
+{
+    const auto start = std::chrono::steady_clock::now();
+    while (fbm.isProcessing())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        if (std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count() > timeoutMs)
+            break;
+    }
+}
+
 } // namespace TestUtils
@@ -6,6 +6,9 @@
 #include "../../SOURCE/Util/Juce_Header.h"
 #include "../../SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
 
+class AudioFileTransformerProcessor;
+class FileToBufferManager;
+
 /**
  * Test utilities for JUCE plugin testing.
  */
@@ -45,4 +48,39 @@ bool isSilent(const juce::AudioBuffer<float>& buffer, float threshold = 0.0001f)
  */
 float calculateRMS(const juce::AudioBuffer<float>& buffer, int channel = 0);
 
+/**
+ * Returns TESTS/<module>/OUTPUT under the working directory, creating it if needed.
+ *
+ * @param module Test module directory name, e.g. "STREAMING_RENDER_PIPELINE"
+ */
+juce::File getModuleOutputDir(const juce::String& module);
+
+/**
+ * Writes a BufferFiller sine (the same cycles on every channel) to a WAV file.
+ * REQUIREs that the write succeeded.
+ *
+ * @param cyclesPerSecond Sine cycles per second of audio
+ * @return file, for chaining into the code under test
+ */
+juce::File writeSineWav(const juce::File& file,
+                        int numChannels,
+                        double sampleRate,
+                        double seconds,
+                        double cyclesPerSecond = 100.0);
+
+/**
+ * Reads a whole audio file into a buffer sized to it. REQUIREs a complete read.
+ */
+juce::AudioBuffer<float> readWav(const juce::File& file);
+
+/**
+ * Sets the processor's gain node through its "gain" parameter, as a host would.
+ */
+void setGain(AudioFileTransformerProcessor& processor, float gain);
+
+/**
+ * Polls until the manager's background job has finished or timeoutMs passes.
+ */
+void waitForCompletion(FileToBufferManager& fbm, int timeoutMs = 300000);
+
 } // namespace TestUtils
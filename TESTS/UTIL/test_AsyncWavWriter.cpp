@@ -0,0 +1,137 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Util/AsyncWavWriter.h"
+#include "Util/FileUtils.h"
+#include "BufferFiller.h"
+
+namespace
+{
+    juce::File getOutputDir() { return TestUtils::getModuleOutputDir("UTIL"); }
+
+    juce::AudioBuffer<float> readBack(const juce::File& file, int expectedChannels, juce::int64 expectedLength)
+    {
+        auto reader = FileUtils::createReaderFor(file, FileUtils::ReadStrategy::kStreamed);
+        REQUIRE(reader != nullptr);
+        REQUIRE(static_cast<int>(reader->numChannels) == expectedChannels);
+        REQUIRE(reader->lengthInSamples == expectedLength);
+
+        juce::AudioBuffer<float> buffer(expectedChannels, static_cast<int>(expectedLength));
+        REQUIRE(reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true));
+        return buffer;
+    }
+}
+
+TEST_CASE("AsyncWavWriter writes what it is given", "[AsyncWavWriter][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    const double sampleRate = 44100.0;
+
+    SECTION("24-bit stereo round trip across odd-sized blocks and several staging buffers")
+    {
+        const int numSamples = 50000;
+        juce::AudioBuffer<float> source(2, numSamples);
+        BufferFiller::generateSineCycles(source, 300);
+        source.applyGain(0.8f);
+
+        AsyncWavWriter::Options options;
+        options.bufferFrames = 4096; // force many hand-offs
+
+        const auto file = getOutputDir().getChildFile("async_roundtrip.wav");
+        AsyncWavWriter writer;
+        REQUIRE(writer.open(file, sampleRate, 2, options));
+
+        for (int start = 0, step = 1; start < numSamples; start += step, step = step * 3 % 1021 + 7)
+            REQUIRE(writer.write(source, start, juce::jmin(step, numSamples - start)));
+
+        REQUIRE(writer.getFramesQueued() == numSamples);
+        REQUIRE(writer.close());
+        REQUIRE_FALSE(writer.isOpen());
+
+        const auto result = readBack(file, 2, numSamples);
+        const float lsb   = 1.0f / 8388607.0f;
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                REQUIRE(std::abs(result.getSample(ch, i) - source.getSample(ch, i)) <= lsb);
+    }
+
+    SECTION("Mono source fills every output channel; >2 channels use WAVE_FORMAT_EXTENSIBLE")
+    {
+        juce::AudioBuffer<float> mono(1, 1000);
+        BufferFiller::generateSineCycles(mono, 10);
+
+        const auto file = getOutputDir().getChildFile("async_quad.wav");
+        AsyncWavWriter writer;
+        REQUIRE(writer.open(file, sampleRate, 4));
+        REQUIRE(writer.write(mono, 0, 1000));
+        REQUIRE(writer.close());
+
+        const auto result = readBack(file, 4, 1000);
+        for (int ch = 1; ch < 4; ++ch)
+            for (int i = 0; i < 1000; ++i)
+                REQUIRE(result.getSample(ch, i) == result.getSample(0, i));
+    }
+
+    SECTION("TPDF dither linearises signals below one LSB")
+    {
+        // 0.3 LSB DC at 16-bit: plain rounding yields silence, dither preserves the mean.
+        const int   numSamples = 200000;
+        const float lsb        = 1.0f / 32767.0f;
+        juce::AudioBuffer<float> source(1, numSamples);
+        juce::FloatVectorOperations::fill(source.getWritePointer(0), 0.3f * lsb, numSamples);
+
+        auto render = [&] (bool dither, const juce::String& name)
+        {
+            AsyncWavWriter::Options options;
+            options.bitDepth = 16;
+            options.dither   = dither;
+
+            const auto file = getOutputDir().getChildFile(name);
+            AsyncWavWriter writer;
+            REQUIRE(writer.open(file, sampleRate, 1, options));
+            REQUIRE(writer.write(source, 0, numSamples));
+            REQUIRE(writer.close());
+            return readBack(file, 1, numSamples);
+        };
+
+        const auto plain    = render(false, "async_plain16.wav");
+        const auto dithered = render(true,  "async_dither16.wav");
+
+        REQUIRE(plain.getMagnitude(0, 0, numSamples) == 0.0f);
+
+        double sum = 0.0;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float v = dithered.getSample(0, i);
+            REQUIRE(std::abs(v) <= 2.0f * lsb);
+            sum += v;
+        }
+        REQUIRE(std::abs(sum / numSamples / lsb - 0.3) < 0.05);
+    }
+
+    SECTION("abort() removes the partial file")
+    {
+        juce::AudioBuffer<float> source(2, 10000);
+        source.clear();
+
+        const auto file = getOutputDir().getChildFile("async_aborted.wav");
+        AsyncWavWriter writer;
+        REQUIRE(writer.open(file, sampleRate, 2));
+        REQUIRE(writer.write(source, 0, 10000));
+        writer.abort();
+
+        REQUIRE_FALSE(writer.isOpen());
+        REQUIRE_FALSE(file.existsAsFile());
+        REQUIRE_FALSE(writer.close());
+    }
+
+    SECTION("Rejects unsupported formats")
+    {
+        AsyncWavWriter::Options options;
+        options.bitDepth = 20;
+
+        AsyncWavWriter writer;
+        REQUIRE_FALSE(writer.open(getOutputDir().getChildFile("async_bad.wav"), sampleRate, 2, options));
+        REQUIRE_FALSE(writer.write(juce::AudioBuffer<float>(2, 16), 0, 16));
+    }
+}
@@ -0,0 +1,306 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "TEST_UTILS/AudioThreadAudit.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Util/BinaryBlockLogger.h"
+#include "Processor/BufferProcessingManager.h"
+#include "PROCESSORS/GAIN/GainProcessor.h"
+#include <catch2/catch_approx.hpp>
+
+#include <cstring>
+
+namespace
+{
+    juce::File getOutputDir() { return TestUtils::getModuleOutputDir("UTIL"); }
+
+    juce::StringArray readCsvRows(const juce::File& csv)
+    {
+        auto rows = juce::StringArray::fromLines(csv.loadFileAsString().trimEnd());
+        REQUIRE(rows.size() > 0);
+        REQUIRE(rows[0] == "block,processor,channel,samples");
+        rows.remove(0);
+        return rows;
+    }
+
+    float rampValue(int block, int channel, int sample)
+    {
+        return static_cast<float>(block * 10000 + channel * 1000 + sample) * 1.0e-4f;
+    }
+}
+
+TEST_CASE("BinaryBlockLogger round-trips blocks through the binary file and CSV converter", "[BinaryBlockLogger][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    const auto logFile = getOutputDir().getChildFile("block_log.aftlog");
+    const auto csvDir  = getOutputDir().getChildFile("block_log_csv");
+    csvDir.deleteRecursively();
+
+    constexpr int kNumBlocks   = 3;
+    constexpr int kNumChannels = 2;
+    constexpr int kBlockSize   = 600;   // spans three records per channel
+
+    BinaryBlockLogger logger;
+    REQUIRE(logger.open(logFile));
+    REQUIRE(logger.isOpen());
+
+    juce::AudioBuffer<float> block(kNumChannels, kBlockSize);
+    for (int b = 0; b < kNumBlocks; ++b)
+    {
+        for (int ch = 0; ch < kNumChannels; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                block.setSample(ch, i, rampValue(b, ch, i));
+
+        logger.logBlock(BinaryBlockLogger::Stage::kInput, 1, block, true);
+        block.applyGain(2.0f);
+        logger.logBlock(BinaryBlockLogger::Stage::kOutput, 1, block, true);
+    }
+
+    REQUIRE(logger.close());
+    REQUIRE_FALSE(logger.isOpen());
+
+    const int recordsPerStage = kNumBlocks * kNumChannels * 3;
+    REQUIRE(logger.getNumWrittenRecords() == 2 * recordsPerStage);
+    REQUIRE(logger.getNumDroppedRecords() == 0);
+    REQUIRE(logFile.getSize() == static_cast<juce::int64>(sizeof(BinaryBlockLogger::FileHeader)
+                                                          + 2 * recordsPerStage * sizeof(BinaryBlockLogger::Record)));
+
+    juce::String error;
+    REQUIRE(BinaryBlockLogger::convertToCsv(logFile, csvDir, error));
+
+    for (const auto* name : { "input_samples.csv", "output_samples.csv" })
+    {
+        const bool isOutput = juce::String(name).startsWith("output");
+        const auto rows     = readCsvRows(csvDir.getChildFile(name));
+        REQUIRE(rows.size() == kNumBlocks * kNumChannels);
+
+        for (int b = 0; b < kNumBlocks; ++b)
+        {
+            for (int ch = 0; ch < kNumChannels; ++ch)
+            {
+                const auto fields = juce::StringArray::fromTokens(rows[b * kNumChannels + ch], ",", {});
+                REQUIRE(fields.size() == 3 + kBlockSize);
+                REQUIRE(fields[0].getIntValue() == b);
+                REQUIRE(fields[1].getIntValue() == 1);
+                REQUIRE(fields[2].getIntValue() == ch);
+
+                for (int i = 0; i < kBlockSize; i += 97)
+                    REQUIRE(fields[3 + i].getFloatValue()
+                            == Catch::Approx(rampValue(b, ch, i) * (isOutput ? 2.0f : 1.0f)).epsilon(1.0e-5));
+            }
+        }
+    }
+
+    SECTION("Rejects files that are not block logs")
+    {
+        const auto bogus = getOutputDir().getChildFile("not_a_block_log.aftlog");
+        bogus.replaceWithText("block,processor,channel\n");
+        REQUIRE_FALSE(BinaryBlockLogger::convertToCsv(bogus, csvDir, error));
+        REQUIRE(error.contains("Not a block log"));
+    }
+}
+
+TEST_CASE("BinaryBlockLogger drops and counts records on a full ring instead of blocking", "[BinaryBlockLogger][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    const auto logFile = getOutputDir().getChildFile("block_log_dropped.aftlog");
+
+    BinaryBlockLogger logger;
+    REQUIRE(logger.open(logFile, 4));
+
+    // 2 channels x 100 records in one burst against a 4-record ring.
+    juce::AudioBuffer<float> block(2, 100 * BinaryBlockLogger::kValuesPerRecord);
+    block.clear();
+    logger.logBlock(BinaryBlockLogger::Stage::kInput, 0, block, false);
+
+    REQUIRE(logger.close());
+    REQUIRE(logger.getNumDroppedRecords() > 0);
+    REQUIRE(logger.getNumWrittenRecords() + logger.getNumDroppedRecords() == 200);
+
+    juce::MemoryBlock header;
+    REQUIRE(logFile.loadFileAsData(header));
+    BinaryBlockLogger::FileHeader parsed {};
+    std::memcpy(&parsed, header.getData(), sizeof(parsed));
+    REQUIRE(parsed.numRecords == logger.getNumWrittenRecords());
+    REQUIRE(parsed.numDropped == logger.getNumDroppedRecords());
+}
+
+TEST_CASE("BinaryBlockLogger keeps every Nth block or a seeded random subset", "[BinaryBlockLogger][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    const auto logFile = getOutputDir().getChildFile("block_log_sampled.aftlog");
+    const auto csvDir  = getOutputDir().getChildFile("block_log_sampled_csv");
+    csvDir.deleteRecursively();
+
+    juce::AudioBuffer<float> block(1, 64);
+    block.clear();
+
+    SECTION("Every Nth block, with real block indices in the CSV")
+    {
+        BinaryBlockLogger logger;
+        logger.setSampling({ 4, 1.0, 0 });
+        REQUIRE(logger.open(logFile));
+
+        for (int b = 0; b < 20; ++b)
+        {
+            logger.logBlock(BinaryBlockLogger::Stage::kInput, 0, block, true);
+            logger.logBlock(BinaryBlockLogger::Stage::kOutput, 0, block, true);
+        }
+
+        REQUIRE(logger.close());
+        REQUIRE(logger.getNumSampledBlocks() == 5);
+        REQUIRE(logger.getNumWrittenRecords() == 2 * 5);
+
+        juce::MemoryBlock data;
+        REQUIRE(logFile.loadFileAsData(data));
+        BinaryBlockLogger::FileHeader header {};
+        std::memcpy(&header, data.getData(), sizeof(header));
+        REQUIRE(header.sampleEveryNth == 4);
+        REQUIRE(header.sampleProbability == 1.0f);
+
+        juce::String error;
+        REQUIRE(BinaryBlockLogger::convertToCsv(logFile, csvDir, error));
+
+        for (const auto* name : { "input_samples.csv", "output_samples.csv" })
+        {
+            const auto rows = readCsvRows(csvDir.getChildFile(name));
+            REQUIRE(rows.size() == 5);
+            for (int i = 0; i < rows.size(); ++i)
+                REQUIRE(rows[i].upToFirstOccurrenceOf(",", false, false).getIntValue() == 4 * i);
+        }
+    }
+
+    SECTION("A random subset is reproducible from its seed")
+    {
+        constexpr int kNumBlocks = 2000;
+
+        BinaryBlockLogger a, b, c;
+        a.setSampling({ 1, 0.25, 42 });
+        b.setSampling({ 1, 0.25, 42 });
+        c.setSampling({ 1, 0.25, 43 });
+
+        int kept = 0, differences = 0;
+        for (juce::uint32 i = 0; i < kNumBlocks; ++i)
+        {
+            REQUIRE(a.isBlockSampled(i) == b.isBlockSampled(i));
+            kept        += a.isBlockSampled(i) ? 1 : 0;
+            differences += a.isBlockSampled(i) != c.isBlockSampled(i) ? 1 : 0;
+        }
+
+        REQUIRE(kept > kNumBlocks / 4 - 100);
+        REQUIRE(kept < kNumBlocks / 4 + 100);
+        REQUIRE(differences > 0);
+
+        // Logging keeps exactly the blocks the policy picks.
+        REQUIRE(a.open(logFile));
+        for (int i = 0; i < kNumBlocks; ++i)
+        {
+            a.logBlock(BinaryBlockLogger::Stage::kInput, 0, block, true);
+            a.logBlock(BinaryBlockLogger::Stage::kOutput, 0, block, true);
+        }
+        REQUIRE(a.close());
+        REQUIRE(a.getNumSampledBlocks() == kept);
+        REQUIRE(a.getNumWrittenRecords() == 2 * kept);
+    }
+
+    SECTION("Sampling can be combined and clamps out-of-range settings")
+    {
+        BinaryBlockLogger logger;
+        logger.setSampling({ 0, 2.0, 7 });
+        REQUIRE(logger.getSampling().everyNth == 1);
+        REQUIRE(logger.getSampling().probability == 1.0);
+        REQUIRE(logger.getSampling().logsEveryBlock());
+
+        logger.setSampling({ 10, 0.0, 7 });
+        for (juce::uint32 i = 0; i < 100; ++i)
+            REQUIRE_FALSE(logger.isBlockSampled(i));
+
+        logger.setSampling({ 10, 0.5, 7 });
+        for (juce::uint32 i = 0; i < 1000; ++i)
+            if (logger.isBlockSampled(i))
+                REQUIRE(i % 10 == 0);
+    }
+}
+
+TEST_CASE("BufferProcessingManager logs every block without touching the filesystem on the audio thread",
+          "[BinaryBlockLogger][BufferProcessingManager][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+#if ! AFT_BLOCK_LOGGING
+    WARN("Built with AFT_BLOCK_LOGGING=0; BufferProcessingManager logging hooks are compiled out");
+    return;
+#endif
+
+    const auto logFile = getOutputDir().getChildFile("bpm_block_log.aftlog");
+    const auto csvDir  = getOutputDir().getChildFile("bpm_block_log_csv");
+    csvDir.deleteRecursively();
+
+    constexpr int kNumChannels = 2;
+    constexpr int kNumSamples  = 8 * 512;
+
+    BufferProcessingManager bpManager;
+    bpManager.setActiveProcessor(ActiveProcessor::kGain);
+    auto* gain = dynamic_cast<GainProcessor*>(bpManager.getSwapper().getProcessorByIndex(ActiveProcessor::kGain));
+    REQUIRE(gain != nullptr);
+    gain->setGain(0.5f);
+
+    juce::AudioBuffer<float> input(kNumChannels, kNumSamples);
+    juce::AudioBuffer<float> output(kNumChannels, kNumSamples);
+    for (int ch = 0; ch < kNumChannels; ++ch)
+        for (int i = 0; i < kNumSamples; ++i)
+            input.setSample(ch, i, static_cast<float>(i % 100) * 0.01f);
+
+    auto& logger = bpManager.getBlockLogger();
+    REQUIRE(logger.open(logFile, 8));   // tiny ring: the offline render has to wait for the drain
+
+    REQUIRE(bpManager.processBuffers(input, output, kNumSamples, kNumSamples, 44100.0, 512));
+
+    // Realtime blocks: no allocation or lock while logging, whatever the ring does.
+    bpManager.prepareRealtime(44100.0, 512);
+    juce::AudioBuffer<float> hostBlock(kNumChannels, 512);
+    juce::MidiBuffer         midi;
+    hostBlock.clear();
+
+    int allocations = 0;
+    int locks       = 0;
+    {
+        TestUtils::ScopedAudioThreadAudit audit;
+        for (int i = 0; i < 4; ++i)
+            bpManager.processRealtimeBlock(hostBlock, midi);
+
+        // Read before asserting: Catch may allocate while reporting.
+        allocations = audit.getNumAllocations();
+        locks       = audit.getNumLocks();
+    }
+
+    REQUIRE(allocations == 0);
+    if (TestUtils::ScopedAudioThreadAudit::locksAreTracked())
+        REQUIRE(locks == 0);
+    bpManager.releaseRealtime();
+
+    REQUIRE(logger.close());
+
+    juce::String error;
+    REQUIRE(BinaryBlockLogger::convertToCsv(logFile, csvDir, error));
+
+    // The offline render logged every block losslessly; realtime blocks may have dropped.
+    const auto inputRows  = readCsvRows(csvDir.getChildFile("input_samples.csv"));
+    const auto outputRows = readCsvRows(csvDir.getChildFile("output_samples.csv"));
+    REQUIRE(inputRows.size()  >= 8 * kNumChannels);
+    REQUIRE(outputRows.size() >= 8 * kNumChannels);
+
+    for (int row = 0; row < 8 * kNumChannels; ++row)
+    {
+        const auto in  = juce::StringArray::fromTokens(inputRows[row],  ",", {});
+        const auto out = juce::StringArray::fromTokens(outputRows[row], ",", {});
+        REQUIRE(in.size()  == 3 + 512);
+        REQUIRE(out.size() == 3 + 512);
+        REQUIRE(in[0].getIntValue() == row / kNumChannels);
+        REQUIRE(in[1].getIntValue() == static_cast<int>(ActiveProcessor::kGain));
+
+        for (int i = 3; i < in.size(); i += 61)
+            REQUIRE(out[i].getFloatValue() == Catch::Approx(0.5f * in[i].getFloatValue()).margin(1.0e-6));
+    }
+}
@@ -1,5 +1,6 @@
 #include "TEST_UTILS/TestUtils.h"
 #include "Util/FileUtils.h"
+#include "BufferFiller.h"
 
 TEST_CASE("FileUtils::isSupportedAudioFile", "[FileUtils]")
 {
@@ -152,3 +153,97 @@ TEST_CASE("FileUtils::validateOutputPath", "[FileUtils]")
         CHECK(errorMsg.isNotEmpty() == true);
     }
 }
+
+TEST_CASE("FileUtils memory-mapped load matches the streamed reader", "[FileUtils][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    auto outDir = juce::File::getCurrentWorkingDirectory().getChildFile("TESTS/UTIL/OUTPUT");
+    outDir.createDirectory();
+
+    const double sampleRate = 48000.0;
+
+    auto writeSource = [&] (int numChannels, int bitDepth, int numSamples)
+    {
+        juce::AudioBuffer<float> source(numChannels, numSamples);
+        BufferFiller::generateSineCycles(source, 440);
+        source.applyGain(0.9f);
+
+        auto file = outDir.getChildFile("mapped_" + juce::String(numChannels) + "ch_" + juce::String(bitDepth) + ".wav");
+        REQUIRE(FileUtils::writeBufferToWav(source, file, sampleRate, numSamples, bitDepth));
+        return file;
+    };
+
+    auto load = [&] (const juce::File& file, int numSamples, FileUtils::ReadStrategy strategy)
+    {
+        juce::AudioBuffer<float> dest(2, numSamples);
+        dest.clear();
+        double sr   = 0.0;
+        int    chs  = 0;
+        int    read = 0;
+        REQUIRE(FileUtils::loadWavIntoBuffer(file, dest, numSamples, sr, chs, read, nullptr, nullptr, strategy));
+        REQUIRE(read == numSamples);
+        REQUIRE(sr == sampleRate);
+        return dest;
+    };
+
+    SECTION("Samples are bit-identical for 16/24-bit mono and stereo")
+    {
+        const int numSamples = 10000;
+        for (int bitDepth : { 16, 24 })
+        {
+            for (int numChannels : { 1, 2 })
+            {
+                const auto file     = writeSource(numChannels, bitDepth, numSamples);
+                const auto streamed = load(file, numSamples, FileUtils::ReadStrategy::kStreamed);
+                const auto mapped   = load(file, numSamples, FileUtils::ReadStrategy::kMemoryMapped);
+
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < numSamples; ++i)
+                        REQUIRE(mapped.getSample(ch, i) == streamed.getSample(ch, i));
+            }
+        }
+    }
+
+    SECTION("Shared format manager and mapped reader open WAV")
+    {
+        const auto file = writeSource(2, 24, 4096);
+        REQUIRE(FileUtils::getFormatManager().getNumKnownFormats() > 0);
+        REQUIRE(&FileUtils::getFormatManager() == &FileUtils::getFormatManager());
+
+        auto reader = FileUtils::createReaderFor(file, FileUtils::ReadStrategy::kMemoryMapped);
+        REQUIRE(reader != nullptr);
+        REQUIRE(dynamic_cast<juce::MemoryMappedAudioFormatReader*>(reader.get()) != nullptr);
+        REQUIRE(reader->lengthInSamples == 4096);
+    }
+
+    SECTION("Load throughput, streamed vs memory-mapped")
+    {
+        const int  numSamples = static_cast<int>(sampleRate * 30.0);
+        const auto file       = writeSource(2, 24, numSamples);
+        const double megabytes = static_cast<double>(file.getSize()) / (1024.0 * 1024.0);
+
+        auto bestMBps = [&] (FileUtils::ReadStrategy strategy)
+        {
+            double best = 0.0;
+            for (int run = 0; run < 3; ++run)
+            {
+                const double start = juce::Time::getMillisecondCounterHiRes();
+                load(file, numSamples, strategy);
+                const double seconds = (juce::Time::getMillisecondCounterHiRes() - start) / 1000.0;
+                best = juce::jmax(best, megabytes / juce::jmax(seconds, 1.0e-6));
+            }
+            return best;
+        };
+
+        const double streamed = bestMBps(FileUtils::ReadStrategy::kStreamed);
+        const double mapped   = bestMBps(FileUtils::ReadStrategy::kMemoryMapped);
+
+        WARN("WAV load throughput (" << juce::String(megabytes, 1) << " MB, 24-bit stereo): streamed "
+             << juce::String(streamed, 1) << " MB/s, memory-mapped " << juce::String(mapped, 1)
+             << " MB/s (x" << juce::String(mapped / streamed, 2) << ")");
+
+        REQUIRE(streamed > 0.0);
+        REQUIRE(mapped   > 0.0);
+    }
+}
@@ -0,0 +1,40 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "Util/JobPool.h"
+
+#include <atomic>
+#include <vector>
+
+TEST_CASE("JobPool runs every job exactly once", "[JobPool]")
+{
+    constexpr int kNumJobs    = 1000;
+    constexpr int kNumWorkers = 4;
+
+    std::vector<std::atomic<int>> runs(kNumJobs);
+    std::atomic<int>              exits { 0 };
+    std::atomic<int>              badWorker { 0 };
+
+    JobPool pool("JobPool Test");
+    pool.start(kNumWorkers, kNumJobs,
+               [&](int workerIndex, int jobIndex)
+               {
+                   if (! juce::isPositiveAndBelow(workerIndex, kNumWorkers))
+                       badWorker.fetch_add(1);
+                   runs[static_cast<size_t>(jobIndex)].fetch_add(1);
+               },
+               [&](int) { exits.fetch_add(1); });
+    pool.join();
+
+    REQUIRE(pool.getNumWorkers() == kNumWorkers);
+    REQUIRE(exits.load() == kNumWorkers);
+    REQUIRE(badWorker.load() == 0);
+    for (int i = 0; i < kNumJobs; ++i)
+        REQUIRE(runs[static_cast<size_t>(i)].load() == 1);
+
+    SECTION("A second run reuses the pool")
+    {
+        std::atomic<int> count { 0 };
+        pool.start(2, 10, [&](int, int) { count.fetch_add(1); });
+        pool.join();
+        REQUIRE(count.load() == 10);
+    }
+}
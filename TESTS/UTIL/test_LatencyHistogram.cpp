@@ -0,0 +1,76 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Util/LatencyHistogram.h"
+
+TEST_CASE("LatencyHistogram buckets stay within their precision bound", "[LatencyHistogram]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    // Small values are exact.
+    for (juce::int64 ns = 0; ns < 2 * LatencyHistogram::kSubBucketCount; ++ns)
+        REQUIRE(LatencyHistogram::getBucketUpperBound(LatencyHistogram::getBucketIndex(ns)) == ns);
+
+    // Larger ones land in a bucket whose upper edge is at most 1/32 above them,
+    // and bucket indices never go backwards.
+    int lastIndex = 0;
+    for (juce::int64 ns = 64; ns < (juce::int64(1) << 36); ns = ns * 17 / 16 + 1)
+    {
+        const int  index = LatencyHistogram::getBucketIndex(ns);
+        const auto upper = LatencyHistogram::getBucketUpperBound(index);
+
+        REQUIRE(index >= lastIndex);
+        REQUIRE(index < LatencyHistogram::kNumBuckets);
+        REQUIRE(upper >= ns);
+        REQUIRE(static_cast<double>(upper - ns) <= static_cast<double>(ns) / LatencyHistogram::kSubBucketCount);
+        lastIndex = index;
+    }
+
+    // Out-of-range values clamp to the last bucket.
+    REQUIRE(LatencyHistogram::getBucketIndex(std::numeric_limits<juce::int64>::max()) == LatencyHistogram::kNumBuckets - 1);
+    REQUIRE(LatencyHistogram::getBucketIndex(-5) == 0);
+}
+
+TEST_CASE("LatencyHistogram reports percentiles and the worst block", "[LatencyHistogram]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    LatencyHistogram histogram;
+    REQUIRE_FALSE(histogram.getSummary().isValid());
+    REQUIRE(histogram.getValueAtPercentile(50.0) == 0);
+
+    // 2000 blocks at ~10 us, a 100 us spike at block 1500, a tail of 30 us blocks.
+    constexpr int kNumBlocks = 2000;
+    for (int block = 0; block < kNumBlocks; ++block)
+    {
+        juce::int64 ns = 10000 + block % 7;
+        if (block % 100 == 99)
+            ns = 30000;
+        if (block == 1500)
+            ns = 100000;
+
+        histogram.record(ns);
+    }
+
+    const auto summary = histogram.getSummary();
+    REQUIRE(summary.count == kNumBlocks);
+    REQUIRE(summary.worstBlock == 1500);
+    REQUIRE(summary.maxUs == 100.0);
+
+    const double tolerance = 1.0 / LatencyHistogram::kSubBucketCount;
+    REQUIRE(summary.p50Us >= 10.0);
+    REQUIRE(summary.p50Us <= 10.006 * (1.0 + tolerance));
+    REQUIRE(summary.p99Us >= 30.0);
+    REQUIRE(summary.p99Us <= 30.0 * (1.0 + tolerance));
+    REQUIRE(summary.p999Us >= summary.p99Us);
+    REQUIRE(summary.p999Us <= summary.maxUs);
+    REQUIRE(summary.getSpikeRatio() > 9.0);
+    REQUIRE(summary.toString().contains("block 1500"));
+
+    histogram.reset();
+    REQUIRE(histogram.getCount() == 0);
+    REQUIRE(histogram.getWorstBlockIndex() == -1);
+
+    histogram.record(5);
+    REQUIRE(histogram.getWorstBlockIndex() == 0);
+    REQUIRE(histogram.getValueAtPercentile(99.9) == 5);
+}
@@ -0,0 +1,113 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Util/RenderControl.h"
+#include "Util/FileUtils.h"
+#include "Processor/BufferProcessingManager.h"
+#include "BufferFiller.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("RenderControl checkpoint honours pause, resume and cancel", "[RenderControl]")
+{
+    RenderControl control;
+
+    SECTION("Fresh token lets work proceed")
+    {
+        REQUIRE(control.checkpoint());
+        REQUIRE_FALSE(control.isCancelled());
+        REQUIRE_FALSE(control.isPaused());
+    }
+
+    SECTION("Cancel stops work and reset re-arms the token")
+    {
+        control.cancel();
+        REQUIRE_FALSE(control.checkpoint());
+
+        control.reset();
+        REQUIRE(control.checkpoint());
+    }
+
+    SECTION("Paused checkpoint blocks until resumed from another thread")
+    {
+        control.pause();
+        std::atomic<bool> passed { false };
+
+        std::thread worker([&]
+        {
+            passed.store(control.checkpoint());
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        REQUIRE_FALSE(passed.load());
+
+        control.resume();
+        worker.join();
+        REQUIRE(passed.load());
+    }
+
+    SECTION("Cancel wakes a paused checkpoint")
+    {
+        control.pause();
+        std::atomic<bool> finished { false };
+        bool result = true;
+
+        std::thread worker([&]
+        {
+            result = control.checkpoint();
+            finished.store(true);
+        });
+
+        control.cancel();
+        worker.join();
+        REQUIRE(finished.load());
+        REQUIRE_FALSE(result);
+    }
+}
+
+TEST_CASE("Cancelled RenderControl stops load, process and write loops", "[RenderControl][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+    RenderControl cancelled;
+    cancelled.cancel();
+
+    const double sampleRate = 44100.0;
+    const int    numSamples = 8192;
+    juce::AudioBuffer<float> buffer(2, numSamples);
+    BufferFiller::generateSineCycles(buffer, 100);
+
+    auto outDir = juce::File::getCurrentWorkingDirectory().getChildFile("TESTS/UTIL/OUTPUT");
+    outDir.createDirectory();
+
+    SECTION("writeBufferToWav leaves no partial file behind")
+    {
+        auto outFile = outDir.getChildFile("cancelled_write.wav");
+        REQUIRE_FALSE(FileUtils::writeBufferToWav(buffer, outFile, sampleRate, numSamples, 24, nullptr, &cancelled));
+        REQUIRE_FALSE(outFile.existsAsFile());
+    }
+
+    SECTION("loadWavIntoBuffer returns false")
+    {
+        auto inFile = outDir.getChildFile("cancel_source.wav");
+        REQUIRE(FileUtils::writeBufferToWav(buffer, inFile, sampleRate, numSamples));
+
+        juce::AudioBuffer<float> dest(2, numSamples);
+        double sr = 0.0;
+        int    chs = 0;
+        int    read = 0;
+        REQUIRE_FALSE(FileUtils::loadWavIntoBuffer(inFile, dest, numSamples, sr, chs, read, nullptr, &cancelled));
+        REQUIRE(read == 0);
+    }
+
+    SECTION("processBuffers reports Cancelled")
+    {
+        BufferProcessingManager bpm;
+        bpm.setActiveProcessor(ActiveProcessor::kGain);
+
+        juce::AudioBuffer<float> output(2, numSamples);
+        REQUIRE_FALSE(bpm.processBuffers(buffer, output, numSamples, numSamples, sampleRate, 512, nullptr, &cancelled));
+        REQUIRE(bpm.getLastError() == "Cancelled");
+    }
+}
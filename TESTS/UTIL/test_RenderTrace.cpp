@@ -0,0 +1,225 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "TEST_UTILS/SignalGenerator.h"
+#include "SUBMODULES/RD/TESTS/TEST_UTILS/TestUtils.h"
+#include "Util/RenderTrace.h"
+#include "Processor/PluginProcessor.h"
+#include "Processor/FileToBufferManager.h"
+
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    juce::File getOutputDir() { return TestUtils::getModuleOutputDir("UTIL"); }
+
+    struct ParsedTrace
+    {
+        int                    numComplete = 0;
+        std::set<int>          namedThreads;
+        std::set<juce::String> eventNames;
+        bool                   timesValid  = true;
+    };
+
+    ParsedTrace parseTrace(const juce::File& file)
+    {
+        ParsedTrace parsed;
+
+        const auto json = juce::JSON::parse(file);
+        REQUIRE(json.isObject());
+
+        const auto* events = json["traceEvents"].getArray();
+        REQUIRE(events != nullptr);
+
+        for (const auto& event : *events)
+        {
+            const auto phase = event["ph"].toString();
+            const int  tid   = static_cast<int>(event["tid"]);
+
+            if (phase == "M")
+            {
+                REQUIRE(event["name"].toString() == "thread_name");
+                parsed.namedThreads.insert(tid);
+            }
+            else if (phase == "X")
+            {
+                ++parsed.numComplete;
+                parsed.eventNames.insert(event["name"].toString());
+                parsed.timesValid = parsed.timesValid
+                                    && static_cast<double>(event["ts"]) >= 0.0
+                                    && static_cast<double>(event["dur"]) >= 0.0
+                                    && parsed.namedThreads.count(tid) == 1;
+            }
+        }
+
+        return parsed;
+    }
+}
+
+TEST_CASE("RenderTrace writes per-thread scopes as Chrome trace JSON", "[RenderTrace]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+#if ! AFT_TRACE
+    WARN("Built with AFT_TRACE=0; trace scopes are compiled out");
+    return;
+#endif
+
+    const auto file = getOutputDir().getChildFile("trace_threads.json");
+    constexpr int kScopesPerThread = 10;
+    constexpr int kNumThreads      = 3;
+
+    REQUIRE_FALSE(RenderTrace::stop(file));
+    REQUIRE(RenderTrace::start());
+    REQUIRE(RenderTrace::isActive());
+    REQUIRE_FALSE(RenderTrace::start());
+
+    {
+        AFT_TRACE_SCOPE("outer", "test");
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kNumThreads; ++t)
+            threads.emplace_back([]
+            {
+                AFT_TRACE_THREAD();
+
+                for (int i = 0; i < kScopesPerThread; ++i)
+                {
+                    AFT_TRACE_SCOPE("inner", "test");
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+            });
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    REQUIRE(RenderTrace::stop(file));
+    REQUIRE_FALSE(RenderTrace::isActive());
+
+    const int expected = kNumThreads * kScopesPerThread + 1;
+    REQUIRE(RenderTrace::getNumWrittenEvents() == expected);
+    REQUIRE(RenderTrace::getNumDroppedEvents() == 0);
+
+    const auto parsed = parseTrace(file);
+    REQUIRE(parsed.numComplete == expected);
+    REQUIRE(parsed.namedThreads.size() == static_cast<size_t>(kNumThreads + 1));
+    REQUIRE(parsed.eventNames == std::set<juce::String> { "outer", "inner" });
+    REQUIRE(parsed.timesValid);
+
+    SECTION("Threads that never registered drop their scopes")
+    {
+        REQUIRE(RenderTrace::start());
+
+        std::thread unregistered([]
+        {
+            for (int i = 0; i < kScopesPerThread; ++i)
+            {
+                AFT_TRACE_SCOPE("unregistered", "test");
+            }
+        });
+        unregistered.join();
+
+        REQUIRE(RenderTrace::stop(file));
+        REQUIRE(RenderTrace::getNumWrittenEvents() == 0);
+        REQUIRE(RenderTrace::getNumDroppedEvents() == kScopesPerThread);
+        REQUIRE(parseTrace(file).numComplete == 0);
+    }
+
+    SECTION("Scopes outside a session are not recorded")
+    {
+        {
+            AFT_TRACE_SCOPE("idle", "test");
+        }
+
+        REQUIRE(RenderTrace::start());
+        REQUIRE(RenderTrace::stop(file));
+        REQUIRE(RenderTrace::getNumWrittenEvents() == 0);
+        REQUIRE(parseTrace(file).numComplete == 0);
+    }
+}
+
+TEST_CASE("RenderTrace drops and counts events past a full thread buffer", "[RenderTrace]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+#if ! AFT_TRACE
+    WARN("Built with AFT_TRACE=0; trace scopes are compiled out");
+    return;
+#endif
+
+    const auto file = getOutputDir().getChildFile("trace_dropped.json");
+    constexpr int kOverflow = 5;
+
+    REQUIRE(RenderTrace::start());
+
+    std::thread worker([]
+    {
+        for (int i = 0; i < RenderTrace::kEventsPerThread + kOverflow; ++i)
+        {
+            AFT_TRACE_SCOPE("fill", "test");
+        }
+    });
+    worker.join();
+
+    REQUIRE(RenderTrace::stop(file));
+    REQUIRE(RenderTrace::getNumWrittenEvents() == RenderTrace::kEventsPerThread);
+    REQUIRE(RenderTrace::getNumDroppedEvents() == kOverflow);
+
+    const auto json = juce::JSON::parse(file);
+    REQUIRE(static_cast<int>(json["otherData"]["droppedEvents"]) == kOverflow);
+}
+
+TEST_CASE("FileToBufferManager writes trace.json beside the output WAV", "[RenderTrace][FileToBufferManager][file]")
+{
+    TestUtils::SetupAndTeardown setup;
+
+#if ! AFT_TRACE
+    WARN("Built with AFT_TRACE=0; trace scopes are compiled out");
+    return;
+#endif
+
+    TestUtils::SignalSpec spec;
+    spec.type        = TestUtils::SignalType::kSpeechMix;
+    spec.numChannels = 2;
+    spec.seconds     = 2.0;
+
+    const auto inputFile = getOutputDir().getChildFile("trace_input.wav");
+    REQUIRE(TestUtils::writeSignalToWav(spec, inputFile));
+
+    auto runDir = getOutputDir().getChildFile("trace_run");
+    runDir.deleteRecursively();
+
+    AudioFileTransformerProcessor processor;
+    processor.setIsLogging(false);
+    processor.setActiveProcessor(ActiveProcessor::kGain);
+
+    auto& fbm = processor.getFileToBufferManager();
+    fbm.setInputFile(inputFile);
+    fbm.setOutputDirectory(runDir);
+    fbm.setTraceEnabled(true);
+
+    REQUIRE(fbm.startProcessing(processor.getOfflineRenderer()));
+    while (fbm.isProcessing())
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    INFO("FBM error: " << fbm.getError().toStdString());
+    REQUIRE(fbm.wasSuccessful());
+
+    const auto traceFile = fbm.getTraceFile();
+    REQUIRE(traceFile.existsAsFile());
+    REQUIRE(traceFile.getParentDirectory() == fbm.getLastOutputFile().getParentDirectory());
+
+    const auto parsed = parseTrace(traceFile);
+    REQUIRE(parsed.timesValid);
+    for (const char* name : { "render", "loadWav", "readChunk", "processBuffers", "processBlock", "writeChunk", "writerDrain" })
+    {
+        INFO("Missing trace event: " << name);
+        REQUIRE(parsed.eventNames.count(name) == 1);
+    }
+
+    // Render thread plus the async writer thread at least.
+    REQUIRE(parsed.namedThreads.size() >= 2);
+    REQUIRE_FALSE(RenderTrace::isActive());
+}
@@ -0,0 +1,56 @@
+#include "TEST_UTILS/TestUtils.h"
+#include "Util/SpscQueue.h"
+
+#include <thread>
+
+TEST_CASE("SpscQueue is bounded and FIFO", "[SpscQueue]")
+{
+    SpscQueue<int> queue(4);
+    REQUIRE(queue.getCapacity() == 4);
+    REQUIRE(queue.isEmpty());
+
+    for (int i = 0; i < 4; ++i)
+        REQUIRE(queue.push(i));
+
+    REQUIRE_FALSE(queue.push(99));
+    REQUIRE(queue.getNumReady() == 4);
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i)
+    {
+        REQUIRE(queue.pop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(queue.pop(value));
+}
+
+TEST_CASE("SpscQueue preserves order across threads", "[SpscQueue]")
+{
+    constexpr int kCount = 100000;
+    SpscQueue<int> queue(8);
+
+    std::thread producer([&]
+    {
+        for (int i = 0; i < kCount; ++i)
+            while (! queue.push(i))
+                std::this_thread::yield();
+    });
+
+    int  expected = 0;
+    bool inOrder  = true;
+    while (expected < kCount)
+    {
+        int value = -1;
+        if (! queue.pop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        inOrder = inOrder && value == expected;
+        ++expected;
+    }
+
+    producer.join();
+    REQUIRE(inOrder);
+    REQUIRE(queue.isEmpty());
+}